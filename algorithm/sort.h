@@ -0,0 +1,705 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tiny {
+
+    // 排序用的临时内存，只增不减，反复排序时不再每次分配
+    // 不传 buffer 的重载使用线程局部的默认实例
+    class sort_buffer
+    {
+    public:
+        sort_buffer() = default;
+        sort_buffer(const sort_buffer&) = delete;
+        sort_buffer& operator=(const sort_buffer&) = delete;
+
+        ~sort_buffer()
+        {
+            release();
+        }
+
+        // 至少 bytes 字节、按 64 字节对齐的内存；内容不保留
+        void* get(size_t bytes)
+        {
+            if (bytes > _bytes)
+            {
+                release();
+                _data = ::operator new(bytes, std::align_val_t(64));
+                _bytes = bytes;
+            }
+            return _data;
+        }
+
+        template<typename T>
+        T* get(size_t n)
+        {
+            static_assert(alignof(T) <= 64);
+            return static_cast<T*>(get(n * sizeof(T)));
+        }
+
+        size_t capacity() const { return _bytes; }
+
+        void release()
+        {
+            if (_data) ::operator delete(_data, std::align_val_t(64));
+            _data = nullptr;
+            _bytes = 0;
+        }
+
+    private:
+        void* _data = nullptr;
+        size_t _bytes = 0;
+    };
+
+    namespace detail {
+
+        inline sort_buffer& default_sort_buffer()
+        {
+            thread_local sort_buffer buffer;
+            return buffer;
+        }
+
+        // ================= pdqsort =================
+        // Pattern-defeating quicksort（Orson Peters）：
+        //   小区间插入排序；大区间用九数取中选枢轴；
+        //   划分后发现本来就有序时尝试有限次数的插入排序直接收尾；
+        //   划分严重失衡时打乱若干元素，次数超过 log n 就改用堆排序，保证 O(n log n)；
+        //   算术类型配 std::less/greater 时用分块的无分支划分（BlockQuicksort），避免分支预测失败
+
+        constexpr ptrdiff_t kInsertionSortThreshold = 24;
+        constexpr ptrdiff_t kNintherThreshold = 128;
+        constexpr size_t kPartialInsertionSortLimit = 8;
+        constexpr size_t kBlockSize = 64;
+        constexpr size_t kCachelineSize = 64;
+
+        template<typename T, typename Compare>
+        constexpr bool use_branchless_partition_v = std::is_arithmetic_v<T>
+            && (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>
+                || std::is_same_v<Compare, std::greater<T>> || std::is_same_v<Compare, std::greater<>>);
+
+        template<typename Iter, typename Compare>
+        void insertion_sort(Iter begin, Iter end, Compare& comp)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            if (begin == end) return;
+
+            for (Iter cur = begin + 1; cur != end; ++cur)
+            {
+                Iter sift = cur;
+                Iter sift_1 = cur - 1;
+                if (comp(*sift, *sift_1))
+                {
+                    T tmp = std::move(*sift);
+                    do { *sift-- = std::move(*sift_1); }
+                    while (sift != begin && comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                }
+            }
+        }
+
+        // 要求 begin 左边的元素不大于区间内任何元素，可以省掉边界检查
+        template<typename Iter, typename Compare>
+        void unguarded_insertion_sort(Iter begin, Iter end, Compare& comp)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            if (begin == end) return;
+
+            for (Iter cur = begin + 1; cur != end; ++cur)
+            {
+                Iter sift = cur;
+                Iter sift_1 = cur - 1;
+                if (comp(*sift, *sift_1))
+                {
+                    T tmp = std::move(*sift);
+                    do { *sift-- = std::move(*sift_1); }
+                    while (comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                }
+            }
+        }
+
+        // 移动次数超过上限就放弃并返回 false
+        template<typename Iter, typename Compare>
+        bool partial_insertion_sort(Iter begin, Iter end, Compare& comp)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            if (begin == end) return true;
+
+            size_t limit = 0;
+            for (Iter cur = begin + 1; cur != end; ++cur)
+            {
+                Iter sift = cur;
+                Iter sift_1 = cur - 1;
+                if (comp(*sift, *sift_1))
+                {
+                    T tmp = std::move(*sift);
+                    do { *sift-- = std::move(*sift_1); }
+                    while (sift != begin && comp(tmp, *--sift_1));
+                    *sift = std::move(tmp);
+                    limit += static_cast<size_t>(cur - sift);
+                }
+                if (limit > kPartialInsertionSortLimit) return false;
+            }
+            return true;
+        }
+
+        template<typename Iter, typename Compare>
+        void sort2(Iter a, Iter b, Compare& comp)
+        {
+            if (comp(*b, *a)) std::iter_swap(a, b);
+        }
+
+        template<typename Iter, typename Compare>
+        void sort3(Iter a, Iter b, Iter c, Compare& comp)
+        {
+            sort2(a, b, comp);
+            sort2(b, c, comp);
+            sort2(a, b, comp);
+        }
+
+        template<typename Iter>
+        void swap_offsets(Iter first, Iter last, unsigned char* offsets_l, unsigned char* offsets_r,
+                          size_t num, bool use_swaps)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+            if (use_swaps)
+            {
+                // 两边个数相等时必须逐对交换，否则下面的循环置换会出错
+                for (size_t i = 0; i < num; ++i) std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+            }
+            else if (num > 0)
+            {
+                Iter l = first + offsets_l[0];
+                Iter r = last - offsets_r[0];
+                T tmp(std::move(*l));
+                *l = std::move(*r);
+                for (size_t i = 1; i < num; ++i)
+                {
+                    l = first + offsets_l[i];
+                    *r = std::move(*l);
+                    r = last - offsets_r[i];
+                    *l = std::move(*r);
+                }
+                *r = std::move(tmp);
+            }
+        }
+
+        // 以 *begin 为枢轴划分，返回枢轴的最终位置以及区间是否本来就已划分好
+        // 左右各扫描一块，先把"放错边"的下标记进偏移数组（无分支），再成批交换
+        template<typename Iter, typename Compare>
+        std::pair<Iter, bool> partition_right_branchless(Iter begin, Iter end, Compare& comp)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+
+            T pivot(std::move(*begin));
+            Iter first = begin;
+            Iter last = end;
+
+            // 找到第一个不小于枢轴的元素；左侧有哨兵时不用检查边界
+            while (comp(*++first, pivot));
+
+            if (first - 1 == begin) while (first < last && !comp(*--last, pivot));
+            else while (!comp(*--last, pivot));
+
+            const bool already_partitioned = first >= last;
+            if (!already_partitioned)
+            {
+                std::iter_swap(first, last);
+                ++first;
+
+                alignas(kCachelineSize) unsigned char offsets_l_storage[kBlockSize];
+                alignas(kCachelineSize) unsigned char offsets_r_storage[kBlockSize];
+                unsigned char* offsets_l = offsets_l_storage;
+                unsigned char* offsets_r = offsets_r_storage;
+
+                Iter offsets_l_base = first;
+                Iter offsets_r_base = last;
+                size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+                while (first < last)
+                {
+                    // 剩余元素不够两整块时按比例分给左右
+                    const size_t num_unknown = static_cast<size_t>(last - first);
+                    const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                    const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+                    if (left_split >= kBlockSize)
+                    {
+                        for (size_t i = 0; i < kBlockSize;)
+                        {
+                            offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                            offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                            offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                            offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < left_split;)
+                        {
+                            offsets_l[num_l] = static_cast<unsigned char>(i++); num_l += !comp(*first, pivot); ++first;
+                        }
+                    }
+
+                    if (right_split >= kBlockSize)
+                    {
+                        for (size_t i = 0; i < kBlockSize;)
+                        {
+                            offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                            offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                            offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                            offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < right_split;)
+                        {
+                            offsets_r[num_r] = static_cast<unsigned char>(++i); num_r += comp(*--last, pivot);
+                        }
+                    }
+
+                    const size_t num = std::min(num_l, num_r);
+                    swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r,
+                                 num, num_l == num_r);
+                    num_l -= num;
+                    num_r -= num;
+                    start_l += num;
+                    start_r += num;
+
+                    if (num_l == 0)
+                    {
+                        start_l = 0;
+                        offsets_l_base = first;
+                    }
+                    if (num_r == 0)
+                    {
+                        start_r = 0;
+                        offsets_r_base = last;
+                    }
+                }
+
+                // 一边还有没配对的元素，逐个换到另一端
+                if (num_l)
+                {
+                    offsets_l += start_l;
+                    while (num_l--) std::iter_swap(offsets_l_base + offsets_l[num_l], --last);
+                    first = last;
+                }
+                if (num_r)
+                {
+                    offsets_r += start_r;
+                    while (num_r--) std::iter_swap(offsets_r_base - offsets_r[num_r], first), ++first;
+                    last = first;
+                }
+            }
+
+            Iter pivot_pos = first - 1;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        template<typename Iter, typename Compare>
+        std::pair<Iter, bool> partition_right(Iter begin, Iter end, Compare& comp)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+
+            T pivot(std::move(*begin));
+            Iter first = begin;
+            Iter last = end;
+
+            while (comp(*++first, pivot));
+
+            if (first - 1 == begin) while (first < last && !comp(*--last, pivot));
+            else while (!comp(*--last, pivot));
+
+            const bool already_partitioned = first >= last;
+
+            while (first < last)
+            {
+                std::iter_swap(first, last);
+                while (comp(*++first, pivot));
+                while (!comp(*--last, pivot));
+            }
+
+            Iter pivot_pos = first - 1;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        // 与枢轴相等的元素放到左边；用于大量重复元素的区间，相等的一段之后不再处理
+        template<typename Iter, typename Compare>
+        Iter partition_left(Iter begin, Iter end, Compare& comp)
+        {
+            using T = typename std::iterator_traits<Iter>::value_type;
+
+            T pivot(std::move(*begin));
+            Iter first = begin;
+            Iter last = end;
+
+            while (comp(pivot, *--last));
+
+            if (last + 1 == end) while (first < last && !comp(pivot, *++first));
+            else while (!comp(pivot, *++first));
+
+            while (first < last)
+            {
+                std::iter_swap(first, last);
+                while (comp(pivot, *--last));
+                while (!comp(pivot, *++first));
+            }
+
+            Iter pivot_pos = last;
+            *begin = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return pivot_pos;
+        }
+
+        template<bool Branchless, typename Iter, typename Compare>
+        void pdqsort_loop(Iter begin, Iter end, Compare& comp, int bad_allowed, bool leftmost = true)
+        {
+            using diff_t = typename std::iterator_traits<Iter>::difference_type;
+
+            for (;;)
+            {
+                const diff_t size = end - begin;
+
+                if (size < kInsertionSortThreshold)
+                {
+                    if (leftmost) insertion_sort(begin, end, comp);
+                    else unguarded_insertion_sort(begin, end, comp);
+                    return;
+                }
+
+                // 选枢轴：大区间九数取中，否则三数取中
+                const diff_t s2 = size / 2;
+                if (size > kNintherThreshold)
+                {
+                    sort3(begin, begin + s2, end - 1, comp);
+                    sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+                    sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+                    sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+                    std::iter_swap(begin, begin + s2);
+                }
+                else
+                {
+                    sort3(begin + s2, begin, end - 1, comp);
+                }
+
+                // 枢轴与左边的哨兵相等：这一段全是重复元素，把等于枢轴的都放左边跳过
+                if (!leftmost && !comp(*(begin - 1), *begin))
+                {
+                    begin = partition_left(begin, end, comp) + 1;
+                    continue;
+                }
+
+                std::pair<Iter, bool> part = Branchless
+                    ? partition_right_branchless(begin, end, comp)
+                    : partition_right(begin, end, comp);
+                Iter pivot_pos = part.first;
+                const bool already_partitioned = part.second;
+
+                const diff_t l_size = pivot_pos - begin;
+                const diff_t r_size = end - (pivot_pos + 1);
+                const bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+                if (highly_unbalanced)
+                {
+                    // 失衡次数太多，改用堆排序兜底
+                    if (--bad_allowed == 0)
+                    {
+                        std::make_heap(begin, end, comp);
+                        std::sort_heap(begin, end, comp);
+                        return;
+                    }
+
+                    // 打乱几个元素，破坏导致失衡的输入模式
+                    if (l_size >= kInsertionSortThreshold)
+                    {
+                        std::iter_swap(begin, begin + l_size / 4);
+                        std::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                        if (l_size > kNintherThreshold)
+                        {
+                            std::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                            std::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                            std::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                            std::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                        }
+                    }
+                    if (r_size >= kInsertionSortThreshold)
+                    {
+                        std::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                        std::iter_swap(end - 1, end - r_size / 4);
+                        if (r_size > kNintherThreshold)
+                        {
+                            std::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                            std::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                            std::iter_swap(end - 2, end - (1 + r_size / 4));
+                            std::iter_swap(end - 3, end - (2 + r_size / 4));
+                        }
+                    }
+                }
+                else
+                {
+                    // 划分时一次交换都没有：很可能本来就有序，试着用插入排序直接收尾
+                    if (already_partitioned
+                        && partial_insertion_sort(begin, pivot_pos, comp)
+                        && partial_insertion_sort(pivot_pos + 1, end, comp))
+                    {
+                        return;
+                    }
+                }
+
+                // 递归处理左边，右边继续循环
+                pdqsort_loop<Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+
+        // ================= 归并排序 =================
+
+        constexpr size_t kStableRun = 32;
+
+        // 把 src 中相邻的两段 [i, i + width)、[i + width, i + 2 * width) 归并到 dst
+        template<typename In, typename Out, typename Compare>
+        void merge_pass(In src, Out dst, size_t n, size_t width, Compare& comp)
+        {
+            for (size_t i = 0; i < n; i += 2 * width)
+            {
+                const size_t mid = std::min(i + width, n);
+                const size_t hi = std::min(i + 2 * width, n);
+                size_t a = i, b = mid, k = i;
+                while (a < mid && b < hi)
+                {
+                    // 相等时取左边的，保证稳定
+                    if (comp(src[b], src[a])) dst[k++] = std::move(src[b++]);
+                    else dst[k++] = std::move(src[a++]);
+                }
+                while (a < mid) dst[k++] = std::move(src[a++]);
+                while (b < hi) dst[k++] = std::move(src[b++]);
+            }
+        }
+
+        // ================= 基数排序 =================
+
+        // 把 key 映射成无符号整数，且保持大小顺序
+        template<typename K>
+        auto radix_key(K key)
+        {
+            if constexpr (std::is_same_v<K, float>)
+            {
+                uint32_t u = std::bit_cast<uint32_t>(key);
+                return u ^ ((u >> 31) ? 0xFFFFFFFFu : 0x80000000u);   // 负数全部取反，正数翻转符号位
+            }
+            else if constexpr (std::is_same_v<K, double>)
+            {
+                uint64_t u = std::bit_cast<uint64_t>(key);
+                return u ^ ((u >> 63) ? ~uint64_t(0) : (uint64_t(1) << 63));
+            }
+            else
+            {
+                static_assert(std::is_integral_v<K> && !std::is_same_v<K, bool>,
+                              "radix_sort key must be an integer or floating-point type");
+                using U = std::make_unsigned_t<K>;
+                if constexpr (std::is_signed_v<K>)
+                    return static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(U) * 8 - 1)));
+                else
+                    return static_cast<U>(key);
+            }
+        }
+
+        constexpr size_t kRadixBits = 8;
+        constexpr size_t kRadixBuckets = size_t(1) << kRadixBits;
+        constexpr size_t kRadixSmall = 64;
+
+        // LSD 基数排序，每趟 8 位；先一次遍历统计出所有趟的直方图，
+        // 某一趟所有元素落在同一个桶里就直接跳过（比如 64 位 key 的高位全为 0）
+        // data 与 buf 都至少有 n 个元素，T 必须可平凡拷贝
+        template<typename T, typename KeyOf>
+        void radix_sort_impl(T* data, T* buf, size_t n, KeyOf key_of)
+        {
+            using U = decltype(key_of(data[0]));
+            constexpr size_t passes = sizeof(U);
+
+            size_t counts[passes][kRadixBuckets] = {};
+            for (size_t i = 0; i < n; ++i)
+            {
+                const U k = key_of(data[i]);
+                for (size_t p = 0; p < passes; ++p) ++counts[p][(k >> (p * kRadixBits)) & (kRadixBuckets - 1)];
+            }
+
+            T* src = data;
+            T* dst = buf;
+            const U first_key = key_of(data[0]);
+            for (size_t p = 0; p < passes; ++p)
+            {
+                const size_t shift = p * kRadixBits;
+                if (counts[p][(first_key >> shift) & (kRadixBuckets - 1)] == n) continue;
+
+                size_t offsets[kRadixBuckets];
+                size_t sum = 0;
+                for (size_t b = 0; b < kRadixBuckets; ++b)
+                {
+                    offsets[b] = sum;
+                    sum += counts[p][b];
+                }
+                for (size_t i = 0; i < n; ++i)
+                {
+                    dst[offsets[(key_of(src[i]) >> shift) & (kRadixBuckets - 1)]++] = src[i];
+                }
+                std::swap(src, dst);
+            }
+
+            if (src != data) std::memcpy(data, src, n * sizeof(T));
+        }
+
+        // 按 key 稳定插入排序，用于很短的区间
+        template<typename Iter, typename KeyOf>
+        void insertion_sort_by_key(Iter begin, Iter end, KeyOf& key_of)
+        {
+            auto comp = [&](const auto& a, const auto& b) { return key_of(a) < key_of(b); };
+            insertion_sort(begin, end, comp);
+        }
+    }
+
+    // 不稳定排序，pdqsort：平均 O(n log n)，最坏 O(n log n)，不分配内存
+    template<typename Iter, typename Compare>
+    void sort(Iter first, Iter last, Compare comp)
+    {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        if (first == last) return;
+        const int bad_allowed = std::bit_width(static_cast<size_t>(last - first));
+        detail::pdqsort_loop<detail::use_branchless_partition_v<T, Compare>>(first, last, comp, bad_allowed);
+    }
+
+    template<typename Iter>
+    void sort(Iter first, Iter last)
+    {
+        tiny::sort(first, last, std::less<typename std::iterator_traits<Iter>::value_type>());
+    }
+
+    // 稳定排序：短区间插入排序，然后自底向上归并，在 buffer 与原区间之间来回搬
+    // 需要 n 个元素的临时空间，取自 buffer
+    template<typename Iter, typename Compare>
+    void stable_sort(Iter first, Iter last, Compare comp, sort_buffer& buffer)
+    {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        const size_t n = static_cast<size_t>(last - first);
+
+        for (size_t i = 0; i < n; i += detail::kStableRun)
+        {
+            detail::insertion_sort(first + i, first + std::min(i + detail::kStableRun, n), comp);
+        }
+        if (n <= detail::kStableRun) return;
+
+        // 可平凡拷贝的元素直接往临时区里写；
+        // 否则先把元素整体移动构造到临时区，之后两边之间只做移动赋值
+        T* buf = buffer.get<T>(n);
+        bool in_buffer = false;   // 当前有序数据在哪边
+        if constexpr (!std::is_trivially_copyable_v<T>)
+        {
+            std::uninitialized_move(first, last, buf);
+            in_buffer = true;
+        }
+
+        for (size_t width = detail::kStableRun; width < n; width *= 2)
+        {
+            if (in_buffer) detail::merge_pass(buf, first, n, width, comp);
+            else detail::merge_pass(first, buf, n, width, comp);
+            in_buffer = !in_buffer;
+        }
+        if (in_buffer) std::move(buf, buf + n, first);
+        if constexpr (!std::is_trivially_copyable_v<T>) std::destroy(buf, buf + n);
+    }
+
+    template<typename Iter, typename Compare>
+    void stable_sort(Iter first, Iter last, Compare comp)
+    {
+        tiny::stable_sort(first, last, comp, detail::default_sort_buffer());
+    }
+
+    template<typename Iter>
+    void stable_sort(Iter first, Iter last)
+    {
+        tiny::stable_sort(first, last, std::less<typename std::iterator_traits<Iter>::value_type>());
+    }
+
+    // 按 key_of(元素) 升序稳定排序，key 为整数或浮点数，O(n * sizeof(key))
+    // 只支持连续存储的区间（tiny::vector、数组等）；需要 n 个元素的临时空间，取自 buffer
+    // 元素不可平凡拷贝时先对 (key, 下标) 排序，再按下标搬动元素
+    template<typename Iter, typename KeyFn>
+        requires std::contiguous_iterator<Iter>
+    void radix_sort(Iter first, Iter last, KeyFn key_fn, sort_buffer& buffer)
+    {
+        using T = std::iter_value_t<Iter>;
+        T* data = std::to_address(first);
+        const size_t n = static_cast<size_t>(last - first);
+        auto key_of = [&](const T& value) { return detail::radix_key(key_fn(value)); };
+
+        if (n < detail::kRadixSmall)
+        {
+            detail::insertion_sort_by_key(data, data + n, key_of);
+            return;
+        }
+
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            detail::radix_sort_impl(data, buffer.get<T>(n), n, key_of);
+        }
+        else
+        {
+            using U = decltype(key_of(*data));
+            struct entry { U key; size_t index; };
+
+            // 一块临时内存依次放：两份 entry 数组、n 个元素
+            const size_t entry_bytes = (n * sizeof(entry) + 63) & ~size_t(63);
+            char* raw = static_cast<char*>(buffer.get(2 * entry_bytes + n * sizeof(T)));
+            entry* entries = reinterpret_cast<entry*>(raw);
+            entry* tmp = reinterpret_cast<entry*>(raw + entry_bytes);
+            T* moved = reinterpret_cast<T*>(raw + 2 * entry_bytes);
+
+            for (size_t i = 0; i < n; ++i) entries[i] = {key_of(data[i]), i};
+            detail::radix_sort_impl(entries, tmp, n, [](const entry& e) { return e.key; });
+
+            for (size_t i = 0; i < n; ++i) new (moved + i) T(std::move(data[entries[i].index]));
+            std::move(moved, moved + n, data);
+            std::destroy(moved, moved + n);
+        }
+    }
+
+    template<typename Iter, typename KeyFn>
+        requires std::contiguous_iterator<Iter>
+    void radix_sort(Iter first, Iter last, KeyFn key_fn)
+    {
+        tiny::radix_sort(first, last, key_fn, detail::default_sort_buffer());
+    }
+
+    // 直接对整数/浮点数区间排序
+    template<typename Iter>
+        requires std::contiguous_iterator<Iter>
+    void radix_sort(Iter first, Iter last, sort_buffer& buffer)
+    {
+        using T = std::iter_value_t<Iter>;
+        tiny::radix_sort(first, last, [](T value) { return value; }, buffer);
+    }
+
+    template<typename Iter>
+        requires std::contiguous_iterator<Iter>
+    void radix_sort(Iter first, Iter last)
+    {
+        tiny::radix_sort(first, last, detail::default_sort_buffer());
+    }
+}
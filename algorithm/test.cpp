@@ -0,0 +1,144 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <limits>
+#include <cassert>
+#include "sort.h"
+#include "../vector/vector.h"
+
+// 各种典型输入：随机、有序、逆序、锯齿、大量重复、几乎有序
+std::vector<std::vector<int>> make_inputs(size_t n) {
+    std::mt19937 rng(17);
+    std::vector<std::vector<int>> inputs;
+    std::vector<int> v(n);
+
+    for (auto& x : v) x = int(rng());
+    inputs.push_back(v);
+    std::sort(v.begin(), v.end());
+    inputs.push_back(v);
+    std::reverse(v.begin(), v.end());
+    inputs.push_back(v);
+    for (size_t i = 0; i < n; ++i) v[i] = int(i % 17);
+    inputs.push_back(v);
+    for (auto& x : v) x = int(rng() % 4);
+    inputs.push_back(v);
+    for (size_t i = 0; i < n; ++i) v[i] = int(i);
+    for (int k = 0; k < 10 && n > 1; ++k) std::swap(v[rng() % n], v[rng() % n]);
+    inputs.push_back(v);
+    // 管风琴形
+    for (size_t i = 0; i < n; ++i) v[i] = int(i < n / 2 ? i : n - i);
+    inputs.push_back(v);
+    return inputs;
+}
+
+// 1. pdqsort：与 std::sort 对比，包括无分支划分与普通划分两条路径
+void test_sort() {
+    size_t sizes[] = {0, 1, 2, 5, 23, 24, 100, 129, 1000, 100000};
+    for (size_t n : sizes) {
+        for (const auto& input : make_inputs(n)) {
+            std::vector<int> expected = input;
+            std::sort(expected.begin(), expected.end());
+
+            tiny::vector<int> a(input.begin(), input.end());
+            tiny::sort(a.begin(), a.end());
+            assert(std::equal(a.begin(), a.end(), expected.begin(), expected.end()));
+
+            // 自定义比较器走普通划分
+            std::vector<int> b = input;
+            tiny::sort(b.begin(), b.end(), [](int x, int y) { return x > y; });
+            assert(std::equal(b.rbegin(), b.rend(), expected.begin()));
+        }
+    }
+
+    tiny::vector<std::string> words;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 5000; ++i) words.push_back(std::to_string(rng() % 1000));
+    tiny::sort(words.begin(), words.end());
+    assert(std::is_sorted(words.begin(), words.end()));
+}
+
+// 2. 稳定排序：相等元素保持原来的先后次序
+void test_stable_sort() {
+    struct item { int key; int order; };
+    std::mt19937 rng(9);
+    size_t sizes[] = {0, 1, 31, 32, 33, 1000, 50000};
+    tiny::sort_buffer buffer;
+    for (size_t n : sizes) {
+        tiny::vector<item> v;
+        for (size_t i = 0; i < n; ++i) v.push_back({int(rng() % 100), int(i)});
+        tiny::stable_sort(v.begin(), v.end(), [](const item& a, const item& b) { return a.key < b.key; }, buffer);
+        for (size_t i = 1; i < n; ++i) {
+            assert(v[i - 1].key <= v[i].key);
+            if (v[i - 1].key == v[i].key) assert(v[i - 1].order < v[i].order);
+        }
+    }
+    // buffer 复用：再次排序同样大小的数据不会重新分配
+    size_t cap = buffer.capacity();
+    tiny::vector<item> again(50000, item{1, 0});
+    tiny::stable_sort(again.begin(), again.end(), [](const item& a, const item& b) { return a.key < b.key; }, buffer);
+    assert(buffer.capacity() == cap);
+
+    // 不可平凡拷贝的元素
+    std::vector<std::string> s;
+    for (int i = 0; i < 3000; ++i) s.push_back(std::string(20, char('a' + rng() % 26)) + std::to_string(i));
+    std::vector<std::string> expected = s;
+    std::stable_sort(expected.begin(), expected.end());
+    tiny::stable_sort(s.begin(), s.end());
+    assert(s == expected);
+}
+
+// 3. 基数排序：有符号整数、无符号 64 位、浮点数、按成员排序
+void test_radix_sort() {
+    std::mt19937_64 rng(21);
+
+    tiny::vector<int> ints;
+    for (int i = 0; i < 100000; ++i) ints.push_back(int(rng()));
+    ints.push_back(std::numeric_limits<int>::min());
+    ints.push_back(std::numeric_limits<int>::max());
+    tiny::radix_sort(ints.begin(), ints.end());
+    assert(std::is_sorted(ints.begin(), ints.end()));
+
+    std::vector<uint64_t> u(200000);
+    for (auto& x : u) x = rng() >> (rng() % 64);
+    std::vector<uint64_t> expected = u;
+    std::sort(expected.begin(), expected.end());
+    tiny::radix_sort(u.begin(), u.end());
+    assert(u == expected);
+
+    std::vector<double> d;
+    for (int i = 0; i < 10000; ++i) d.push_back(double(int64_t(rng() % 2000000) - 1000000) / 7.0);
+    d.push_back(-0.5);
+    d.push_back(0.0);
+    tiny::radix_sort(d.begin(), d.end());
+    assert(std::is_sorted(d.begin(), d.end()));
+
+    std::vector<float> small = {3.5f, -1.0f, 2.0f, -7.25f};
+    tiny::radix_sort(small.begin(), small.end());
+    assert(small[0] == -7.25f && small[3] == 3.5f);
+
+    // 按 key 函数排序，稳定
+    struct row { uint32_t id; uint16_t bucket; };
+    tiny::vector<row> rows;
+    for (uint32_t i = 0; i < 50000; ++i) rows.push_back({i, uint16_t(rng() % 300)});
+    tiny::radix_sort(rows.begin(), rows.end(), [](const row& r) { return r.bucket; });
+    for (size_t i = 1; i < rows.size(); ++i) {
+        assert(rows[i - 1].bucket <= rows[i].bucket);
+        if (rows[i - 1].bucket == rows[i].bucket) assert(rows[i - 1].id < rows[i].id);
+    }
+
+    // 元素不可平凡拷贝
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) names.push_back(std::string(int(rng() % 30), 'x'));
+    tiny::radix_sort(names.begin(), names.end(), [](const std::string& s) { return s.size(); });
+    for (size_t i = 1; i < names.size(); ++i) assert(names[i - 1].size() <= names[i].size());
+}
+
+int main() {
+    test_sort();
+    test_stable_sort();
+    test_radix_sort();
+    std::cout << "all sort tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,273 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 不依赖任何第三方库的微基准框架
+//   每个用例是一个“批次”函数，一次执行 ops 个操作（比如往新容器里 push_back ops 次）
+//   先预热，再自动放大批次重复次数使每个样本至少跑 min_time，取若干样本的中位数
+//   每行报告 ns/op、每个操作的堆分配次数与字节数，以及可用时的硬件计数器
+//
+// 分配计数依赖替换全局 operator new/delete，见 bench/main.cpp；
+// 硬件计数器通过 perf_event_open 读取，容器/权限不允许时显示为 "-"
+
+namespace tiny::bench {
+
+    // 阻止编译器把被测结果优化掉
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    inline void clobber_memory()
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    // 全局 operator new 每次分配时累加
+    struct allocation_counters
+    {
+        std::atomic<uint64_t> count{ 0 };
+        std::atomic<uint64_t> bytes{ 0 };
+    };
+
+    inline allocation_counters& allocations()
+    {
+        static allocation_counters counters;
+        return counters;
+    }
+
+    // 一组硬件计数器：周期、指令、最后一级缓存未命中、分支预测失败
+    class perf_counters
+    {
+    public:
+        static constexpr int kCount = 4;
+        static constexpr const char* kNames[kCount] = { "cycles", "instr", "llc-miss", "br-miss" };
+
+        perf_counters()
+        {
+#if defined(__linux__)
+            const uint64_t configs[kCount] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+            };
+            for (int i = 0; i < kCount; ++i)
+            {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = configs[i];
+                attr.disabled = i == 0;   // 由组长统一开关
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+                int fd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : _fds[0], 0));
+                if (fd < 0)
+                {
+                    close_();
+                    return;
+                }
+                _fds[i] = fd;
+            }
+            _available = true;
+#endif
+        }
+
+        perf_counters(const perf_counters&) = delete;
+        perf_counters& operator=(const perf_counters&) = delete;
+
+        ~perf_counters()
+        {
+            close_();
+        }
+
+        bool available() const { return _available; }
+
+        void start()
+        {
+#if defined(__linux__)
+            if (!_available) return;
+            ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        // 停止计数并把本次的值累加到 totals
+        void stop(uint64_t (&totals)[kCount])
+        {
+#if defined(__linux__)
+            if (!_available) return;
+            ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            uint64_t buf[1 + kCount] = {};
+            if (read(_fds[0], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) return;
+            for (int i = 0; i < kCount; ++i) totals[i] += buf[1 + i];
+#else
+            (void)totals;
+#endif
+        }
+
+    private:
+        void close_()
+        {
+#if defined(__linux__)
+            for (int& fd : _fds)
+            {
+                if (fd >= 0) ::close(fd);
+                fd = -1;
+            }
+#endif
+            _available = false;
+        }
+
+        int _fds[kCount] = { -1, -1, -1, -1 };
+        bool _available = false;
+    };
+
+    struct result
+    {
+        double ns_per_op = 0;
+        double allocs_per_op = 0;
+        double bytes_per_op = 0;
+        double counters[perf_counters::kCount] = {};
+        bool has_counters = false;
+    };
+
+    // 命令行：--filter=子串  只跑名字包含该子串的用例
+    //         --min-time=毫秒 每个样本的最短时间，默认 20
+    //         --samples=N     样本数，默认 5
+    class runner
+    {
+    public:
+        runner(int argc, char** argv)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string_view arg = argv[i];
+                if (arg.rfind("--filter=", 0) == 0) _filter = std::string(arg.substr(9));
+                else if (arg.rfind("--min-time=", 0) == 0) _min_time_ns = std::strtod(argv[i] + 11, nullptr) * 1e6;
+                else if (arg.rfind("--samples=", 0) == 0) _samples = std::max(1, std::atoi(argv[i] + 10));
+            }
+        }
+
+        bool selected(std::string_view name) const
+        {
+            return _filter.empty() || name.find(_filter) != std::string_view::npos;
+        }
+
+        void section(std::string_view title)
+        {
+            std::printf("\n== %.*s ==\n", int(title.size()), title.data());
+            std::printf("%-44s %-5s %10s %9s %10s", "benchmark", "impl", "ns/op", "allocs/op", "bytes/op");
+            for (const char* name : perf_counters::kNames) std::printf(" %9s", name);
+            std::printf(" %8s\n", "vs std");
+        }
+
+        // fn() 执行 ops 个操作
+        template<typename Fn>
+        result measure(size_t ops, Fn&& fn)
+        {
+            using clock = std::chrono::steady_clock;
+
+            fn();   // 预热
+            size_t reps = 1;
+            for (;;)
+            {
+                auto t0 = clock::now();
+                for (size_t r = 0; r < reps; ++r) fn();
+                double ns = std::chrono::duration<double, std::nano>(clock::now() - t0).count();
+                if (ns >= _min_time_ns || reps >= (size_t(1) << 30)) break;
+                reps = ns <= 0 ? reps * 16 : std::max(reps * 2, size_t(double(reps) * _min_time_ns * 1.2 / ns));
+            }
+
+            std::vector<double> samples;
+            uint64_t totals[perf_counters::kCount] = {};
+            const uint64_t alloc0 = allocations().count.load(std::memory_order_relaxed);
+            const uint64_t bytes0 = allocations().bytes.load(std::memory_order_relaxed);
+            for (int s = 0; s < _samples; ++s)
+            {
+                _perf.start();
+                auto t0 = clock::now();
+                for (size_t r = 0; r < reps; ++r) fn();
+                auto t1 = clock::now();
+                _perf.stop(totals);
+                samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+            }
+            const double total_ops = double(ops) * double(reps);
+            const double all_ops = total_ops * _samples;
+
+            result res;
+            std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+            res.ns_per_op = samples[samples.size() / 2] / total_ops;
+            res.allocs_per_op = double(allocations().count.load(std::memory_order_relaxed) - alloc0) / all_ops;
+            res.bytes_per_op = double(allocations().bytes.load(std::memory_order_relaxed) - bytes0) / all_ops;
+            res.has_counters = _perf.available();
+            for (int i = 0; i < perf_counters::kCount; ++i) res.counters[i] = double(totals[i]) / all_ops;
+            return res;
+        }
+
+        // 同一个用例分别跑 tiny 与 std 版本，tiny 一行给出相对 std 的加速比
+        template<typename TinyFn, typename StdFn>
+        void compare(std::string_view name, size_t ops, TinyFn&& tiny_fn, StdFn&& std_fn)
+        {
+            if (!selected(name)) return;
+            result t = measure(ops, tiny_fn);
+            result s = measure(ops, std_fn);
+            print_(name, "tiny", t, s.ns_per_op / t.ns_per_op);
+            print_(name, "std", s, 0);
+        }
+
+        // 没有 std 对照的用例
+        template<typename Fn>
+        void run(std::string_view name, std::string_view impl, size_t ops, Fn&& fn)
+        {
+            if (!selected(name)) return;
+            print_(name, impl, measure(ops, fn), 0);
+        }
+
+        bool counters_available() const { return _perf.available(); }
+
+    private:
+        void print_(std::string_view name, std::string_view impl, const result& r, double speedup)
+        {
+            std::printf("%-44.*s %-5.*s %10.2f %9.3f %10.1f", int(name.size()), name.data(),
+                        int(impl.size()), impl.data(), r.ns_per_op, r.allocs_per_op, r.bytes_per_op);
+            for (double c : r.counters)
+            {
+                if (r.has_counters) std::printf(" %9.1f", c);
+                else std::printf(" %9s", "-");
+            }
+            if (speedup > 0) std::printf(" %7.2fx", speedup);
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+
+    private:
+        std::string _filter;
+        double _min_time_ns = 20e6;
+        int _samples = 5;
+        perf_counters _perf;
+    };
+}
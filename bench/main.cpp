@@ -0,0 +1,332 @@
+// tiny 容器与 std 对照的微基准
+//
+// 没有构建文件，直接编译（务必打开优化）：
+//   g++ -std=c++20 -O2 -DNDEBUG -march=native bench/main.cpp -o tiny_bench
+//   ./tiny_bench                      全部用例
+//   ./tiny_bench --filter=vector      只跑名字包含 vector 的用例
+//   ./tiny_bench --min-time=50 --samples=7
+// 硬件计数器需要 perf_event_paranoid <= 2（或 CAP_PERFMON），否则对应列显示 "-"
+#include <cstdlib>
+#include <list>
+#include <new>
+#include <queue>
+#include <stack>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "../vector/vector.h"
+#include "../list/list.h"
+#include "../string/string.h"
+#include "../stack/stack.h"
+#include "../queue/queue.h"
+
+// 替换全局分配函数，统计每个操作的堆分配次数与字节数
+void* operator new(std::size_t size)
+{
+    tiny::bench::allocations().count.fetch_add(1, std::memory_order_relaxed);
+    tiny::bench::allocations().bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    tiny::bench::allocations().count.fetch_add(1, std::memory_order_relaxed);
+    tiny::bench::allocations().bytes.fetch_add(size, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+    using tiny::bench::do_not_optimize;
+
+    // 64 字节的可平凡拷贝元素
+    struct blob
+    {
+        uint64_t words[8];
+    };
+
+    template<typename T>
+    T make_value(size_t i)
+    {
+        if constexpr (std::is_same_v<T, blob>)
+        {
+            blob b;
+            for (uint64_t& w : b.words) w = i;
+            return b;
+        }
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            // 超过 SSO 长度，每个元素都有自己的堆内存
+            return std::string(32, char('a' + i % 26));
+        }
+        else
+        {
+            return static_cast<T>(i);
+        }
+    }
+
+    template<typename T>
+    uint64_t weight(const T& value)
+    {
+        if constexpr (std::is_same_v<T, blob>) return value.words[0];
+        else if constexpr (std::is_same_v<T, std::string>) return value.size();
+        else return static_cast<uint64_t>(value);
+    }
+
+    template<typename T> constexpr const char* type_label = "";
+    template<> constexpr const char* type_label<int> = "int";
+    template<> constexpr const char* type_label<blob> = "blob64";
+    template<> constexpr const char* type_label<std::string> = "std::string";
+
+    std::string case_name(const char* container, const char* type, const char* op, size_t n)
+    {
+        return std::string(container) + "<" + type + ">/" + op + "/" + std::to_string(n);
+    }
+
+    // ---------- 顺序容器（vector / list 共用） ----------
+
+    template<typename T, typename C>
+    void fill_back(C& c, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i) c.push_back(make_value<T>(i));
+    }
+
+    template<typename T, typename C>
+    void bench_push_back(size_t n)
+    {
+        C c;
+        fill_back<T>(c, n);
+        do_not_optimize(c);
+    }
+
+    template<typename T, typename C>
+    void bench_insert_front(size_t n)
+    {
+        C c;
+        for (size_t i = 0; i < n; ++i) c.insert(c.begin(), make_value<T>(i));
+        do_not_optimize(c);
+    }
+
+    // 始终在中间插入：vector 每次按下标定位，list 只在开始时走到中间一次
+    template<typename T, typename C, bool RandomAccess>
+    void bench_insert_middle(size_t n)
+    {
+        C c;
+        fill_back<T>(c, 2);
+        auto it = c.begin();
+        ++it;
+        for (size_t i = 0; i < n; ++i)
+        {
+            if constexpr (RandomAccess)
+                c.insert(c.begin() + c.size() / 2, make_value<T>(i));
+            else
+                it = c.insert(it, make_value<T>(i));
+        }
+        do_not_optimize(c);
+    }
+
+    // 先填满再从头逐个删除，包含填充的开销
+    template<typename T, typename C>
+    void bench_erase_front(size_t n)
+    {
+        C c;
+        fill_back<T>(c, n);
+        while (!c.empty()) c.erase(c.begin());
+        do_not_optimize(c);
+    }
+
+    template<typename C>
+    uint64_t bench_iterate(const C& c)
+    {
+        uint64_t sum = 0;
+        for (const auto& x : c) sum += weight(x);
+        do_not_optimize(sum);
+        return sum;
+    }
+
+    template<typename T, template<typename> class TinySeq, template<typename...> class StdSeq, bool is_list>
+    void sequence_suite(tiny::bench::runner& r, const char* label)
+    {
+        using tiny_c = TinySeq<T>;
+        using std_c = StdSeq<T>;
+        const char* type = type_label<T>;
+
+        for (size_t n : { size_t(1000), size_t(100000) })
+        {
+            r.compare(case_name(label, type, "push_back", n), n,
+                [n] { bench_push_back<T, tiny_c>(n); }, [n] { bench_push_back<T, std_c>(n); });
+
+            tiny_c tc;
+            std_c sc;
+            fill_back<T>(tc, n);
+            fill_back<T>(sc, n);
+            r.compare(case_name(label, type, "iterate", n), n,
+                [&] { bench_iterate(tc); }, [&] { bench_iterate(sc); });
+        }
+
+        // vector 的中间插入、头部删除是 O(n)，规模取小一些；list 再加一项头部插入
+        const size_t small = is_list ? 100000 : 2000;
+        r.compare(case_name(label, type, "insert_middle", small), small,
+            [small] { bench_insert_middle<T, tiny_c, !is_list>(small); },
+            [small] { bench_insert_middle<T, std_c, !is_list>(small); });
+        r.compare(case_name(label, type, "fill+erase_front", small), small,
+            [small] { bench_erase_front<T, tiny_c>(small); }, [small] { bench_erase_front<T, std_c>(small); });
+        if constexpr (is_list)
+        {
+            r.compare(case_name(label, type, "insert_front", small), small,
+                [small] { bench_insert_front<T, tiny_c>(small); }, [small] { bench_insert_front<T, std_c>(small); });
+        }
+    }
+
+    template<typename T> using tiny_vector = tiny::vector<T>;
+    template<typename T> using tiny_list = tiny::list<T>;
+
+    // ---------- string ----------
+
+    template<typename S>
+    void bench_append_char(size_t n)
+    {
+        S s;
+        for (size_t i = 0; i < n; ++i) s.push_back(char('a' + i % 26));
+        do_not_optimize(s);
+    }
+
+    template<typename S>
+    void bench_append_chunk(size_t n, const S& chunk)
+    {
+        S s;
+        for (size_t i = 0; i < n; ++i) s += chunk;
+        do_not_optimize(s);
+    }
+
+    template<typename S>
+    void bench_insert_front_char(size_t n)
+    {
+        S s;
+        for (size_t i = 0; i < n; ++i) s.insert(size_t(0), 1, char('a' + i % 26));
+        do_not_optimize(s);
+    }
+
+    template<typename S>
+    void bench_substr(const S& text, size_t n)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            S part = text.substr((i * 61) % (text.size() - 64), 64);
+            total += part.size();
+        }
+        do_not_optimize(total);
+    }
+
+    void string_suite(tiny::bench::runner& r)
+    {
+        for (size_t n : { size_t(100), size_t(100000) })
+        {
+            r.compare(case_name("string", "char", "append_char", n), n,
+                [n] { bench_append_char<tiny::string>(n); }, [n] { bench_append_char<std::string>(n); });
+        }
+
+        tiny::string tiny_chunk("0123456789abcdef");
+        std::string std_chunk("0123456789abcdef");
+        r.compare(case_name("string", "char", "append_16B", 10000), 10000,
+            [&] { bench_append_chunk(10000, tiny_chunk); }, [&] { bench_append_chunk(10000, std_chunk); });
+
+        // tiny::string 只有 insert(pos, char)，std 用 insert(pos, 1, ch)
+        r.compare(case_name("string", "char", "insert_front", 2000), 2000,
+            [] {
+                tiny::string s;
+                for (size_t i = 0; i < 2000; ++i) s.insert(0, char('a' + i % 26));
+                do_not_optimize(s);
+            },
+            [] { bench_insert_front_char<std::string>(2000); });
+
+        std::string std_text(4096, 'x');
+        tiny::string tiny_text(std_text.c_str());
+        r.compare(case_name("string", "char", "substr64", 10000), 10000,
+            [&] { bench_substr(tiny_text, 10000); }, [&] { bench_substr(std_text, 10000); });
+    }
+
+    // ---------- stack / queue 适配器 ----------
+
+    template<typename S>
+    void bench_stack(size_t n)
+    {
+        using T = std::decay_t<decltype(std::declval<S&>().top())>;
+        S s;
+        for (size_t i = 0; i < n; ++i) s.push(make_value<T>(i));
+        uint64_t sum = 0;
+        while (!s.empty())
+        {
+            sum += weight(s.top());
+            s.pop();
+        }
+        do_not_optimize(sum);
+    }
+
+    // 先灌满再交替进出，模拟稳定的生产/消费
+    template<typename Q>
+    void bench_queue(size_t n)
+    {
+        using T = std::decay_t<decltype(std::declval<Q&>().front())>;
+        Q q;
+        for (size_t i = 0; i < n; ++i) q.push(make_value<T>(i));
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            sum += weight(q.front());
+            q.pop();
+            q.push(make_value<T>(i));
+        }
+        while (!q.empty())
+        {
+            sum += weight(q.front());
+            q.pop();
+        }
+        do_not_optimize(sum);
+    }
+
+    template<typename T>
+    void adapter_suite(tiny::bench::runner& r)
+    {
+        const char* type = type_label<T>;
+        for (size_t n : { size_t(1000), size_t(100000) })
+        {
+            r.compare(case_name("stack", type, "push+pop", n), 2 * n,
+                [n] { bench_stack<stack<T, tiny::vector<T>>>(n); }, [n] { bench_stack<std::stack<T>>(n); });
+            r.compare(case_name("queue", type, "push+pop", n), 4 * n,
+                [n] { bench_queue<queue<T>>(n); }, [n] { bench_queue<std::queue<T>>(n); });
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    tiny::bench::runner r(argc, argv);
+    if (!r.counters_available()) std::printf("hardware counters unavailable (perf_event_open failed)\n");
+
+    r.section("vector");
+    sequence_suite<int, tiny_vector, std::vector, false>(r, "vector");
+    sequence_suite<blob, tiny_vector, std::vector, false>(r, "vector");
+    sequence_suite<std::string, tiny_vector, std::vector, false>(r, "vector");
+
+    r.section("list");
+    sequence_suite<int, tiny_list, std::list, true>(r, "list");
+    sequence_suite<std::string, tiny_list, std::list, true>(r, "list");
+
+    r.section("string");
+    string_suite(r);
+
+    r.section("stack / queue");
+    adapter_suite<int>(r);
+    adapter_suite<std::string>(r);
+    return 0;
+}
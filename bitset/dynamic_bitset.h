@@ -0,0 +1,514 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include "../memory/memory_resource.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace tiny {
+
+    namespace detail {
+        enum class bit_op { and_, or_, xor_, and_not };
+
+        // dst = dst op src，按 SIMD 宽度成块处理，剩下的按字处理
+        template<bit_op Op>
+        void bitwise_apply(uint64_t* dst, const uint64_t* src, size_t words)
+        {
+            size_t i = 0;
+#if defined(__AVX2__)
+            for (; i + 4 <= words; i += 4)
+            {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                __m256i r;
+                if constexpr (Op == bit_op::and_) r = _mm256_and_si256(a, b);
+                else if constexpr (Op == bit_op::or_) r = _mm256_or_si256(a, b);
+                else if constexpr (Op == bit_op::xor_) r = _mm256_xor_si256(a, b);
+                else r = _mm256_andnot_si256(b, a);   // a & ~b
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+            }
+#elif defined(__SSE2__)
+            for (; i + 2 <= words; i += 2)
+            {
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+                __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m128i r;
+                if constexpr (Op == bit_op::and_) r = _mm_and_si128(a, b);
+                else if constexpr (Op == bit_op::or_) r = _mm_or_si128(a, b);
+                else if constexpr (Op == bit_op::xor_) r = _mm_xor_si128(a, b);
+                else r = _mm_andnot_si128(b, a);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), r);
+            }
+#endif
+            for (; i < words; ++i)
+            {
+                if constexpr (Op == bit_op::and_) dst[i] &= src[i];
+                else if constexpr (Op == bit_op::or_) dst[i] |= src[i];
+                else if constexpr (Op == bit_op::xor_) dst[i] ^= src[i];
+                else dst[i] &= ~src[i];
+            }
+        }
+
+        inline size_t popcount(uint64_t w) { return static_cast<size_t>(std::popcount(w)); }
+        inline size_t lowest_set_bit(uint64_t w) { return static_cast<size_t>(std::countr_zero(w)); }
+    }
+
+    // 运行时长度的位集合，每个位只占 1 bit，按 64 位字存放
+    //
+    // 单个位的读写是一次移位加掩码；区间 set/reset/flip、count、find_first/find_next 都按整字处理，
+    // 两个位集合之间的 & | ^ 以及 and_not 用 SIMD 一次处理 2~4 个字
+    // 最后一个字中超出 size() 的位始终为 0，所以 count/any/find 不需要额外屏蔽
+    class dynamic_bitset
+    {
+    public:
+        using word_type = uint64_t;
+        static constexpr size_t bits_per_word = 64;
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        // operator[] 返回的代理对象，行为像 bool&
+        class reference
+        {
+        public:
+            reference& operator=(bool value)
+            {
+                if (value) *_word |= _mask;
+                else *_word &= ~_mask;
+                return *this;
+            }
+
+            reference& operator=(const reference& other)
+            {
+                return *this = bool(other);
+            }
+
+            operator bool() const { return (*_word & _mask) != 0; }
+            bool operator~() const { return !bool(*this); }
+
+            reference& flip()
+            {
+                *_word ^= _mask;
+                return *this;
+            }
+
+        private:
+            friend class dynamic_bitset;
+
+            reference(word_type* word, word_type mask) : _word(word), _mask(mask) {}
+
+            word_type* _word;
+            word_type _mask;
+        };
+
+        dynamic_bitset() = default;
+
+        explicit dynamic_bitset(memory_resource* r) : _resource(r) {}
+
+        explicit dynamic_bitset(size_t n, bool value = false, memory_resource* r = get_default_resource())
+            : _resource(r)
+        {
+            resize(n, value);
+        }
+
+        // 拷贝使用默认资源，移动连同资源一起带走，与 vector 一致
+        dynamic_bitset(const dynamic_bitset& other)
+        {
+            reserve(other._size);
+            if (other._size) std::memcpy(_words, other._words, other.num_words() * sizeof(word_type));
+            _size = other._size;
+        }
+
+        dynamic_bitset(dynamic_bitset&& other) noexcept
+            : _words(std::exchange(other._words, nullptr)),
+              _size(std::exchange(other._size, 0)),
+              _capacity(std::exchange(other._capacity, 0)),
+              _resource(other._resource)
+        {
+        }
+
+        // 赋值保留自己的资源
+        dynamic_bitset& operator=(const dynamic_bitset& other)
+        {
+            if (this == &other) return *this;
+            if (other.num_words() > _capacity)
+            {
+                word_type* tmp = allocate_(other.num_words());
+                deallocate_(_words, _capacity);
+                _words = tmp;
+                _capacity = other.num_words();
+            }
+            if (other._size) std::memcpy(_words, other._words, other.num_words() * sizeof(word_type));
+            if (_capacity > other.num_words())
+                std::memset(_words + other.num_words(), 0, (_capacity - other.num_words()) * sizeof(word_type));
+            _size = other._size;
+            return *this;
+        }
+
+        // 资源相同才能直接接管存储，否则按位拷贝
+        dynamic_bitset& operator=(dynamic_bitset&& other)
+        {
+            if (this == &other) return *this;
+            if (*_resource != *other._resource) return *this = static_cast<const dynamic_bitset&>(other);
+            deallocate_(_words, _capacity);
+            _words = std::exchange(other._words, nullptr);
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, 0);
+            return *this;
+        }
+
+        ~dynamic_bitset()
+        {
+            deallocate_(_words, _capacity);
+        }
+
+        void swap(dynamic_bitset& other) noexcept
+        {
+            std::swap(_words, other._words);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+            std::swap(_resource, other._resource);
+        }
+
+        memory_resource* resource() const { return _resource; }
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        size_t capacity() const { return _capacity * bits_per_word; }
+        size_t num_words() const { return words_for(_size); }
+
+        word_type* data() { return _words; }
+        const word_type* data() const { return _words; }
+
+        // 预留至少 n 位的空间
+        void reserve(size_t n)
+        {
+            size_t words = words_for(n);
+            if (words <= _capacity) return;
+
+            word_type* tmp = allocate_(words);
+            const size_t used = num_words();
+            if (used) std::memcpy(tmp, _words, used * sizeof(word_type));
+            std::memset(tmp + used, 0, (words - used) * sizeof(word_type));
+            deallocate_(_words, _capacity);
+            _words = tmp;
+            _capacity = words;
+        }
+
+        void resize(size_t n, bool value = false)
+        {
+            if (n > _size)
+            {
+                reserve(n);
+                const size_t old = _size;
+                _size = n;
+                if (value) set_range(old, n - old);
+            }
+            else
+            {
+                _size = n;
+                clear_unused_bits();
+                // 被截掉的整字清零，之后再变长时不会带出旧数据
+                const size_t used = num_words();
+                if (_capacity > used) std::memset(_words + used, 0, (_capacity - used) * sizeof(word_type));
+            }
+        }
+
+        void clear()
+        {
+            resize(0);
+        }
+
+        void push_back(bool value)
+        {
+            if (_size == capacity()) reserve(_size == 0 ? bits_per_word : _size * 2);
+            const size_t i = _size++;
+            if (value) _words[i / bits_per_word] |= mask_of(i);
+        }
+
+        void pop_back()
+        {
+            assert(_size > 0);
+            --_size;
+            _words[_size / bits_per_word] &= ~mask_of(_size);
+        }
+
+        // 在 pos 处插入一位，后面的位整体后移一位：逐字左移并把最高位进位到下一个字
+        void insert(size_t pos, bool value)
+        {
+            assert(pos <= _size);
+            push_back(false);
+            const size_t first = pos / bits_per_word;
+            for (size_t i = num_words() - 1; i > first; --i)
+            {
+                _words[i] = (_words[i] << 1) | (_words[i - 1] >> (bits_per_word - 1));
+            }
+            const word_type low = mask_of(pos) - 1;   // pos 之前的位保持不动
+            const word_type w = _words[first];
+            _words[first] = (w & low) | ((w & ~low) << 1);
+            if (value) _words[first] |= mask_of(pos);
+        }
+
+        // 删除 pos 处的一位，后面的位整体前移一位：逐字右移并从下一个字借入最低位
+        void erase(size_t pos)
+        {
+            assert(pos < _size);
+            const size_t words = num_words();
+            const size_t first = pos / bits_per_word;
+            const word_type low = mask_of(pos) - 1;
+            const word_type w = _words[first];
+            _words[first] = (w & low) | ((w >> 1) & ~low);
+            for (size_t i = first; i + 1 < words; ++i)
+            {
+                _words[i] |= _words[i + 1] << (bits_per_word - 1);
+                _words[i + 1] >>= 1;
+            }
+            --_size;   // 原来的最高位已经移出，不需要再清
+        }
+
+        // ---------- 单个位 ----------
+
+        bool test(size_t i) const
+        {
+            assert(i < _size);
+            return (_words[i / bits_per_word] & mask_of(i)) != 0;
+        }
+
+        bool operator[](size_t i) const { return test(i); }
+
+        reference operator[](size_t i)
+        {
+            assert(i < _size);
+            return reference(_words + i / bits_per_word, mask_of(i));
+        }
+
+        dynamic_bitset& set(size_t i, bool value = true)
+        {
+            assert(i < _size);
+            if (value) _words[i / bits_per_word] |= mask_of(i);
+            else _words[i / bits_per_word] &= ~mask_of(i);
+            return *this;
+        }
+
+        dynamic_bitset& reset(size_t i)
+        {
+            return set(i, false);
+        }
+
+        dynamic_bitset& flip(size_t i)
+        {
+            assert(i < _size);
+            _words[i / bits_per_word] ^= mask_of(i);
+            return *this;
+        }
+
+        // ---------- 区间与整体操作，按字处理 ----------
+
+        // [pos, pos + len) 全部置 1
+        dynamic_bitset& set_range(size_t pos, size_t len)
+        {
+            apply_range(pos, len, [](word_type& w, word_type m) { w |= m; });
+            return *this;
+        }
+
+        dynamic_bitset& reset_range(size_t pos, size_t len)
+        {
+            apply_range(pos, len, [](word_type& w, word_type m) { w &= ~m; });
+            return *this;
+        }
+
+        dynamic_bitset& flip_range(size_t pos, size_t len)
+        {
+            apply_range(pos, len, [](word_type& w, word_type m) { w ^= m; });
+            return *this;
+        }
+
+        dynamic_bitset& set()
+        {
+            return set_range(0, _size);
+        }
+
+        dynamic_bitset& reset()
+        {
+            if (_size) std::memset(_words, 0, num_words() * sizeof(word_type));
+            return *this;
+        }
+
+        dynamic_bitset& flip()
+        {
+            return flip_range(0, _size);
+        }
+
+        // 置 1 的位数
+        size_t count() const
+        {
+            size_t n = 0;
+            const size_t words = num_words();
+            for (size_t i = 0; i < words; ++i) n += detail::popcount(_words[i]);
+            return n;
+        }
+
+        bool any() const
+        {
+            const size_t words = num_words();
+            for (size_t i = 0; i < words; ++i)
+            {
+                if (_words[i]) return true;
+            }
+            return false;
+        }
+
+        bool none() const { return !any(); }
+        bool all() const { return count() == _size; }
+
+        // 第一个置 1 的位，没有时返回 npos
+        size_t find_first() const
+        {
+            return find_from_word(0);
+        }
+
+        // pos 之后（不含 pos）第一个置 1 的位
+        size_t find_next(size_t pos) const
+        {
+            ++pos;
+            if (pos >= _size) return npos;
+
+            const size_t wi = pos / bits_per_word;
+            const word_type w = _words[wi] & (~word_type(0) << (pos % bits_per_word));
+            if (w) return wi * bits_per_word + detail::lowest_set_bit(w);
+            return find_from_word(wi + 1);
+        }
+
+        // ---------- 位集合之间的运算，两边长度必须相同 ----------
+
+        dynamic_bitset& operator&=(const dynamic_bitset& other)
+        {
+            assert(_size == other._size);
+            detail::bitwise_apply<detail::bit_op::and_>(_words, other._words, num_words());
+            return *this;
+        }
+
+        dynamic_bitset& operator|=(const dynamic_bitset& other)
+        {
+            assert(_size == other._size);
+            detail::bitwise_apply<detail::bit_op::or_>(_words, other._words, num_words());
+            return *this;
+        }
+
+        dynamic_bitset& operator^=(const dynamic_bitset& other)
+        {
+            assert(_size == other._size);
+            detail::bitwise_apply<detail::bit_op::xor_>(_words, other._words, num_words());
+            return *this;
+        }
+
+        // *this &= ~other
+        dynamic_bitset& and_not(const dynamic_bitset& other)
+        {
+            assert(_size == other._size);
+            detail::bitwise_apply<detail::bit_op::and_not>(_words, other._words, num_words());
+            return *this;
+        }
+
+        // 两个集合是否有公共的位，不产生中间结果
+        bool intersects(const dynamic_bitset& other) const
+        {
+            assert(_size == other._size);
+            const size_t words = num_words();
+            for (size_t i = 0; i < words; ++i)
+            {
+                if (_words[i] & other._words[i]) return true;
+            }
+            return false;
+        }
+
+        // popcount(*this & other)，同样不产生中间结果
+        size_t count_and(const dynamic_bitset& other) const
+        {
+            assert(_size == other._size);
+            size_t n = 0;
+            const size_t words = num_words();
+            for (size_t i = 0; i < words; ++i) n += detail::popcount(_words[i] & other._words[i]);
+            return n;
+        }
+
+        friend bool operator==(const dynamic_bitset& a, const dynamic_bitset& b)
+        {
+            return a._size == b._size
+                && (a._size == 0 || std::memcmp(a._words, b._words, a.num_words() * sizeof(word_type)) == 0);
+        }
+
+    private:
+        static size_t words_for(size_t bits) { return (bits + bits_per_word - 1) / bits_per_word; }
+        static word_type mask_of(size_t i) { return word_type(1) << (i % bits_per_word); }
+
+        // 按 32 字节对齐，SIMD 加载不会跨缓存行
+        word_type* allocate_(size_t words)
+        {
+            return static_cast<word_type*>(_resource->allocate(words * sizeof(word_type), 32));
+        }
+
+        void deallocate_(word_type* p, size_t words)
+        {
+            if (p) _resource->deallocate(p, words * sizeof(word_type), 32);
+        }
+
+        void clear_unused_bits()
+        {
+            if (_size % bits_per_word)
+            {
+                _words[_size / bits_per_word] &= ~word_type(0) >> (bits_per_word - _size % bits_per_word);
+            }
+        }
+
+        // 首尾两个字用掩码处理，中间的整字直接处理
+        template<typename F>
+        void apply_range(size_t pos, size_t len, F&& f)
+        {
+            assert(pos <= _size && len <= _size - pos);
+            if (len == 0) return;
+
+            const size_t last = pos + len;           // 不含
+            size_t first_word = pos / bits_per_word;
+            const size_t last_word = (last - 1) / bits_per_word;
+            const word_type head = ~word_type(0) << (pos % bits_per_word);
+            const word_type tail = ~word_type(0) >> (bits_per_word - 1 - (last - 1) % bits_per_word);
+
+            if (first_word == last_word)
+            {
+                f(_words[first_word], head & tail);
+                return;
+            }
+            f(_words[first_word], head);
+            for (++first_word; first_word < last_word; ++first_word) f(_words[first_word], ~word_type(0));
+            f(_words[last_word], tail);
+        }
+
+        size_t find_from_word(size_t wi) const
+        {
+            const size_t words = num_words();
+            for (; wi < words; ++wi)
+            {
+                if (_words[wi]) return wi * bits_per_word + detail::lowest_set_bit(_words[wi]);
+            }
+            return npos;
+        }
+
+    private:
+        word_type* _words = nullptr;
+        size_t _size = 0;       // 位数
+        size_t _capacity = 0;   // 字数
+        memory_resource* _resource = get_default_resource();
+    };
+
+    inline dynamic_bitset operator&(dynamic_bitset a, const dynamic_bitset& b) { a &= b; return a; }
+    inline dynamic_bitset operator|(dynamic_bitset a, const dynamic_bitset& b) { a |= b; return a; }
+    inline dynamic_bitset operator^(dynamic_bitset a, const dynamic_bitset& b) { a ^= b; return a; }
+}
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cassert>
+#include "dynamic_bitset.h"
+
+// 1. 单个位与长度变化
+void test_basic() {
+    tiny::dynamic_bitset b(100);
+    assert(b.size() == 100 && b.none() && b.count() == 0);
+    b.set(0).set(63).set(64).set(99);
+    assert(b.test(63) && b[64] && !b[65] && b.count() == 4);
+    b.reset(63);
+    b.flip(1);
+    b[2] = true;
+    b[3] = b[2];
+    assert(!b[63] && b[1] && b[2] && b[3] && b.count() == 6);
+
+    // 缩短后再变长，被截掉的位不会复活
+    b.resize(64);
+    assert(b.count() == 4);
+    b.resize(200);
+    assert(b.count() == 4 && !b[99]);
+    b.resize(300, true);
+    assert(b.count() == 104 && b[299] && !b[199]);
+
+    tiny::dynamic_bitset p;
+    for (int i = 0; i < 1000; ++i) p.push_back(i % 3 == 0);
+    assert(p.size() == 1000 && p.count() == 334);
+    p.pop_back();
+    assert(p.size() == 999 && p.count() == 333);
+
+    tiny::dynamic_bitset copy(p);
+    assert(copy == p);
+    copy.flip(5);
+    assert(!(copy == p));
+}
+
+// 2. 区间操作与整体操作
+void test_range_ops() {
+    tiny::dynamic_bitset b(1000);
+    b.set_range(10, 500);
+    assert(b.count() == 500 && !b[9] && b[10] && b[509] && !b[510]);
+    b.reset_range(64, 128);
+    assert(b.count() == 372 && b[63] && !b[64] && !b[191] && b[192]);
+    b.flip_range(0, 20);
+    assert(b[0] && b[9] && !b[10] && !b[19] && b[20]);
+    b.set_range(5, 0);
+
+    b.set();
+    assert(b.all() && b.count() == 1000);
+    b.flip();
+    assert(b.none());
+    b.set(999);
+    b.reset();
+    assert(b.none());
+}
+
+// 3. find_first / find_next
+void test_find() {
+    tiny::dynamic_bitset b(500);
+    assert(b.find_first() == tiny::dynamic_bitset::npos);
+    int positions[] = {3, 63, 64, 200, 499};
+    for (int p : positions) b.set(p);
+
+    std::vector<size_t> found;
+    for (size_t i = b.find_first(); i != tiny::dynamic_bitset::npos; i = b.find_next(i)) found.push_back(i);
+    assert(found.size() == 5);
+    for (int k = 0; k < 5; ++k) assert(found[k] == size_t(positions[k]));
+    assert(b.find_next(499) == tiny::dynamic_bitset::npos);
+}
+
+// 4. 位集合之间的运算，与逐位计算的结果对比
+void test_bulk_ops() {
+    std::mt19937 rng(5);
+    const size_t n = 1237;   // 不是字长的整数倍
+    tiny::dynamic_bitset a(n), b(n);
+    std::vector<bool> ra(n), rb(n);
+    for (size_t i = 0; i < n; ++i) {
+        ra[i] = rng() % 2;
+        rb[i] = rng() % 3 == 0;
+        a.set(i, ra[i]);
+        b.set(i, rb[i]);
+    }
+
+    tiny::dynamic_bitset x = a & b, o = a | b, e = a ^ b, d = a;
+    d.and_not(b);
+    size_t common = 0;
+    for (size_t i = 0; i < n; ++i) {
+        assert(x[i] == (ra[i] && rb[i]));
+        assert(o[i] == (ra[i] || rb[i]));
+        assert(e[i] == (ra[i] != rb[i]));
+        assert(d[i] == (ra[i] && !rb[i]));
+        common += ra[i] && rb[i];
+    }
+    assert(a.count_and(b) == common && x.count() == common);
+    assert(a.intersects(b) && !d.intersects(b));
+
+    // 取反后超出 size 的位仍然为 0
+    e.flip();
+    assert(e.count() == n - (a ^ b).count());
+}
+
+// 5. 中间插入/删除按整字移位，跨字进位与 std::vector<bool> 对照
+void test_insert_erase() {
+    tiny::dynamic_bitset b;
+    std::vector<bool> ref;
+    std::mt19937 rng(5);
+    for (int step = 0; step < 20000; ++step) {
+        if (ref.empty() || rng() % 3 != 0) {
+            size_t pos = ref.empty() ? 0 : rng() % (ref.size() + 1);
+            if (step % 50 == 0) pos = ref.size() / 64 * 64;   // 正好在字边界上
+            bool v = rng() & 1;
+            b.insert(pos, v);
+            ref.insert(ref.begin() + pos, v);
+        } else {
+            size_t pos = rng() % ref.size();
+            b.erase(pos);
+            ref.erase(ref.begin() + pos);
+        }
+        if (step % 97 == 0) {
+            assert(b.size() == ref.size());
+            for (size_t i = 0; i < ref.size(); ++i) assert(b.test(i) == ref[i]);
+        }
+    }
+    size_t ones = 0;
+    for (bool x : ref) ones += x;
+    assert(b.count() == ones);   // 超出 size() 的位保持为 0
+
+    // 内存资源：拷贝用默认资源，赋值保留目标的资源
+    tiny::monotonic_buffer_resource arena;
+    tiny::dynamic_bitset on_arena(100, true, &arena);
+    assert(on_arena.resource() == &arena && arena.bytes_reserved() > 0);
+    tiny::dynamic_bitset copy(on_arena);
+    assert(copy.resource() == tiny::get_default_resource() && copy == on_arena);
+    on_arena = b;
+    assert(on_arena.resource() == &arena && on_arena == b);
+    on_arena = std::move(copy);
+    assert(on_arena.resource() == &arena && on_arena.size() == 100 && on_arena.all());
+}
+
+int main() {
+    test_basic();
+    test_range_ops();
+    test_find();
+    test_bulk_ops();
+    test_insert_erase();
+    std::cout << "all dynamic_bitset tests passed!" << std::endl;
+    return 0;
+}
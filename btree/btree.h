@@ -0,0 +1,942 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "../flat_map/flat_map.h"   // detail::arrow_proxy / branchless_lower_bound
+#include "../vector/vector.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace tiny {
+
+    // 标记：输入区间已经按 key 严格递增排好序，可以直接批量建树
+    struct sorted_unique_t { explicit sorted_unique_t() = default; };
+    inline constexpr sorted_unique_t sorted_unique{};
+
+    namespace detail {
+
+        // 每个节点的 key 数组占两条缓存行，至少 4 个、最多 64 个，并且是 4 的倍数（方便 SIMD 整组比较）
+        template<typename Key>
+        constexpr size_t btree_node_slots()
+        {
+            size_t n = 128 / sizeof(Key);
+            if (n < 4) n = 4;
+            if (n > 64) n = 64;
+            return n & ~size_t(3);
+        }
+
+        // 4/8 字节整数配 std::less 时，节点内查找用 SIMD 一次比较多个 key
+        template<typename Key, typename Compare, typename K>
+        constexpr bool btree_simd_search_v =
+            std::is_same_v<K, Key> && std::is_integral_v<Key> && !std::is_same_v<Key, bool>
+            && (std::is_same_v<Compare, std::less<Key>> || std::is_same_v<Compare, std::less<>>)
+#if defined(__SSE4_2__)
+            && (sizeof(Key) == 4 || sizeof(Key) == 8);
+#elif defined(__SSE2__)
+            && sizeof(Key) == 4;
+#else
+            && false;
+#endif
+
+        // 统计有序数组 keys[0, n) 中小于 key（strict=true）或不大于 key（strict=false）的个数
+        // 数组容量是 4 的倍数，最后一组可能读到未使用的槽，按 n 把多余的位屏蔽掉
+        template<bool Strict, typename Key>
+        size_t simd_count_less(const Key* keys, size_t n, Key key)
+        {
+#if defined(__SSE2__)
+            if constexpr (sizeof(Key) == 4)
+            {
+                // 无符号数先翻转符号位，再用有符号比较
+                const int32_t bias = std::is_signed_v<Key> ? 0 : INT32_MIN;
+                const __m128i vbias = _mm_set1_epi32(bias);
+                const __m128i vkey = _mm_set1_epi32(static_cast<int32_t>(key) ^ bias);
+                size_t count = 0;
+                for (size_t i = 0; i < n; i += 4)
+                {
+                    __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), vbias);
+                    // Strict: v < key；否则 v <= key，即 !(v > key)
+                    __m128i hit = Strict ? _mm_cmpgt_epi32(vkey, v)
+                                         : _mm_xor_si128(_mm_cmpgt_epi32(v, vkey), _mm_set1_epi32(-1));
+                    unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hit)));
+                    if (n - i < 4) mask &= (1u << (n - i)) - 1;
+                    count += static_cast<size_t>(std::popcount(mask));
+                    if (mask != 0xf) break;   // 有序，后面不会再命中
+                }
+                return count;
+            }
+#endif
+#if defined(__SSE4_2__)
+            if constexpr (sizeof(Key) == 8)
+            {
+                const int64_t bias = std::is_signed_v<Key> ? 0 : INT64_MIN;
+                const __m128i vbias = _mm_set1_epi64x(bias);
+                const __m128i vkey = _mm_set1_epi64x(static_cast<int64_t>(key) ^ bias);
+                size_t count = 0;
+                for (size_t i = 0; i < n; i += 2)
+                {
+                    __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), vbias);
+                    __m128i hit = Strict ? _mm_cmpgt_epi64(vkey, v)
+                                         : _mm_xor_si128(_mm_cmpgt_epi64(v, vkey), _mm_set1_epi32(-1));
+                    unsigned mask = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(hit)));
+                    if (n - i < 2) mask &= 1u;
+                    count += static_cast<size_t>(std::popcount(mask));
+                    if (mask != 0x3) break;
+                }
+                return count;
+            }
+#endif
+            size_t count = 0;
+            while (count < n && (Strict ? keys[count] < key : !(key < keys[count]))) ++count;
+            return count;
+        }
+
+        template<typename Mapped, size_t N>
+        struct btree_leaf_values
+        {
+            btree_leaf_values() {}
+            ~btree_leaf_values() {}
+            union { Mapped vals[N]; };
+        };
+
+        template<size_t N>
+        struct btree_leaf_values<void, N> {};
+
+        struct btree_node_base
+        {
+            uint16_t count = 0;
+            bool is_leaf = false;
+        };
+
+        // 叶子：key 数组在前，查找时只碰这几条缓存行；相邻叶子双向链接，区间遍历不回溯
+        template<typename Key, typename Mapped, size_t N>
+        struct alignas(64) btree_leaf : btree_node_base
+        {
+            btree_leaf() { is_leaf = true; }
+            ~btree_leaf() {}
+
+            union { Key keys[N]; };
+            btree_leaf* prev = nullptr;
+            btree_leaf* next = nullptr;
+            btree_leaf_values<Mapped, N> values;
+        };
+
+        // 内部节点：keys[i] 是 children[i + 1] 子树中 key 的下界
+        template<typename Key, size_t N>
+        struct alignas(64) btree_internal : btree_node_base
+        {
+            btree_internal() {}
+            ~btree_internal() {}
+
+            union { Key keys[N]; };
+            btree_node_base* children[N + 1];
+        };
+
+        // 在已构造了 n 个元素的原始数组 a 中，于 pos 处构造新元素（要求容量大于 n）
+        template<typename T, typename... Args>
+        void slots_emplace(T* a, size_t n, size_t pos, Args&&... args)
+        {
+            if (pos == n)
+            {
+                new (a + n) T(std::forward<Args>(args)...);
+                return;
+            }
+            T tmp(std::forward<Args>(args)...);
+            new (a + n) T(std::move(a[n - 1]));
+            std::move_backward(a + pos, a + n - 1, a + n);
+            a[pos] = std::move(tmp);
+        }
+
+        template<typename T>
+        void slots_erase(T* a, size_t n, size_t pos)
+        {
+            std::move(a + pos + 1, a + n, a + pos);
+            a[n - 1].~T();
+        }
+
+        // 把 src 的 n 个元素搬到 dst 的未初始化空间，并析构 src 中的原对象
+        template<typename T>
+        void slots_relocate(T* dst, T* src, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                new (dst + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+
+        template<typename T>
+        void slots_destroy(T* a, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i) a[i].~T();
+        }
+
+        // B+ 树，btree_map / btree_set 的公共实现；Mapped 为 void 时是集合
+        //
+        // 所有元素都在叶子里，内部节点只存分隔 key，节点按缓存行对齐，
+        // 一个节点放几十个 key，树高只有红黑树的几分之一，每层一次缓存未命中，
+        // 节点内查找是对连续 key 数组的无分支二分（整数 key 可用 SIMD）
+        //
+        // 插入和删除都会移动节点里的元素，迭代器与引用在修改后失效
+        template<typename Key, typename Mapped, typename Compare>
+        class btree
+        {
+        protected:
+            static constexpr bool kIsMap = !std::is_void_v<Mapped>;
+            static constexpr size_t N = btree_node_slots<Key>();
+            static constexpr size_t kMinLeaf = N / 2;
+            static constexpr size_t kMinInternal = N / 2 - 1;
+            static constexpr int kMaxHeight = 64;
+
+            using node_base = btree_node_base;
+            using leaf_type = btree_leaf<Key, Mapped, N>;
+            using internal_type = btree_internal<Key, N>;
+
+            // 从根到叶子的路径，插入分裂与删除合并时沿着它往回走
+            struct path_type
+            {
+                internal_type* nodes[kMaxHeight];
+                size_t index[kMaxHeight];   // 在 nodes[i] 里走的是第几个孩子
+                int depth = 0;
+            };
+
+        public:
+            using key_type = Key;
+            using size_type = size_t;
+            using key_compare = Compare;
+
+            template<bool Const>
+            class basic_iterator
+            {
+                using mapped_ref = std::add_lvalue_reference_t<std::conditional_t<Const, const Mapped, Mapped>>;
+
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using difference_type = std::ptrdiff_t;
+                using value_type = std::conditional_t<kIsMap, std::pair<Key, Mapped>, Key>;
+                using reference = std::conditional_t<kIsMap, std::pair<const Key&, mapped_ref>, const Key&>;
+                using pointer = std::conditional_t<kIsMap, arrow_proxy<reference>, const Key*>;
+
+                basic_iterator() = default;
+
+                template<bool C = Const> requires C
+                basic_iterator(const basic_iterator<false>& it)
+                    : _leaf(it._leaf), _pos(it._pos)
+                {}
+
+                reference operator*() const
+                {
+                    if constexpr (kIsMap) return reference(_leaf->keys[_pos], _leaf->values.vals[_pos]);
+                    else return _leaf->keys[_pos];
+                }
+
+                pointer operator->() const
+                {
+                    if constexpr (kIsMap) return pointer{**this};
+                    else return &_leaf->keys[_pos];
+                }
+
+                const Key& key() const { return _leaf->keys[_pos]; }
+
+                basic_iterator& operator++()
+                {
+                    ++_pos;
+                    if (_pos == _leaf->count && _leaf->next)
+                    {
+                        _leaf = _leaf->next;
+                        _pos = 0;
+                    }
+                    return *this;
+                }
+
+                basic_iterator& operator--()
+                {
+                    if (_pos == 0)
+                    {
+                        _leaf = _leaf->prev;
+                        _pos = _leaf->count;
+                    }
+                    --_pos;
+                    return *this;
+                }
+
+                basic_iterator operator++(int) { basic_iterator tmp(*this); ++*this; return tmp; }
+                basic_iterator operator--(int) { basic_iterator tmp(*this); --*this; return tmp; }
+
+                template<bool C>
+                bool operator==(const basic_iterator<C>& it) const { return _leaf == it._leaf && _pos == it._pos; }
+                template<bool C>
+                bool operator!=(const basic_iterator<C>& it) const { return !(*this == it); }
+
+            private:
+                friend class btree;
+                template<bool> friend class basic_iterator;
+
+                basic_iterator(leaf_type* leaf, size_t pos)
+                    : _leaf(leaf), _pos(pos)
+                {
+                    // 落在叶子末尾时归一化到下一个叶子的开头，end() 是最后一个叶子的末尾
+                    if (_leaf && _pos == _leaf->count && _leaf->next)
+                    {
+                        _leaf = _leaf->next;
+                        _pos = 0;
+                    }
+                }
+
+                leaf_type* _leaf = nullptr;
+                size_t _pos = 0;
+            };
+
+            using iterator = basic_iterator<false>;
+            using const_iterator = basic_iterator<true>;
+
+            btree() = default;
+
+            explicit btree(const Compare& comp)
+                : _comp(comp)
+            {}
+
+            btree(const btree& other)
+                : _comp(other._comp)
+            {
+                bulk_load(other.begin(), other.end(), other._size);
+            }
+
+            btree(btree&& other) noexcept
+                : _comp(other._comp)
+            {
+                swap(other);
+            }
+
+            btree& operator=(btree other) noexcept
+            {
+                swap(other);
+                return *this;
+            }
+
+            ~btree()
+            {
+                clear();
+            }
+
+            void swap(btree& other) noexcept
+            {
+                std::swap(_root, other._root);
+                std::swap(_first, other._first);
+                std::swap(_last, other._last);
+                std::swap(_size, other._size);
+                std::swap(_height, other._height);
+                std::swap(_comp, other._comp);
+            }
+
+            iterator begin() { return iterator(_first, 0); }
+            iterator end() { return iterator(_last, _last ? _last->count : 0); }
+            const_iterator begin() const { return const_iterator(_first, 0); }
+            const_iterator end() const { return const_iterator(_last, _last ? _last->count : 0); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            bool empty() const { return _size == 0; }
+            size_t size() const { return _size; }
+            size_t height() const { return _root ? size_t(_height) + 1 : 0; }
+            key_compare key_comp() const { return _comp; }
+
+            // 每个节点能放多少个 key
+            static constexpr size_t node_capacity() { return N; }
+
+            void clear()
+            {
+                if (_root) destroy(_root);
+                _root = nullptr;
+                _first = _last = nullptr;
+                _size = 0;
+                _height = 0;
+            }
+
+            // ---------- 查找 ----------
+
+            template<typename K>
+            iterator lower_bound(const K& key)
+            {
+                if (!_root) return end();
+                leaf_type* leaf = descend(key, nullptr);
+                return iterator(leaf, search<true>(leaf->keys, leaf->count, key));
+            }
+
+            template<typename K>
+            const_iterator lower_bound(const K& key) const
+            {
+                return const_cast<btree*>(this)->lower_bound(key);
+            }
+
+            template<typename K>
+            iterator upper_bound(const K& key)
+            {
+                if (!_root) return end();
+                leaf_type* leaf = descend(key, nullptr);
+                return iterator(leaf, search<false>(leaf->keys, leaf->count, key));
+            }
+
+            template<typename K>
+            const_iterator upper_bound(const K& key) const
+            {
+                return const_cast<btree*>(this)->upper_bound(key);
+            }
+
+            template<typename K>
+            iterator find(const K& key)
+            {
+                iterator it = lower_bound(key);
+                if (it != end() && !_comp(key, it.key())) return it;
+                return end();
+            }
+
+            template<typename K>
+            const_iterator find(const K& key) const
+            {
+                return const_cast<btree*>(this)->find(key);
+            }
+
+            template<typename K>
+            bool contains(const K& key) const
+            {
+                return find(key) != end();
+            }
+
+            template<typename K>
+            size_t count(const K& key) const
+            {
+                return contains(key) ? 1 : 0;
+            }
+
+            template<typename K>
+            std::pair<iterator, iterator> equal_range(const K& key)
+            {
+                return {lower_bound(key), upper_bound(key)};
+            }
+
+            template<typename K>
+            std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+            {
+                return {lower_bound(key), upper_bound(key)};
+            }
+
+            // ---------- 删除 ----------
+
+            // 返回被删元素的下一个位置
+            iterator erase(const_iterator pos)
+            {
+                assert(pos != end());
+                leaf_type* leaf = pos._leaf;
+                const size_t i = pos._pos;
+
+                path_type path;
+                [[maybe_unused]] leaf_type* found = descend(leaf->keys[i], &path);
+                assert(found == leaf);
+
+                // 会触发合并/借位时元素会搬家，先记下后继的 key，删完再找回来
+                std::optional<Key> next_key;
+                if (leaf != _root && size_t(leaf->count) < kMinLeaf + 1)
+                {
+                    const_iterator next = std::next(pos);
+                    if (next != end()) next_key.emplace(next.key());
+                }
+
+                const bool moved = erase_at(path, leaf, i);
+                if (!_root) return end();
+                if (!moved) return iterator(leaf, i);
+                return next_key ? lower_bound(*next_key) : end();
+            }
+
+            iterator erase(const_iterator first, const_iterator last)
+            {
+                if (first == begin() && last == end())
+                {
+                    clear();
+                    return end();
+                }
+                if (last == end())
+                {
+                    while (first != end()) first = erase(first);
+                    return end();
+                }
+
+                Key stop = last.key();
+                iterator it(first._leaf, first._pos);
+                while (_comp(it.key(), stop)) it = erase(it);
+                return it;
+            }
+
+            template<typename K>
+            size_t erase_key(const K& key)
+            {
+                if (!_root) return 0;
+                path_type path;
+                leaf_type* leaf = descend(key, &path);
+                size_t i = search<true>(leaf->keys, leaf->count, key);
+                if (i == leaf->count || _comp(key, leaf->keys[i])) return 0;
+                erase_at(path, leaf, i);
+                return 1;
+            }
+
+        protected:
+            // 不存在时插入 (key, args...)，存在时什么都不做
+            template<typename K, typename... Args>
+            std::pair<iterator, bool> emplace_unique(K&& key, Args&&... args)
+            {
+                if (!_root)
+                {
+                    _first = _last = new leaf_type;
+                    _root = _first;
+                    _height = 0;
+                }
+
+                path_type path;
+                leaf_type* leaf = descend(key, &path);
+                size_t pos = search<true>(leaf->keys, leaf->count, key);
+                if (pos < leaf->count && !_comp(key, leaf->keys[pos])) return {iterator(leaf, pos), false};
+
+                // key/args 可能引用树内的元素（如 m.try_emplace(k, m.at(x))），而插入和分裂都会搬动元素：
+                // 先构造成临时对象，之后只从临时对象移动
+                Key k(std::forward<K>(key));
+                if constexpr (kIsMap)
+                {
+                    Mapped v(std::forward<Args>(args)...);
+                    return {insert_at(path, leaf, pos, std::move(k), std::move(v)), true};
+                }
+                else
+                {
+                    return {insert_at(path, leaf, pos, std::move(k)), true};
+                }
+            }
+
+            // 在 leaf 的 pos 处插入新元素，叶子满了就分裂
+            template<typename... Vals>
+            iterator insert_at(path_type& path, leaf_type* leaf, size_t pos, Key&& key, Vals&&... vals)
+            {
+                if (leaf->count < N)
+                {
+                    leaf_emplace(leaf, pos, std::move(key), std::forward<Vals>(vals)...);
+                    ++_size;
+                    return iterator(leaf, pos);
+                }
+
+                // 叶子满了：分裂
+                // 在最右叶子末尾追加（顺序插入）时不对半分，左边保持满载，新叶子从空开始
+                leaf_type* right = new leaf_type;
+                right->prev = leaf;
+                right->next = leaf->next;
+                if (leaf->next) leaf->next->prev = right;
+                else _last = right;
+                leaf->next = right;
+
+                if (!(pos == N && right->next == nullptr))
+                {
+                    const size_t half = N / 2;
+                    leaf_relocate(right, 0, leaf, half, N - half);
+                }
+
+                leaf_type* target = leaf;
+                if (pos > leaf->count || leaf->count == N)
+                {
+                    target = right;
+                    pos -= leaf->count;
+                }
+                leaf_emplace(target, pos, std::move(key), std::forward<Vals>(vals)...);
+                ++_size;
+
+                insert_into_parent(path, path.depth, Key(right->keys[0]), right);
+                return iterator(target, pos);
+            }
+
+            // 从已排好序且 key 唯一的区间批量建树，O(n)：
+            // 先把元素平均分到若干叶子，再逐层往上建内部节点，每个节点都接近满载
+            template<typename InputIterator>
+            void bulk_load(InputIterator first, InputIterator last, size_t n)
+            {
+                assert(empty());
+                if (n == 0) return;
+
+                tiny::vector<node_base*> level;
+                const size_t leaves = (n + N - 1) / N;
+                leaf_type* prev = nullptr;
+                for (size_t i = 0; i < leaves; ++i)
+                {
+                    leaf_type* leaf = new leaf_type;
+                    const size_t cnt = n / leaves + (i < n % leaves ? 1 : 0);
+                    for (size_t j = 0; j < cnt; ++j, ++first)
+                    {
+                        construct_from(leaf, j, *first);
+                        ++leaf->count;
+                    }
+                    leaf->prev = prev;
+                    if (prev) prev->next = leaf;
+                    else _first = leaf;
+                    prev = leaf;
+                    level.push_back(leaf);
+                }
+                _last = prev;
+                _size = n;
+                assert(first == last);
+                (void)last;
+
+                int height = 0;
+                while (level.size() > 1)
+                {
+                    tiny::vector<node_base*> parents;
+                    const size_t m = level.size();
+                    const size_t count = (m + N) / (N + 1);
+                    size_t c = 0;
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        internal_type* node = new internal_type;
+                        const size_t children = m / count + (i < m % count ? 1 : 0);
+                        for (size_t j = 0; j < children; ++j, ++c)
+                        {
+                            if (j > 0) new (node->keys + j - 1) Key(min_key(level[c]));
+                            node->children[j] = level[c];
+                        }
+                        node->count = static_cast<uint16_t>(children - 1);
+                        parents.push_back(node);
+                    }
+                    level.swap(parents);
+                    ++height;
+                }
+                _root = level[0];
+                _height = height;
+            }
+
+            Compare _comp;
+
+        private:
+            // 统计 keys[0, n) 中小于 key（Lower）/ 不大于 key 的个数
+            template<bool Lower, typename K>
+            size_t search(const Key* keys, size_t n, const K& key) const
+            {
+                if constexpr (btree_simd_search_v<Key, Compare, K>)
+                {
+                    return simd_count_less<Lower>(keys, n, key);
+                }
+                else if constexpr (Lower)
+                {
+                    return branchless_lower_bound(keys, n, key, _comp);
+                }
+                else
+                {
+                    return branchless_upper_bound(keys, n, key, _comp);
+                }
+            }
+
+            // 从根走到 key 所在的叶子；path 不为空时记录路径
+            template<typename K>
+            leaf_type* descend(const K& key, path_type* path) const
+            {
+                node_base* node = _root;
+                int depth = 0;
+                while (!node->is_leaf)
+                {
+                    internal_type* in = static_cast<internal_type*>(node);
+                    size_t i = search<false>(in->keys, in->count, key);
+                    if (path)
+                    {
+                        path->nodes[depth] = in;
+                        path->index[depth] = i;
+                    }
+                    ++depth;
+                    node = in->children[i];
+                }
+                if (path) path->depth = depth;
+                return static_cast<leaf_type*>(node);
+            }
+
+            static const Key& min_key(node_base* node)
+            {
+                while (!node->is_leaf) node = static_cast<internal_type*>(node)->children[0];
+                return static_cast<leaf_type*>(node)->keys[0];
+            }
+
+            template<typename Src>
+            static void construct_from(leaf_type* leaf, size_t i, Src&& src)
+            {
+                if constexpr (kIsMap)
+                {
+                    new (leaf->keys + i) Key(src.first);
+                    new (leaf->values.vals + i) Mapped(src.second);
+                }
+                else
+                {
+                    new (leaf->keys + i) Key(src);
+                }
+            }
+
+            template<typename K, typename... Args>
+            static void leaf_emplace(leaf_type* leaf, size_t pos, K&& key, Args&&... args)
+            {
+                if constexpr (kIsMap)
+                {
+                    slots_emplace(leaf->values.vals, leaf->count, pos, std::forward<Args>(args)...);
+                }
+                slots_emplace(leaf->keys, leaf->count, pos, std::forward<K>(key));
+                ++leaf->count;
+            }
+
+            static void leaf_erase(leaf_type* leaf, size_t pos)
+            {
+                slots_erase(leaf->keys, leaf->count, pos);
+                if constexpr (kIsMap) slots_erase(leaf->values.vals, leaf->count, pos);
+                --leaf->count;
+            }
+
+            // 把 src[from, from + n) 搬到 dst 末尾（at == dst->count）
+            static void leaf_relocate(leaf_type* dst, size_t at, leaf_type* src, size_t from, size_t n)
+            {
+                assert(at == dst->count && from + n == src->count);
+                slots_relocate(dst->keys + at, src->keys + from, n);
+                if constexpr (kIsMap) slots_relocate(dst->values.vals + at, src->values.vals + from, n);
+                dst->count = static_cast<uint16_t>(dst->count + n);
+                src->count = static_cast<uint16_t>(src->count - n);
+            }
+
+            // 在内部节点的第 i 个 key 处插入 sep，child 成为第 i + 1 个孩子
+            static void internal_insert(internal_type* node, size_t i, Key&& sep, node_base* child)
+            {
+                slots_emplace(node->keys, node->count, i, std::move(sep));
+                std::memmove(node->children + i + 2, node->children + i + 1,
+                    (node->count - i) * sizeof(node_base*));
+                node->children[i + 1] = child;
+                ++node->count;
+            }
+
+            // 删除第 i 个 key 与第 c 个孩子（c 为 i 或 i + 1）
+            static void internal_erase(internal_type* node, size_t i, size_t c)
+            {
+                slots_erase(node->keys, node->count, i);
+                std::memmove(node->children + c, node->children + c + 1,
+                    (node->count - c) * sizeof(node_base*));
+                --node->count;
+            }
+
+            // level 层的节点分裂出了 right，把分隔 key 插到父节点；父节点满了就继续分裂
+            void insert_into_parent(path_type& path, int level, Key&& sep, node_base* right)
+            {
+                if (level == 0)
+                {
+                    internal_type* root = new internal_type;
+                    new (root->keys) Key(std::move(sep));
+                    root->children[0] = _root;
+                    root->children[1] = right;
+                    root->count = 1;
+                    _root = root;
+                    ++_height;
+                    return;
+                }
+
+                internal_type* parent = path.nodes[level - 1];
+                const size_t ci = path.index[level - 1];
+                if (parent->count < N)
+                {
+                    internal_insert(parent, ci, std::move(sep), right);
+                    return;
+                }
+
+                // 父节点满了：中间的 key 上移，右半部分搬到新节点，再把 sep 插进对应的一半
+                const size_t mid = N / 2;
+                internal_type* sibling = new internal_type;
+                Key promote(std::move(parent->keys[mid]));
+                slots_relocate(sibling->keys, parent->keys + mid + 1, N - mid - 1);
+                parent->keys[mid].~Key();
+                std::memcpy(sibling->children, parent->children + mid + 1, (N - mid) * sizeof(node_base*));
+                sibling->count = static_cast<uint16_t>(N - mid - 1);
+                parent->count = static_cast<uint16_t>(mid);
+
+                if (ci <= mid) internal_insert(parent, ci, std::move(sep), right);
+                else internal_insert(sibling, ci - mid - 1, std::move(sep), right);
+
+                insert_into_parent(path, level - 1, std::move(promote), sibling);
+            }
+
+            // 删除叶子中的第 i 个元素；发生了借位或合并（元素可能搬家）时返回 true
+            bool erase_at(path_type& path, leaf_type* leaf, size_t i)
+            {
+                leaf_erase(leaf, i);
+                --_size;
+
+                if (leaf == _root)
+                {
+                    if (leaf->count == 0)
+                    {
+                        delete leaf;
+                        _root = nullptr;
+                        _first = _last = nullptr;
+                    }
+                    return false;
+                }
+                if (leaf->count >= kMinLeaf) return false;
+
+                rebalance_leaf(path, leaf);
+                return true;
+            }
+
+            void rebalance_leaf(path_type& path, leaf_type* leaf)
+            {
+                const int level = path.depth;
+                internal_type* parent = path.nodes[level - 1];
+                const size_t ci = path.index[level - 1];
+
+                leaf_type* left = ci > 0 ? static_cast<leaf_type*>(parent->children[ci - 1]) : nullptr;
+                leaf_type* right = ci < parent->count ? static_cast<leaf_type*>(parent->children[ci + 1]) : nullptr;
+
+                // 先尝试从兄弟借一个
+                if (left && left->count > kMinLeaf)
+                {
+                    const size_t last = left->count - 1;
+                    if constexpr (kIsMap)
+                        leaf_emplace(leaf, 0, std::move(left->keys[last]), std::move(left->values.vals[last]));
+                    else
+                        leaf_emplace(leaf, 0, std::move(left->keys[last]));
+                    leaf_erase(left, last);
+                    parent->keys[ci - 1] = leaf->keys[0];
+                    return;
+                }
+                if (right && right->count > kMinLeaf)
+                {
+                    if constexpr (kIsMap)
+                        leaf_emplace(leaf, leaf->count, std::move(right->keys[0]), std::move(right->values.vals[0]));
+                    else
+                        leaf_emplace(leaf, leaf->count, std::move(right->keys[0]));
+                    leaf_erase(right, 0);
+                    parent->keys[ci] = right->keys[0];
+                    return;
+                }
+
+                // 兄弟也不富余：合并成一个叶子，父节点少一个 key
+                if (left)
+                {
+                    merge_leaf(left, leaf);
+                    internal_erase(parent, ci - 1, ci);
+                }
+                else
+                {
+                    merge_leaf(leaf, right);
+                    internal_erase(parent, ci, ci + 1);
+                }
+                rebalance_internal(path, level - 1);
+            }
+
+            // right 并入 left 并释放
+            void merge_leaf(leaf_type* left, leaf_type* right)
+            {
+                leaf_relocate(left, left->count, right, 0, right->count);
+                left->next = right->next;
+                if (right->next) right->next->prev = left;
+                else _last = left;
+                delete right;
+            }
+
+            void rebalance_internal(path_type& path, int level)
+            {
+                internal_type* node = path.nodes[level];
+
+                if (level == 0)
+                {
+                    // 根只剩一个孩子时树高减一
+                    if (node->count == 0)
+                    {
+                        _root = node->children[0];
+                        --_height;
+                        delete node;
+                    }
+                    return;
+                }
+                if (node->count >= kMinInternal) return;
+
+                internal_type* parent = path.nodes[level - 1];
+                const size_t ci = path.index[level - 1];
+                internal_type* left = ci > 0 ? static_cast<internal_type*>(parent->children[ci - 1]) : nullptr;
+                internal_type* right = ci < parent->count ? static_cast<internal_type*>(parent->children[ci + 1]) : nullptr;
+
+                if (left && left->count > kMinInternal)
+                {
+                    // 右旋：父节点的分隔 key 下移，左兄弟最后的 key 上移
+                    slots_emplace(node->keys, node->count, 0, std::move(parent->keys[ci - 1]));
+                    std::memmove(node->children + 1, node->children, (node->count + 1) * sizeof(node_base*));
+                    node->children[0] = left->children[left->count];
+                    ++node->count;
+                    parent->keys[ci - 1] = std::move(left->keys[left->count - 1]);
+                    left->keys[left->count - 1].~Key();
+                    --left->count;
+                    return;
+                }
+                if (right && right->count > kMinInternal)
+                {
+                    // 左旋
+                    new (node->keys + node->count) Key(std::move(parent->keys[ci]));
+                    node->children[node->count + 1] = right->children[0];
+                    ++node->count;
+                    parent->keys[ci] = std::move(right->keys[0]);
+                    slots_erase(right->keys, right->count, 0);
+                    std::memmove(right->children, right->children + 1, right->count * sizeof(node_base*));
+                    --right->count;
+                    return;
+                }
+
+                if (left)
+                {
+                    merge_internal(left, std::move(parent->keys[ci - 1]), node);
+                    internal_erase(parent, ci - 1, ci);
+                }
+                else
+                {
+                    merge_internal(node, std::move(parent->keys[ci]), right);
+                    internal_erase(parent, ci, ci + 1);
+                }
+                rebalance_internal(path, level - 1);
+            }
+
+            // left + 分隔 key + right 合成一个节点，释放 right
+            static void merge_internal(internal_type* left, Key&& sep, internal_type* right)
+            {
+                new (left->keys + left->count) Key(std::move(sep));
+                slots_relocate(left->keys + left->count + 1, right->keys, right->count);
+                std::memcpy(left->children + left->count + 1, right->children, (right->count + 1) * sizeof(node_base*));
+                left->count = static_cast<uint16_t>(left->count + 1 + right->count);
+                delete right;
+            }
+
+            void destroy(node_base* node)
+            {
+                if (node->is_leaf)
+                {
+                    leaf_type* leaf = static_cast<leaf_type*>(node);
+                    slots_destroy(leaf->keys, leaf->count);
+                    if constexpr (kIsMap) slots_destroy(leaf->values.vals, leaf->count);
+                    delete leaf;
+                    return;
+                }
+                internal_type* in = static_cast<internal_type*>(node);
+                for (size_t i = 0; i <= in->count; ++i) destroy(in->children[i]);
+                slots_destroy(in->keys, in->count);
+                delete in;
+            }
+
+        private:
+            node_base* _root = nullptr;
+            leaf_type* _first = nullptr;   // 最左的叶子，begin()
+            leaf_type* _last = nullptr;    // 最右的叶子，end()
+            size_t _size = 0;
+            int _height = 0;               // 内部节点的层数
+        };
+    }
+}
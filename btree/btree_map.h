@@ -0,0 +1,185 @@
+#pragma once
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "btree.h"
+
+namespace tiny {
+
+    // B+ 树实现的有序映射，接口与 std::map 基本一致
+    // 与 std::map 的差别：
+    //   解引用迭代器得到 pair<const Key&, T&>（key 与 value 分开存放），用法同 std::map
+    //   插入/删除会移动元素，之前的迭代器与引用全部失效
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    class btree_map : public detail::btree<Key, T, Compare>
+    {
+        using base = detail::btree<Key, T, Compare>;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using iterator = typename base::iterator;
+        using const_iterator = typename base::const_iterator;
+
+        btree_map() = default;
+
+        explicit btree_map(const Compare& comp)
+            : base(comp)
+        {}
+
+        // 输入已经按 key 严格递增时直接批量建树 O(n)，否则逐个插入
+        template<typename InputIterator>
+        btree_map(InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : base(comp)
+        {
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                typename std::iterator_traits<InputIterator>::iterator_category>)
+            {
+                auto less = [this](const auto& a, const auto& b) { return this->_comp(a.first, b.first); };
+                if (std::adjacent_find(first, last, [&](const auto& a, const auto& b) { return !less(a, b); }) == last)
+                {
+                    this->bulk_load(first, last, static_cast<size_t>(std::distance(first, last)));
+                    return;
+                }
+            }
+            insert(first, last);
+        }
+
+        // 调用方保证区间按 key 严格递增
+        template<typename InputIterator>
+        btree_map(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : base(comp)
+        {
+            this->bulk_load(first, last, static_cast<size_t>(std::distance(first, last)));
+        }
+
+        btree_map(std::initializer_list<value_type> il, const Compare& comp = Compare())
+            : btree_map(il.begin(), il.end(), comp)
+        {}
+
+        // ---------- 插入 ----------
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            return this->emplace_unique(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            return this->emplace_unique(std::move(key), std::forward<Args>(args)...);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& kv)
+        {
+            return this->emplace_unique(kv.first, kv.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& kv)
+        {
+            return this->emplace_unique(std::move(kv.first), std::move(kv.second));
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first)
+            {
+                auto&& kv = *first;
+                this->emplace_unique(kv.first, kv.second);
+            }
+        }
+
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+        {
+            auto result = this->emplace_unique(key, std::forward<M>(obj));
+            if (!result.second) result.first->second = std::forward<M>(obj);
+            return result;
+        }
+
+        T& operator[](const Key& key)
+        {
+            return this->emplace_unique(key).first->second;
+        }
+
+        T& operator[](Key&& key)
+        {
+            return this->emplace_unique(std::move(key)).first->second;
+        }
+
+        T& at(const Key& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end()) throw std::out_of_range("tiny::btree_map::at");
+            return it->second;
+        }
+
+        const T& at(const Key& key) const
+        {
+            const_iterator it = this->find(key);
+            if (it == this->end()) throw std::out_of_range("tiny::btree_map::at");
+            return it->second;
+        }
+
+        // ---------- 查找 ----------
+
+        iterator find(const Key& key) { return base::find(key); }
+        const_iterator find(const Key& key) const { return base::find(key); }
+        iterator lower_bound(const Key& key) { return base::lower_bound(key); }
+        const_iterator lower_bound(const Key& key) const { return base::lower_bound(key); }
+        iterator upper_bound(const Key& key) { return base::upper_bound(key); }
+        const_iterator upper_bound(const Key& key) const { return base::upper_bound(key); }
+        bool contains(const Key& key) const { return base::contains(key); }
+        size_t count(const Key& key) const { return base::count(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        iterator find(const K& key) { return base::find(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator find(const K& key) const { return base::find(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        iterator lower_bound(const K& key) { return base::lower_bound(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator lower_bound(const K& key) const { return base::lower_bound(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        iterator upper_bound(const K& key) { return base::upper_bound(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator upper_bound(const K& key) const { return base::upper_bound(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        bool contains(const K& key) const { return base::contains(key); }
+
+        // ---------- 删除 ----------
+
+        using base::erase;
+
+        size_t erase(const Key& key)
+        {
+            return this->erase_key(key);
+        }
+    };
+
+    template<typename Key, typename T, typename Compare>
+    bool operator==(const btree_map<Key, T, Compare>& a, const btree_map<Key, T, Compare>& b)
+    {
+        if (a.size() != b.size()) return false;
+        auto it = b.begin();
+        for (auto kv : a)
+        {
+            auto other = *it;
+            if (!(kv.first == other.first) || !(kv.second == other.second)) return false;
+            ++it;
+        }
+        return true;
+    }
+}
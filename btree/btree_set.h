@@ -0,0 +1,115 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+#include "btree.h"
+
+namespace tiny {
+
+    // B+ 树实现的有序集合，接口与 std::set 基本一致
+    // 插入/删除会移动元素，之前的迭代器与引用全部失效
+    template<typename Key, typename Compare = std::less<Key>>
+    class btree_set : public detail::btree<Key, void, Compare>
+    {
+        using base = detail::btree<Key, void, Compare>;
+
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using iterator = typename base::const_iterator;
+        using const_iterator = typename base::const_iterator;
+
+        btree_set() = default;
+
+        explicit btree_set(const Compare& comp)
+            : base(comp)
+        {}
+
+        // 输入已经严格递增时直接批量建树 O(n)，否则逐个插入
+        template<typename InputIterator>
+        btree_set(InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : base(comp)
+        {
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                typename std::iterator_traits<InputIterator>::iterator_category>)
+            {
+                if (std::adjacent_find(first, last, [this](const Key& a, const Key& b) { return !this->_comp(a, b); }) == last)
+                {
+                    this->bulk_load(first, last, static_cast<size_t>(std::distance(first, last)));
+                    return;
+                }
+            }
+            insert(first, last);
+        }
+
+        // 调用方保证区间严格递增
+        template<typename InputIterator>
+        btree_set(sorted_unique_t, InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : base(comp)
+        {
+            this->bulk_load(first, last, static_cast<size_t>(std::distance(first, last)));
+        }
+
+        btree_set(std::initializer_list<Key> il, const Compare& comp = Compare())
+            : btree_set(il.begin(), il.end(), comp)
+        {}
+
+        const_iterator begin() const { return base::begin(); }
+        const_iterator end() const { return base::end(); }
+
+        std::pair<const_iterator, bool> insert(const Key& key)
+        {
+            return this->emplace_unique(key);
+        }
+
+        std::pair<const_iterator, bool> insert(Key&& key)
+        {
+            return this->emplace_unique(std::move(key));
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) this->emplace_unique(*first);
+        }
+
+        template<typename... Args>
+        std::pair<const_iterator, bool> emplace(Args&&... args)
+        {
+            return this->emplace_unique(Key(std::forward<Args>(args)...));
+        }
+
+        const_iterator find(const Key& key) const { return base::find(key); }
+        const_iterator lower_bound(const Key& key) const { return base::lower_bound(key); }
+        const_iterator upper_bound(const Key& key) const { return base::upper_bound(key); }
+        bool contains(const Key& key) const { return base::contains(key); }
+        size_t count(const Key& key) const { return base::count(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator find(const K& key) const { return base::find(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator lower_bound(const K& key) const { return base::lower_bound(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator upper_bound(const K& key) const { return base::upper_bound(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        bool contains(const K& key) const { return base::contains(key); }
+
+        using base::erase;
+
+        size_t erase(const Key& key)
+        {
+            return this->erase_key(key);
+        }
+    };
+
+    template<typename Key, typename Compare>
+    bool operator==(const btree_set<Key, Compare>& a, const btree_set<Key, Compare>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+}
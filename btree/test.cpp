@@ -0,0 +1,215 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <map>
+#include <set>
+#include <vector>
+#include <random>
+#include <cassert>
+#include "btree_map.h"
+#include "btree_set.h"
+
+// 1. 基本操作
+void test_btree_map() {
+    tiny::btree_map<int, std::string> m;
+    assert(m.empty() && m.begin() == m.end() && m.find(1) == m.end());
+
+    m[3] = "three";
+    m[1] = "one";
+    m.try_emplace(2, "two");
+    m.insert({5, "five"});
+    assert(m.size() == 4);
+    assert(!m.try_emplace(1, "uno").second && m.at(1) == "one");
+    m.insert_or_assign(1, "uno");
+    assert(m.at(1) == "uno");
+    m.find(2)->second = "deux";
+    assert(m[2] == "deux");
+
+    int expected[] = {1, 2, 3, 5};
+    int i = 0;
+    for (auto kv : m) assert(kv.first == expected[i++]);
+    assert(i == 4);
+
+    assert(m.lower_bound(4)->first == 5);
+    assert(m.upper_bound(3)->first == 5);
+    assert(m.upper_bound(5) == m.end());
+    assert((--m.end())->first == 5);
+
+    bool thrown = false;
+    try { m.at(4); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    assert(m.erase(3) == 1 && m.erase(3) == 0);
+    auto next = m.erase(m.begin());
+    assert(next->first == 2 && m.size() == 2);
+
+    tiny::btree_map<int, std::string> copy(m);
+    assert(copy == m);
+    tiny::btree_map<int, std::string> moved(std::move(copy));
+    assert(moved == m && copy.empty());
+}
+
+// 2. 大量数据：顺序插入、区间遍历与区间删除
+void test_range() {
+    tiny::btree_map<long long, long long> m;
+    const long long n = 100000;
+    for (long long i = 0; i < n; ++i) m.try_emplace(i * 2, i);
+    assert(m.size() == size_t(n));
+    assert(m.height() <= 5);
+
+    // [1000, 2000) 内的偶数
+    long long count = 0;
+    for (auto it = m.lower_bound(1000); it != m.end() && it->first < 2000; ++it) {
+        assert(it->first == 1000 + count * 2);
+        ++count;
+    }
+    assert(count == 500);
+
+    // 反向遍历
+    auto it = m.end();
+    for (long long k = n - 1; k >= n - 100; --k) {
+        --it;
+        assert(it->first == k * 2 && it->second == k);
+    }
+
+    auto last = m.erase(m.lower_bound(1000), m.lower_bound(2000));
+    assert(last->first == 2000 && m.size() == size_t(n - 500));
+    assert(!m.contains(1500) && m.contains(998) && m.contains(2000));
+}
+
+// 3. 从有序输入批量建树
+void test_bulk_load() {
+    std::vector<std::pair<int, int>> sorted;
+    for (int i = 0; i < 10000; ++i) sorted.push_back({i * 3, i});
+
+    tiny::btree_map<int, int> m(tiny::sorted_unique, sorted.begin(), sorted.end());
+    assert(m.size() == 10000);
+    for (int i = 0; i < 10000; ++i) assert(m.at(i * 3) == i);
+
+    // 普通区间构造会自动识别有序输入；批量建好的树可以继续增删
+    tiny::btree_map<int, int> auto_bulk(sorted.begin(), sorted.end());
+    assert(auto_bulk == m);
+    for (int i = 0; i < 10000; i += 2) auto_bulk.erase(i * 3);
+    for (int i = 0; i < 10000; ++i) auto_bulk.try_emplace(i * 3 + 1, -i);
+    assert(auto_bulk.size() == 15000);
+    assert(auto_bulk.at(4) == -1 && auto_bulk.at(3) == 1 && !auto_bulk.contains(0));
+
+    // 无序输入退化为逐个插入，重复的 key 保留第一个
+    std::vector<int> keys = {5, 3, 9, 3, 1};
+    tiny::btree_set<int> s(keys.begin(), keys.end());
+    assert(s.size() == 4 && *s.begin() == 1);
+}
+
+// 4. btree_set 与字符串 key（非 SIMD 路径）
+void test_btree_set() {
+    tiny::btree_set<std::string, std::less<>> s = {"pear", "apple", "fig"};
+    assert(s.size() == 3 && *s.begin() == "apple");
+    assert(s.insert("kiwi").second && !s.insert("fig").second);
+    assert(s.contains(std::string_view("kiwi")));
+    assert(*s.lower_bound(std::string_view("b")) == "fig");
+    assert(s.erase("apple") == 1 && s.size() == 3);
+
+    tiny::btree_set<unsigned> us;
+    for (unsigned i = 0; i < 1000; ++i) us.insert(0xFFFFFFFFu - i * 7);
+    assert(*us.begin() == 0xFFFFFFFFu - 999 * 7);
+    assert(*us.lower_bound(0xFFFFFFF0u) == 0xFFFFFFF1u);
+}
+
+// 5. 随机增删查，与 std::map / std::set 对比
+template<typename Key>
+Key make_key(int x) {
+    if constexpr (std::is_same_v<Key, std::string>) return std::to_string(x);
+    else return Key(x);
+}
+
+template<typename Key>
+void random_against_std(unsigned seed) {
+    std::mt19937 rng(seed);
+    tiny::btree_map<Key, int> m;
+    std::map<Key, int> ref;
+    tiny::btree_set<Key> s;
+    std::set<Key> sref;
+
+    for (int step = 0; step < 200000; ++step) {
+        Key key = make_key<Key>(int(rng() % 20000) - 5000);
+        switch (rng() % 6) {
+        case 0:
+        case 1:
+            m[key] = step;
+            ref[key] = step;
+            s.insert(key);
+            sref.insert(key);
+            break;
+        case 2:
+        case 3:
+            assert(m.erase(key) == ref.erase(key));
+            assert(s.erase(key) == sref.erase(key));
+            break;
+        case 4: {
+            auto it = m.lower_bound(key);
+            auto rit = ref.lower_bound(key);
+            assert((it == m.end()) == (rit == ref.end()));
+            if (rit != ref.end()) assert(it->first == rit->first && it->second == rit->second);
+            auto sit = s.upper_bound(key);
+            auto srit = sref.upper_bound(key);
+            assert((sit == s.end()) == (srit == sref.end()));
+            if (srit != sref.end()) assert(*sit == *srit);
+            break;
+        }
+        default: {
+            // 按迭代器删除，返回值应当指向后继
+            auto it = m.lower_bound(key);
+            auto rit = ref.lower_bound(key);
+            if (rit != ref.end()) {
+                it = m.erase(it);
+                rit = ref.erase(rit);
+                assert((it == m.end()) == (rit == ref.end()));
+                if (rit != ref.end()) assert(it->first == rit->first);
+            }
+            break;
+        }
+        }
+        assert(m.size() == ref.size() && s.size() == sref.size());
+    }
+
+    auto rit = ref.begin();
+    for (auto kv : m) {
+        assert(kv.first == rit->first && kv.second == rit->second);
+        ++rit;
+    }
+    assert(std::equal(s.begin(), s.end(), sref.begin(), sref.end()));
+
+    while (!m.empty()) m.erase(m.begin());
+    assert(m.begin() == m.end());
+}
+
+// 6. 参数引用树内元素：插入把叶子对半分裂时，被引用的元素可能已经搬到新叶子
+void test_aliasing_insert() {
+    // 叶子里有 n 个 key，在最前面插入、参数引用最后一个；n 等于叶子容量时会从中间分裂
+    for (int n = 1; n <= 64; ++n) {
+        tiny::btree_map<int, std::string> m;
+        for (int i = 0; i < n; ++i) m.try_emplace(i * 10, std::string(40, char('a' + i % 26)));
+        assert(m.try_emplace(5, m.at((n - 1) * 10)).second);
+        assert(m.size() == size_t(n) + 1 && m.at(5) == std::string(40, char('a' + (n - 1) % 26)));
+    }
+
+    // key 引用树内的值：每个值都是一个还不存在的新 key
+    tiny::btree_map<std::string, std::string> chain;
+    chain["k0"] = "k1";
+    for (int i = 1; i < 500; ++i) chain[chain.at("k" + std::to_string(i - 1))] = "k" + std::to_string(i + 1);
+    assert(chain.size() == 500);
+    for (int i = 0; i < 500; ++i) assert(chain.at("k" + std::to_string(i)) == "k" + std::to_string(i + 1));
+}
+
+int main() {
+    test_btree_map();
+    test_range();
+    test_bulk_load();
+    test_btree_set();
+    random_against_std<int>(1);
+    random_against_std<long long>(2);
+    random_against_std<std::string>(3);
+    test_aliasing_insert();
+    std::cout << "all btree tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,250 @@
+#pragma once
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "executor.h"
+#include "../queue/queue.h"
+#include "../list/intrusive_list.h"
+
+namespace tiny {
+
+    // 协程 channel：co_await ch.send(x) / co_await ch.recv() 在满/空时挂起协程而不是阻塞线程
+    //
+    //   channel<int> ch(16);                 有界，最多缓存 16 个元素
+    //   channel<int> ch;                     无界，send 永远不挂起
+    //   bool ok = co_await ch.send(42);      channel 已关闭时返回 false
+    //   std::optional<int> v = co_await ch.recv();   关闭且取空后返回 nullopt
+    //
+    // 缓冲区是 queue 适配器；等待中的发送者/接收者就是各自的 awaiter 对象，
+    // 它们活在协程帧里，用 list_hook 挂进侵入式链表，挂起不需要额外分配
+    //
+    // 所有状态由一把互斥锁保护，可以被多个线程上的协程同时使用。
+    // 被唤醒的协程投递回它自己的执行器（task/spawn 记录在 promise 里），
+    // 投递总是在释放锁之后进行；不在执行器上的协程就地 resume
+    template<typename T>
+    class channel
+    {
+    public:
+        static constexpr size_t unbounded = SIZE_MAX;
+
+        channel() = default;
+
+        explicit channel(size_t capacity) : _capacity(capacity)
+        {
+            assert(capacity > 0);
+        }
+
+        channel(const channel&) = delete;
+        channel& operator=(const channel&) = delete;
+
+        // 析构时不能再有挂起在本 channel 上的协程
+        ~channel()
+        {
+            assert(_senders.empty() && _receivers.empty());
+        }
+
+        class send_awaiter
+        {
+        public:
+            bool await_ready() const noexcept { return false; }
+
+            // 返回 false 表示不需要挂起（直接交给了接收者、放进了缓冲区或 channel 已关闭）
+            template<typename Promise>
+            bool await_suspend(std::coroutine_handle<Promise> h)
+            {
+                return _ch->suspend_send_(*this, h, detail::executor_of(h));
+            }
+
+            bool await_resume() const noexcept { return _ok; }
+
+        private:
+            friend class channel;
+
+            send_awaiter(channel* ch, T&& value) : _ch(ch), _value(std::move(value)) {}
+
+            channel* _ch;
+            T _value;
+            bool _ok = false;
+            std::coroutine_handle<> _handle;
+            executor* _executor = nullptr;
+            list_hook _hook;
+        };
+
+        class recv_awaiter
+        {
+        public:
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            bool await_suspend(std::coroutine_handle<Promise> h)
+            {
+                return _ch->suspend_recv_(*this, h, detail::executor_of(h));
+            }
+
+            std::optional<T> await_resume() { return std::move(_value); }
+
+        private:
+            friend class channel;
+
+            explicit recv_awaiter(channel* ch) : _ch(ch) {}
+
+            channel* _ch;
+            std::optional<T> _value;
+            std::coroutine_handle<> _handle;
+            executor* _executor = nullptr;
+            list_hook _hook;
+        };
+
+        // awaiter 必须在同一个完整表达式里 co_await，不要保存下来
+        [[nodiscard]] send_awaiter send(T value) { return send_awaiter(this, std::move(value)); }
+        [[nodiscard]] recv_awaiter recv() { return recv_awaiter(this); }
+
+        // 非挂起版本：满或已关闭时返回 false
+        bool try_send(T value)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_closed) return false;
+            if (!_receivers.empty())
+            {
+                hand_off_(lock, std::move(value));
+                return true;
+            }
+            if (_buffer.size() >= _capacity) return false;
+            _buffer.push(std::move(value));
+            return true;
+        }
+
+        // 空时返回 nullopt
+        std::optional<T> try_recv()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_buffer.empty()) return std::nullopt;
+            std::optional<T> value(std::move(_buffer.front()));
+            _buffer.pop();
+            refill_(lock);
+            return value;
+        }
+
+        // 关闭后 send 全部失败；缓冲区里剩下的元素仍然可以 recv，取空后 recv 返回 nullopt。
+        // 正在等待的发送者得到 false，正在等待的接收者得到 nullopt
+        void close()
+        {
+            intrusive_list<send_awaiter, &send_awaiter::_hook> senders;
+            intrusive_list<recv_awaiter, &recv_awaiter::_hook> receivers;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_closed) return;
+                _closed = true;
+                senders.splice(senders.end(), _senders);
+                receivers.splice(receivers.end(), _receivers);
+            }
+            // 先摘链再唤醒：唤醒后对方可能立刻在别的线程上销毁 awaiter
+            while (!senders.empty())
+            {
+                send_awaiter& s = senders.front();
+                senders.pop_front();
+                detail::wake(s._handle, s._executor);
+            }
+            while (!receivers.empty())
+            {
+                recv_awaiter& r = receivers.front();
+                receivers.pop_front();
+                detail::wake(r._handle, r._executor);
+            }
+        }
+
+        bool closed() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _closed;
+        }
+
+        // 缓冲区中的元素个数（不含挂起的发送者手里的元素）
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _buffer.size();
+        }
+
+        size_t capacity() const { return _capacity; }
+
+    private:
+        bool suspend_send_(send_awaiter& s, std::coroutine_handle<> h, executor* ex)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_closed) return false;
+            if (!_receivers.empty())
+            {
+                hand_off_(lock, std::move(s._value));
+                s._ok = true;
+                return false;
+            }
+            if (_buffer.size() < _capacity)
+            {
+                _buffer.push(std::move(s._value));
+                s._ok = true;
+                return false;
+            }
+            // 挂上链表并解锁之后就不能再碰 s：它可能已经在别的线程上被唤醒并销毁
+            s._handle = h;
+            s._executor = ex;
+            _senders.push_back(s);
+            return true;
+        }
+
+        bool suspend_recv_(recv_awaiter& r, std::coroutine_handle<> h, executor* ex)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_buffer.empty())
+            {
+                r._value.emplace(std::move(_buffer.front()));
+                _buffer.pop();
+                refill_(lock);
+                return false;
+            }
+            if (_closed) return false;
+            r._handle = h;
+            r._executor = ex;
+            _receivers.push_back(r);
+            return true;
+        }
+
+        // 有接收者在等时缓冲区一定为空，元素直接交给最早的接收者，然后解锁唤醒它
+        void hand_off_(std::unique_lock<std::mutex>& lock, T&& value)
+        {
+            recv_awaiter& r = _receivers.front();
+            _receivers.pop_front();
+            r._value.emplace(std::move(value));
+            std::coroutine_handle<> h = r._handle;
+            executor* ex = r._executor;
+            lock.unlock();
+            detail::wake(h, ex);
+        }
+
+        // 缓冲区腾出一个位置：把最早挂起的发送者的元素移进来，然后解锁唤醒它
+        void refill_(std::unique_lock<std::mutex>& lock)
+        {
+            if (_senders.empty()) return;
+            send_awaiter& s = _senders.front();
+            _senders.pop_front();
+            _buffer.push(std::move(s._value));
+            s._ok = true;
+            std::coroutine_handle<> h = s._handle;
+            executor* ex = s._executor;
+            lock.unlock();
+            detail::wake(h, ex);
+        }
+
+    private:
+        mutable std::mutex _mutex;
+        queue<T> _buffer;
+        size_t _capacity = unbounded;
+        bool _closed = false;
+        intrusive_list<send_awaiter, &send_awaiter::_hook> _senders;
+        intrusive_list<recv_awaiter, &recv_awaiter::_hook> _receivers;
+    };
+}
@@ -0,0 +1,361 @@
+#pragma once
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <variant>
+#include "../queue/queue.h"
+#include "../vector/vector.h"
+
+namespace tiny {
+
+    class executor;
+
+    namespace detail {
+        struct schedule_awaiter
+        {
+            executor* ex;
+
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            void await_suspend(std::coroutine_handle<Promise> h);
+
+            void await_resume() const noexcept {}
+        };
+    }
+
+    // 执行器：接收可以继续运行的协程句柄，在某个线程上 resume 它
+    class executor
+    {
+    public:
+        virtual ~executor() = default;
+
+        virtual void post(std::coroutine_handle<> h) = 0;
+
+        // co_await ex.schedule()：把当前协程切换到这个执行器上继续运行
+        detail::schedule_awaiter schedule();
+    };
+
+    namespace detail {
+        // 协程的 promise 里记着它所在的执行器；挂起后被唤醒时要回到这个执行器上
+        template<typename Promise>
+        executor* executor_of(std::coroutine_handle<Promise> h)
+        {
+            if constexpr (requires { h.promise().ex; }) return h.promise().ex;
+            else return nullptr;
+        }
+
+        // 唤醒一个挂起的协程：有执行器就投递过去，否则就地 resume
+        inline void wake(std::coroutine_handle<> h, executor* ex)
+        {
+            if (ex) ex->post(h);
+            else h.resume();
+        }
+
+        template<typename Promise>
+        void schedule_awaiter::await_suspend(std::coroutine_handle<Promise> h)
+        {
+            if constexpr (requires { h.promise().ex; }) h.promise().ex = ex;
+            ex->post(h);
+        }
+    }
+
+    inline detail::schedule_awaiter executor::schedule()
+    {
+        return { this };
+    }
+
+    namespace detail {
+        // 结束时对称转移回等待者，不增加调用栈深度
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept
+            {
+                std::coroutine_handle<> next = h.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        // co_await 一个 task：记下等待者，让子任务继承它的执行器，然后转移过去
+        template<typename Promise>
+        struct task_awaiter_base
+        {
+            std::coroutine_handle<Promise> h;
+
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Caller>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Caller> caller) noexcept
+            {
+                h.promise().continuation = caller;
+                h.promise().ex = executor_of(caller);
+                return h;
+            }
+        };
+
+        struct task_promise_base
+        {
+            std::coroutine_handle<> continuation;
+            executor* ex = nullptr;
+            std::exception_ptr exception;
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            final_awaiter final_suspend() noexcept { return {}; }
+
+            void unhandled_exception() noexcept { exception = std::current_exception(); }
+        };
+    }
+
+    // 惰性启动的协程任务：创建时不运行，被 co_await 或 spawn 时才开始
+    // 被 co_await 时继承等待者的执行器
+    template<typename T = void>
+    class task
+    {
+    public:
+        struct promise_type : detail::task_promise_base
+        {
+            std::variant<std::monostate, T> result;
+
+            task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+
+            template<typename U>
+            void return_value(U&& value) { result.template emplace<1>(std::forward<U>(value)); }
+        };
+
+        task(task&& other) noexcept : _h(std::exchange(other._h, nullptr)) {}
+
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (_h) _h.destroy();
+                _h = std::exchange(other._h, nullptr);
+            }
+            return *this;
+        }
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        ~task()
+        {
+            if (_h) _h.destroy();
+        }
+
+        struct awaiter : detail::task_awaiter_base<promise_type>
+        {
+            T await_resume()
+            {
+                if (this->h.promise().exception) std::rethrow_exception(this->h.promise().exception);
+                return std::move(std::get<1>(this->h.promise().result));
+            }
+        };
+
+        awaiter operator co_await() && noexcept { return awaiter{ { _h } }; }
+
+    private:
+        explicit task(std::coroutine_handle<promise_type> h) : _h(h) {}
+
+        std::coroutine_handle<promise_type> _h;
+    };
+
+    template<>
+    class task<void>
+    {
+    public:
+        struct promise_type : detail::task_promise_base
+        {
+            task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            void return_void() noexcept {}
+        };
+
+        task(task&& other) noexcept : _h(std::exchange(other._h, nullptr)) {}
+
+        task& operator=(task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (_h) _h.destroy();
+                _h = std::exchange(other._h, nullptr);
+            }
+            return *this;
+        }
+
+        task(const task&) = delete;
+        task& operator=(const task&) = delete;
+
+        ~task()
+        {
+            if (_h) _h.destroy();
+        }
+
+        struct awaiter : detail::task_awaiter_base<promise_type>
+        {
+            void await_resume()
+            {
+                if (this->h.promise().exception) std::rethrow_exception(this->h.promise().exception);
+            }
+        };
+
+        awaiter operator co_await() && noexcept { return awaiter{ { _h } }; }
+
+    private:
+        explicit task(std::coroutine_handle<promise_type> h) : _h(h) {}
+
+        std::coroutine_handle<promise_type> _h;
+    };
+
+    namespace detail {
+        // spawn 用的外壳协程：运行结束后自己销毁帧
+        struct detached_task
+        {
+            struct promise_type
+            {
+                executor* ex = nullptr;
+
+                detached_task get_return_object()
+                {
+                    return { std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                std::suspend_never final_suspend() noexcept { return {}; }
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept { std::terminate(); }   // spawn 出去的任务不能抛异常
+            };
+
+            std::coroutine_handle<promise_type> h;
+        };
+
+        inline detached_task run_detached(task<void> t)
+        {
+            co_await std::move(t);
+        }
+    }
+
+    // 在 ex 上启动一个独立运行的任务，不等待它结束
+    inline void spawn(executor& ex, task<void> t)
+    {
+        detail::detached_task d = detail::run_detached(std::move(t));
+        d.h.promise().ex = &ex;
+        ex.post(d.h);
+    }
+
+    // 单线程执行器：所有协程都在调用 run() 的线程上轮流执行，不需要任何同步
+    // 就绪队列用 queue 适配器（底层 ring_buffer）
+    class single_thread_executor : public executor
+    {
+    public:
+        void post(std::coroutine_handle<> h) override
+        {
+            _ready.push(h);
+        }
+
+        // 运行直到没有就绪的协程；挂起在 channel 上等待的协程不算就绪
+        size_t run()
+        {
+            size_t n = 0;
+            while (!_ready.empty())
+            {
+                std::coroutine_handle<> h = _ready.front();
+                _ready.pop();
+                h.resume();
+                ++n;
+            }
+            return n;
+        }
+
+        bool run_one()
+        {
+            if (_ready.empty()) return false;
+            std::coroutine_handle<> h = _ready.front();
+            _ready.pop();
+            h.resume();
+            return true;
+        }
+
+    private:
+        queue<std::coroutine_handle<>> _ready;
+    };
+
+    // 多线程执行器：固定数量的工作线程共享一个就绪队列
+    class thread_pool_executor : public executor
+    {
+    public:
+        explicit thread_pool_executor(size_t threads = std::thread::hardware_concurrency())
+        {
+            if (threads == 0) threads = 1;
+            for (size_t i = 0; i < threads; ++i) _workers.emplace_back([this] { work_(); });
+        }
+
+        thread_pool_executor(const thread_pool_executor&) = delete;
+        thread_pool_executor& operator=(const thread_pool_executor&) = delete;
+
+        // 等已经就绪的协程都跑完再停止工作线程
+        ~thread_pool_executor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _ready_cv.notify_all();
+            for (std::thread& t : _workers) t.join();
+        }
+
+        void post(std::coroutine_handle<> h) override
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _ready.push(h);
+            }
+            _ready_cv.notify_one();
+        }
+
+        // 阻塞到就绪队列为空且没有线程正在运行协程
+        void wait_idle()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _idle_cv.wait(lock, [this] { return _ready.empty() && _running == 0; });
+        }
+
+        size_t thread_count() const { return _workers.size(); }
+
+    private:
+        void work_()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;)
+            {
+                _ready_cv.wait(lock, [this] { return _stopping || !_ready.empty(); });
+                if (_ready.empty()) return;   // _stopping 且没有剩余工作
+
+                std::coroutine_handle<> h = _ready.front();
+                _ready.pop();
+                ++_running;
+                lock.unlock();
+                h.resume();
+                lock.lock();
+                if (--_running == 0 && _ready.empty()) _idle_cv.notify_all();
+            }
+        }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _ready_cv;
+        std::condition_variable _idle_cv;
+        queue<std::coroutine_handle<>> _ready;
+        size_t _running = 0;
+        bool _stopping = false;
+        vector<std::thread> _workers;
+    };
+}
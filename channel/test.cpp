@@ -0,0 +1,212 @@
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <optional>
+#include <vector>
+#include <cassert>
+#include "channel.h"
+
+// 1. 单线程执行器上的生产者/消费者流水线：producer → square → consumer
+tiny::task<void> produce(tiny::channel<int>& out, int n) {
+    for (int i = 1; i <= n; ++i) {
+        bool ok = co_await out.send(i);
+        assert(ok);
+    }
+    out.close();
+}
+
+tiny::task<void> square(tiny::channel<int>& in, tiny::channel<int>& out) {
+    while (std::optional<int> v = co_await in.recv()) co_await out.send(*v * *v);
+    out.close();
+}
+
+tiny::task<long long> sum_all(tiny::channel<int>& in) {
+    long long sum = 0;
+    while (std::optional<int> v = co_await in.recv()) sum += *v;
+    co_return sum;
+}
+
+tiny::task<void> consume(tiny::channel<int>& in, long long& result) {
+    result = co_await sum_all(in);   // 子任务继承执行器
+}
+
+void test_pipeline() {
+    tiny::single_thread_executor ex;
+    tiny::channel<int> a(4);
+    tiny::channel<int> b(1);
+    long long result = -1;
+
+    tiny::spawn(ex, consume(b, result));
+    tiny::spawn(ex, square(a, b));
+    tiny::spawn(ex, produce(a, 1000));
+    ex.run();
+
+    long long expect = 0;
+    for (long long i = 1; i <= 1000; ++i) expect += i * i;
+    assert(result == expect);
+    assert(a.closed() && b.closed() && a.size() == 0);
+}
+
+// 2. 有界 channel 的背压：缓冲区满时发送者挂起，直到有人取走
+tiny::task<void> send_n(tiny::channel<std::string>& ch, int n, int& sent) {
+    for (int i = 0; i < n; ++i) {
+        co_await ch.send(std::to_string(i));
+        ++sent;
+    }
+}
+
+tiny::task<void> recv_n(tiny::channel<std::string>& ch, int n, std::vector<std::string>& got) {
+    for (int i = 0; i < n; ++i) got.push_back(*co_await ch.recv());
+}
+
+void test_backpressure() {
+    tiny::single_thread_executor ex;
+    tiny::channel<std::string> ch(3);
+    int sent = 0;
+    tiny::spawn(ex, send_n(ch, 10, sent));
+    ex.run();
+    assert(sent == 3 && ch.size() == 3);   // 第 4 个 send 挂起
+
+    std::vector<std::string> got;
+    tiny::spawn(ex, recv_n(ch, 2, got));
+    ex.run();
+    assert(got.size() == 2 && got[0] == "0" && got[1] == "1");
+    assert(sent == 5 && ch.size() == 3);   // 每取走一个，挂起的发送者补进一个
+
+    tiny::spawn(ex, recv_n(ch, 8, got));
+    ex.run();
+    assert(sent == 10 && ch.size() == 0 && got.size() == 10);
+    for (int i = 0; i < 10; ++i) assert(got[i] == std::to_string(i));
+
+    // 无界 channel 的 send 从不挂起
+    tiny::channel<std::string> unbounded;
+    tiny::spawn(ex, send_n(unbounded, 1000, sent));
+    ex.run();
+    assert(sent == 1010 && unbounded.size() == 1000);
+    assert(*unbounded.try_recv() == "0");
+}
+
+// 3. close：唤醒所有等待者；缓冲区剩余元素仍可取出
+tiny::task<void> recv_one(tiny::channel<int>& ch, std::optional<int>& out, bool& done) {
+    out = co_await ch.recv();
+    done = true;
+}
+
+tiny::task<void> send_one(tiny::channel<int>& ch, int v, bool& ok, bool& done) {
+    ok = co_await ch.send(v);
+    done = true;
+}
+
+void test_close() {
+    tiny::single_thread_executor ex;
+
+    tiny::channel<int> empty(2);
+    std::optional<int> r1 = 7, r2 = 7;
+    bool d1 = false, d2 = false;
+    tiny::spawn(ex, recv_one(empty, r1, d1));
+    tiny::spawn(ex, recv_one(empty, r2, d2));
+    ex.run();
+    assert(!d1 && !d2);
+    empty.close();
+    ex.run();
+    assert(d1 && d2 && !r1 && !r2);
+    assert(!empty.try_send(1));
+
+    tiny::channel<int> full(1);
+    assert(full.try_send(1) && !full.try_send(2));
+    bool ok = true, done = false;
+    tiny::spawn(ex, send_one(full, 2, ok, done));
+    ex.run();
+    assert(!done);
+    full.close();
+    ex.run();
+    assert(done && !ok);
+    assert(*full.try_recv() == 1 && !full.try_recv());
+
+    std::optional<int> r3 = 7;
+    bool d3 = false;
+    tiny::spawn(ex, recv_one(full, r3, d3));
+    ex.run();
+    assert(d3 && !r3);
+}
+
+// 4. try_send 直接交给挂起的接收者；try_recv 让挂起的发送者补位
+void test_try_ops() {
+    tiny::single_thread_executor ex;
+    tiny::channel<int> ch(1);
+    std::optional<int> r;
+    bool done = false;
+    tiny::spawn(ex, recv_one(ch, r, done));
+    ex.run();
+    assert(ch.try_send(42) && ch.size() == 0);
+    ex.run();
+    assert(done && *r == 42);
+
+    bool ok = false, sdone = false;
+    assert(ch.try_send(1));
+    tiny::spawn(ex, send_one(ch, 2, ok, sdone));
+    ex.run();
+    assert(!sdone);
+    assert(*ch.try_recv() == 1 && ch.size() == 1);
+    ex.run();
+    assert(sdone && ok && *ch.try_recv() == 2);
+}
+
+// 5. 线程池：多个生产者、多个消费者跨线程通过同一个 channel
+tiny::task<void> mt_produce(tiny::channel<int>& ch, int base, int n, std::atomic<int>& producers) {
+    for (int i = 0; i < n; ++i) co_await ch.send(base + i);
+    if (producers.fetch_sub(1) == 1) ch.close();
+}
+
+tiny::task<void> mt_consume(tiny::channel<int>& ch, std::atomic<long long>& sum, std::atomic<int>& count) {
+    while (std::optional<int> v = co_await ch.recv()) {
+        sum.fetch_add(*v, std::memory_order_relaxed);
+        count.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void test_thread_pool() {
+    const int producers = 4, consumers = 3, per = 5000;
+    std::atomic<long long> sum{ 0 };
+    std::atomic<int> count{ 0 };
+    std::atomic<int> alive{ producers };
+    tiny::channel<int> ch(8);
+    {
+        tiny::thread_pool_executor pool(4);
+        for (int c = 0; c < consumers; ++c) tiny::spawn(pool, mt_consume(ch, sum, count));
+        for (int p = 0; p < producers; ++p) tiny::spawn(pool, mt_produce(ch, p * per, per, alive));
+        pool.wait_idle();
+    }
+    assert(count == producers * per);
+    long long n = producers * per;
+    assert(sum == n * (n - 1) / 2);
+}
+
+// 6. 在单线程执行器和线程池之间切换
+tiny::task<void> hop(tiny::executor& to, std::atomic<bool>& on_pool, std::thread::id main_id) {
+    co_await to.schedule();
+    on_pool = std::this_thread::get_id() != main_id;
+}
+
+void test_schedule() {
+    tiny::single_thread_executor ex;
+    std::atomic<bool> on_pool{ false };
+    {
+        tiny::thread_pool_executor pool(1);
+        tiny::spawn(ex, hop(pool, on_pool, std::this_thread::get_id()));
+        ex.run();
+        pool.wait_idle();
+    }
+    assert(on_pool);
+}
+
+int main() {
+    test_pipeline();
+    test_backpressure();
+    test_close();
+    test_try_ops();
+    test_thread_pool();
+    test_schedule();
+    std::cout << "all channel tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,502 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include "../memory/memory_resource.h"
+#include "../instrument/instrument.h"
+
+namespace tiny {
+
+    namespace detail {
+        // 每块约 4KB，元素个数取 2 的幂，下标用移位/掩码拆成（块号, 块内偏移）；大对象每块至少 16 个
+        template<typename T>
+        constexpr size_t deque_block_size()
+        {
+            constexpr size_t n = 4096 / sizeof(T);
+            return n < 16 ? 16 : std::bit_floor(n);
+        }
+
+        template<typename T, bool Const>
+        class deque_iterator
+        {
+            static constexpr size_t B = deque_block_size<T>();
+            using node_ptr = T* const*;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const T&, T&>;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+
+            deque_iterator() = default;
+
+            deque_iterator(node_ptr node, size_t offset) : _node(node), _offset(offset) {}
+
+            template<bool C = Const> requires C
+            deque_iterator(const deque_iterator<T, false>& it) : _node(it._node), _offset(it._offset) {}
+
+            reference operator*() const { return (*_node)[_offset]; }
+            pointer operator->() const { return *_node + _offset; }
+            reference operator[](difference_type n) const { return *(*this + n); }
+
+            deque_iterator& operator++()
+            {
+                if (++_offset == B)
+                {
+                    ++_node;
+                    _offset = 0;
+                }
+                return *this;
+            }
+
+            deque_iterator& operator--()
+            {
+                if (_offset == 0)
+                {
+                    --_node;
+                    _offset = B;
+                }
+                --_offset;
+                return *this;
+            }
+
+            deque_iterator operator++(int) { deque_iterator tmp(*this); ++*this; return tmp; }
+            deque_iterator operator--(int) { deque_iterator tmp(*this); --*this; return tmp; }
+
+            deque_iterator& operator+=(difference_type n)
+            {
+                difference_type g = static_cast<difference_type>(_offset) + n;
+                // 向下取整的块位移，负数也成立
+                difference_type blocks = g >= 0 ? g / difference_type(B) : -((-g - 1) / difference_type(B)) - 1;
+                _node += blocks;
+                _offset = static_cast<size_t>(g - blocks * difference_type(B));
+                return *this;
+            }
+
+            deque_iterator& operator-=(difference_type n) { return *this += -n; }
+            deque_iterator operator+(difference_type n) const { deque_iterator tmp(*this); return tmp += n; }
+            deque_iterator operator-(difference_type n) const { deque_iterator tmp(*this); return tmp += -n; }
+            friend deque_iterator operator+(difference_type n, const deque_iterator& it) { return it + n; }
+
+            difference_type operator-(const deque_iterator& it) const
+            {
+                return (_node - it._node) * difference_type(B)
+                    + static_cast<difference_type>(_offset) - static_cast<difference_type>(it._offset);
+            }
+
+            bool operator==(const deque_iterator& it) const { return _node == it._node && _offset == it._offset; }
+            bool operator!=(const deque_iterator& it) const { return !(*this == it); }
+            bool operator<(const deque_iterator& it) const { return _node < it._node || (_node == it._node && _offset < it._offset); }
+            bool operator>(const deque_iterator& it) const { return it < *this; }
+            bool operator<=(const deque_iterator& it) const { return !(it < *this); }
+            bool operator>=(const deque_iterator& it) const { return !(*this < it); }
+
+        private:
+            template<typename, bool> friend class deque_iterator;
+
+            node_ptr _node = nullptr;
+            size_t _offset = 0;
+        };
+    }
+
+    // 分块存储的双端队列
+    //   元素放在固定大小的块里，块指针放在一个“块表”（map）里；
+    //   两端增长只会新分配块或挪动块表里的指针，已有元素永远不会被移动，
+    //   所以 push/pop 两端之后其余元素的指针与引用仍然有效，也不会有整体拷贝造成的停顿
+    //   两端 push/pop 均摊 O(1)，随机访问 O(1)（一次移位、一次查表）
+    // 可以直接作为 queue / stack 的 Container
+    template<typename T>
+    class deque
+    {
+        static constexpr size_t B = detail::deque_block_size<T>();
+        static constexpr size_t kShift = std::countr_zero(B);
+
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = size_t;
+        using iterator = detail::deque_iterator<T, false>;
+        using const_iterator = detail::deque_iterator<T, true>;
+
+        static constexpr size_t block_size = B;
+
+        deque() = default;
+
+        // 块与块表都从 r 分配；不传时使用 get_default_resource()
+        explicit deque(memory_resource* r)
+            : _resource(r)
+        {
+            assert(r);
+        }
+
+        deque(size_t n, const T& value = T(), memory_resource* r = get_default_resource())
+            : _resource(r)
+        {
+            for (size_t i = 0; i < n; ++i) push_back(value);
+        }
+
+        template<typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+        deque(InputIterator first, InputIterator last, memory_resource* r = get_default_resource())
+            : _resource(r)
+        {
+            for (; first != last; ++first) push_back(*first);
+        }
+
+        // 拷贝得到的新容器使用默认资源
+        deque(const deque& other)
+        {
+            for (const T& item : other) push_back(item);
+        }
+
+        deque(deque&& other) noexcept
+            : _resource(other._resource)
+        {
+            swap(other);
+        }
+
+        // 赋值不改变自己的资源
+        deque& operator=(const deque& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (const T& item : other) push_back(item);
+            }
+            return *this;
+        }
+
+        deque& operator=(deque&& other)
+        {
+            if (this == &other) return *this;
+            if (*_resource == *other._resource)
+            {
+                deque tmp(std::move(other));
+                swap_storage_(tmp);
+            }
+            else
+            {
+                clear();
+                for (T& item : other) push_back(std::move(item));
+                other.clear();
+            }
+            return *this;
+        }
+
+        ~deque()
+        {
+            clear();
+            release_spare_();
+            deallocate_map_(_map, _map_cap);
+        }
+
+        void swap(deque& other) noexcept
+        {
+            swap_storage_(other);
+            std::swap(_resource, other._resource);
+        }
+
+        memory_resource* resource() const { return _resource; }
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        iterator begin() { return iterator(_map + _map_begin, _head); }
+        iterator end() { return begin() + difference_type_(_size); }
+        const_iterator begin() const { return const_iterator(_map + _map_begin, _head); }
+        const_iterator end() const { return begin() + difference_type_(_size); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        T& operator[](size_t index)
+        {
+            assert(index < _size);
+            return slot_(index);
+        }
+
+        const T& operator[](size_t index) const
+        {
+            assert(index < _size);
+            return const_cast<deque*>(this)->slot_(index);
+        }
+
+        T& front() { assert(!empty()); return slot_(0); }
+        const T& front() const { assert(!empty()); return (*this)[0]; }
+        T& back() { assert(!empty()); return slot_(_size - 1); }
+        const T& back() const { assert(!empty()); return (*this)[_size - 1]; }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+        void push_front(const T& value) { emplace_front(value); }
+        void push_front(T&& value) { emplace_front(std::move(value)); }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            const size_t g = _head + _size;
+            const bool new_block = g == used_blocks_() * B;
+            if (new_block) add_block_back_();
+            T* p = _map[_map_begin + (g >> kShift)] + (g & (B - 1));
+            try
+            {
+                new (p) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                // 构造失败时撤销刚加的空块，保持“首尾块非空”的不变式
+                if (new_block) release_block_(_map[--_map_end]);
+                if (_size == 0) reset_empty_();
+                throw;
+            }
+            ++_size;
+            return *p;
+        }
+
+        template<typename... Args>
+        T& emplace_front(Args&&... args)
+        {
+            const bool new_block = _head == 0;
+            if (new_block) add_block_front_();
+            T* p = _map[_map_begin] + (_head - 1);
+            try
+            {
+                new (p) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                if (new_block)
+                {
+                    release_block_(_map[_map_begin++]);
+                    _head = 0;
+                }
+                if (_size == 0) reset_empty_();
+                throw;
+            }
+            --_head;
+            ++_size;
+            return *p;
+        }
+
+        void pop_back()
+        {
+            assert(!empty());
+            --_size;
+            const size_t g = _head + _size;
+            _map[_map_begin + (g >> kShift)][g & (B - 1)].~T();
+            // 最后一块空了就还回去（先放进备用块）
+            if (_size == 0) reset_empty_();
+            else if ((g & (B - 1)) == 0) release_block_(_map[--_map_end]);
+        }
+
+        void pop_front()
+        {
+            assert(!empty());
+            _map[_map_begin][_head].~T();
+            ++_head;
+            --_size;
+            if (_size == 0) reset_empty_();
+            else if (_head == B)
+            {
+                release_block_(_map[_map_begin++]);
+                _head = 0;
+            }
+        }
+
+        void clear()
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>)
+            {
+                for (T& item : *this) item.~T();
+            }
+            _size = 0;
+            reset_empty_();
+        }
+
+        void resize(size_t n, const T& value = T())
+        {
+            while (_size > n) pop_back();
+            while (_size < n) push_back(value);
+        }
+
+        // 释放备用块，并把块表缩到刚好够用
+        void shrink_to_fit()
+        {
+            release_spare_();
+            if (used_blocks_() == 0 && _map)
+            {
+                deallocate_map_(_map, _map_cap);
+                _map = nullptr;
+                _map_cap = _map_begin = _map_end = 0;
+            }
+        }
+
+        // 批量入队：按块整段构造，供 queue::push_bulk 使用
+        void push_back_bulk(std::span<const T> values)
+        {
+            size_t i = 0;
+            while (i < values.size())
+            {
+                const size_t g = _head + _size;
+                if (g == used_blocks_() * B) add_block_back_();
+                T* block = _map[_map_begin + (g >> kShift)];
+                const size_t offset = g & (B - 1);
+                const size_t n = std::min(B - offset, values.size() - i);
+                std::uninitialized_copy_n(values.data() + i, n, block + offset);
+                _size += n;
+                i += n;
+            }
+        }
+
+        // 批量出队最多 out.size() 个元素，返回实际个数；供 queue::pop_bulk 使用
+        size_t pop_front_bulk(std::span<T> out)
+        {
+            const size_t total = std::min(out.size(), _size);
+            size_t done = 0;
+            while (done < total)
+            {
+                T* block = _map[_map_begin];
+                const size_t n = std::min(B - _head, total - done);
+                std::move(block + _head, block + _head + n, out.data() + done);
+                std::destroy(block + _head, block + _head + n);
+                _head += n;
+                _size -= n;
+                done += n;
+                if (_size == 0) reset_empty_();
+                else if (_head == B)
+                {
+                    release_block_(_map[_map_begin++]);
+                    _head = 0;
+                }
+            }
+            return total;
+        }
+
+    private:
+        static std::ptrdiff_t difference_type_(size_t n) { return static_cast<std::ptrdiff_t>(n); }
+
+        size_t used_blocks_() const { return _map_end - _map_begin; }
+
+        T& slot_(size_t index)
+        {
+            const size_t g = _head + index;
+            return _map[_map_begin + (g >> kShift)][g & (B - 1)];
+        }
+
+        T* allocate_block_()
+        {
+            if (_spare)
+            {
+                T* b = _spare;
+                _spare = nullptr;
+                return b;
+            }
+            instrument::on_allocate<deque<T>>(B * sizeof(T), B);
+            return static_cast<T*>(_resource->allocate(B * sizeof(T), alignof(T)));
+        }
+
+        // 空出来的块留一块备用，两端在块边界上来回 push/pop 时不会反复分配
+        void release_block_(T* block)
+        {
+            if (!_spare)
+            {
+                _spare = block;
+                return;
+            }
+            instrument::on_deallocate<deque<T>>(B * sizeof(T));
+            _resource->deallocate(block, B * sizeof(T), alignof(T));
+        }
+
+        void release_spare_()
+        {
+            if (!_spare) return;
+            instrument::on_deallocate<deque<T>>(B * sizeof(T));
+            _resource->deallocate(_spare, B * sizeof(T), alignof(T));
+            _spare = nullptr;
+        }
+
+        // 变空时归还所有块（至多留一块备用），块表回到中间，两端都有增长余地
+        void reset_empty_()
+        {
+            for (size_t i = _map_begin; i < _map_end; ++i) release_block_(_map[i]);
+            _map_begin = _map_end = _map_cap / 2;
+            _head = 0;
+        }
+
+        void add_block_back_()
+        {
+            if (_map_end == _map_cap) reserve_map_(false);
+            _map[_map_end] = allocate_block_();
+            ++_map_end;
+        }
+
+        void add_block_front_()
+        {
+            if (_map_begin == 0) reserve_map_(true);
+            _map[_map_begin - 1] = allocate_block_();
+            --_map_begin;
+            _head = B;
+        }
+
+        // 块表一端用完：还有一半以上空闲就把块指针挪回中间，否则换一张两倍大的表
+        // 只移动块指针，元素本身不动
+        void reserve_map_(bool at_front)
+        {
+            const size_t used = used_blocks_();
+            size_t new_cap = _map_cap;
+            T** new_map = _map;
+            if (_map_cap < 8 || used * 2 >= _map_cap)
+            {
+                new_cap = _map_cap < 8 ? 8 : _map_cap * 2;
+                new_map = static_cast<T**>(_resource->allocate(new_cap * sizeof(T*), alignof(T*)));
+            }
+
+            // 往哪端增长就在哪端多留空间
+            const size_t free = new_cap - used;
+            const size_t new_begin = at_front ? free - free / 4 : free / 4;
+            if (used) std::memmove(new_map + new_begin, _map + _map_begin, used * sizeof(T*));
+
+            if (new_map != _map)
+            {
+                deallocate_map_(_map, _map_cap);
+                _map = new_map;
+                _map_cap = new_cap;
+            }
+            _map_begin = new_begin;
+            _map_end = new_begin + used;
+        }
+
+        void deallocate_map_(T** map, size_t cap)
+        {
+            _resource->deallocate(map, cap * sizeof(T*), alignof(T*));
+        }
+
+        void swap_storage_(deque& other) noexcept
+        {
+            std::swap(_map, other._map);
+            std::swap(_map_cap, other._map_cap);
+            std::swap(_map_begin, other._map_begin);
+            std::swap(_map_end, other._map_end);
+            std::swap(_head, other._head);
+            std::swap(_size, other._size);
+            std::swap(_spare, other._spare);
+        }
+
+    private:
+        T** _map = nullptr;        // 块表
+        size_t _map_cap = 0;
+        size_t _map_begin = 0;     // 已用的块是 _map[_map_begin, _map_end)
+        size_t _map_end = 0;
+        size_t _head = 0;          // 第一个元素在首块里的偏移
+        size_t _size = 0;
+        T* _spare = nullptr;       // 备用块
+        memory_resource* _resource = get_default_resource();
+    };
+}
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <deque>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include "deque.h"
+#include "../queue/queue.h"
+#include "../stack/stack.h"
+
+// 1. 两端 push/pop、随机访问，与 std::deque 逐步对照
+void test_against_std() {
+    tiny::deque<int> d;
+    std::deque<int> ref;
+    std::mt19937 rng(11);
+    for (int step = 0; step < 200000; ++step) {
+        int op = int(rng() % 10);
+        if (op < 3) { d.push_back(step); ref.push_back(step); }
+        else if (op < 6) { d.push_front(step); ref.push_front(step); }
+        else if (op < 8 && !ref.empty()) { d.pop_back(); ref.pop_back(); }
+        else if (!ref.empty()) { d.pop_front(); ref.pop_front(); }
+
+        assert(d.size() == ref.size());
+        if (!ref.empty()) {
+            assert(d.front() == ref.front() && d.back() == ref.back());
+            size_t i = rng() % ref.size();
+            assert(d[i] == ref[i]);
+        }
+    }
+    assert(std::equal(d.begin(), d.end(), ref.begin(), ref.end()));
+}
+
+// 2. 增长过程中已有元素的地址不变
+void test_stable_addresses() {
+    tiny::deque<std::string> d;
+    d.push_back("anchor-back");
+    d.push_front("anchor-front");
+    std::string* back = &d[1];
+    std::string* front = &d[0];
+    for (int i = 0; i < 300000; ++i) {
+        d.push_back(std::to_string(i));
+        d.push_front(std::to_string(-i));
+    }
+    assert(*back == "anchor-back" && *front == "anchor-front");
+    assert(&d[300000] == front && &d[300001] == back);
+
+    // 从两端删掉一部分，中间的元素仍在原地
+    for (int i = 0; i < 1000; ++i) {
+        d.pop_back();
+        d.pop_front();
+    }
+    assert(*back == "anchor-back" && &d[299000] == front);
+}
+
+// 3. 迭代器是随机访问迭代器，可以直接用于 std 算法
+void test_iterators() {
+    tiny::deque<int> d;
+    for (int i = 0; i < 5000; ++i) d.push_front(i * 7919 % 5003);
+    std::sort(d.begin(), d.end());
+    assert(std::is_sorted(d.begin(), d.end()));
+
+    auto it = d.begin() + 4000;
+    assert(it - d.begin() == 4000 && *it == d[4000]);
+    it -= 3999;
+    assert(*it == d[1] && it[10] == d[11]);
+    assert(d.end() - d.begin() == 5000);
+    assert(std::lower_bound(d.cbegin(), d.cend(), d[2500]) - d.cbegin() <= 2500);
+
+    tiny::deque<int> copy(d);
+    assert(std::equal(copy.begin(), copy.end(), d.begin(), d.end()));
+    tiny::deque<int> moved(std::move(copy));
+    assert(copy.empty() && moved.size() == 5000);
+    copy = moved;
+    moved.clear();
+    assert(copy.size() == 5000 && moved.empty());
+}
+
+// 4. 作为 queue / stack 的底层容器
+void test_adapters() {
+    queue<int, tiny::deque<int>> q;
+    for (int i = 0; i < 10000; ++i) q.push(i);
+    for (int i = 0; i < 10000; ++i) {
+        assert(q.front() == i);
+        q.pop();
+    }
+    assert(q.empty());
+
+    int in[3000];
+    for (int i = 0; i < 3000; ++i) in[i] = i;
+    q.push_bulk(in);
+    int out[1000];
+    assert(q.pop_bulk(out) == 1000 && out[0] == 0 && out[999] == 999);
+    assert(q.front() == 1000);
+
+    stack<std::string, tiny::deque<std::string>> s;
+    for (int i = 0; i < 1000; ++i) s.push(std::to_string(i));
+    assert(s.top() == "999");
+    for (int i = 999; i >= 0; --i) {
+        assert(s.top() == std::to_string(i));
+        s.pop();
+    }
+    assert(s.empty());
+}
+
+// 5. 元素构造抛异常时容器保持原样
+struct throwing
+{
+    static int budget;
+    int value;
+    throwing(int v) : value(v)
+    {
+        if (budget-- == 0) throw std::runtime_error("boom");
+    }
+};
+int throwing::budget = 0;
+
+void test_exception_safety() {
+    tiny::deque<throwing> d;
+    throwing::budget = (int)tiny::deque<throwing>::block_size;   // 正好在新块的第一个元素处失败
+    size_t pushed = 0;
+    try {
+        for (;;) { d.emplace_back(int(pushed)); ++pushed; }
+    } catch (const std::runtime_error&) {}
+    assert(d.size() == pushed && d.back().value == int(pushed) - 1);
+    d.pop_back();
+    assert(d.size() == pushed - 1);
+
+    throwing::budget = 0;
+    try { d.emplace_front(-1); } catch (const std::runtime_error&) {}
+    assert(d.size() == pushed - 1 && d.front().value == 0);
+    throwing::budget = 1000000;
+    d.emplace_front(-1);
+    assert(d.front().value == -1 && d[1].value == 0);
+}
+
+int main() {
+    test_against_std();
+    test_stable_addresses();
+    test_iterators();
+    test_adapters();
+    test_exception_safety();
+    std::cout << "all deque tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,373 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "../vector/vector.h"
+#include "flat_set.h"
+
+namespace tiny {
+
+    namespace detail {
+        // 迭代器解引用得到的是临时的 pair<const K&, V&>，operator-> 需要一个能取地址的包装
+        template<typename Ref>
+        struct arrow_proxy
+        {
+            Ref ref;
+            Ref* operator->() { return &ref; }
+        };
+
+        // flat_map 的迭代器：同一个下标同时指向 key 数组与 value 数组
+        template<typename Key, typename V>
+        class flat_map_iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::pair<Key, std::remove_const_t<V>>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const Key&, V&>;
+            using pointer = arrow_proxy<reference>;
+
+            flat_map_iterator() = default;
+
+            flat_map_iterator(const Key* key, V* value)
+                : _key(key), _value(value)
+            {}
+
+            // iterator 可以隐式转换成 const_iterator
+            template<typename U> requires std::is_same_v<const U, V>
+            flat_map_iterator(const flat_map_iterator<Key, U>& it)
+                : _key(it.key_ptr()), _value(it.value_ptr())
+            {}
+
+            reference operator*() const { return {*_key, *_value}; }
+            pointer operator->() const { return {**this}; }
+            reference operator[](difference_type n) const { return {_key[n], _value[n]}; }
+
+            flat_map_iterator& operator++() { ++_key; ++_value; return *this; }
+            flat_map_iterator& operator--() { --_key; --_value; return *this; }
+            flat_map_iterator operator++(int) { flat_map_iterator tmp(*this); ++*this; return tmp; }
+            flat_map_iterator operator--(int) { flat_map_iterator tmp(*this); --*this; return tmp; }
+
+            flat_map_iterator& operator+=(difference_type n) { _key += n; _value += n; return *this; }
+            flat_map_iterator& operator-=(difference_type n) { _key -= n; _value -= n; return *this; }
+            flat_map_iterator operator+(difference_type n) const { return flat_map_iterator(_key + n, _value + n); }
+            flat_map_iterator operator-(difference_type n) const { return flat_map_iterator(_key - n, _value - n); }
+            difference_type operator-(const flat_map_iterator& it) const { return _key - it._key; }
+
+            bool operator==(const flat_map_iterator& it) const { return _key == it._key; }
+            bool operator!=(const flat_map_iterator& it) const { return _key != it._key; }
+            bool operator<(const flat_map_iterator& it) const { return _key < it._key; }
+
+            const Key* key_ptr() const { return _key; }
+            V* value_ptr() const { return _value; }
+
+        private:
+            const Key* _key = nullptr;
+            V* _value = nullptr;
+        };
+    }
+
+    // 有序数组实现的映射：key 与 value 分别排好序存放在两个 tiny::vector 里
+    // key 单独连续存放，二分查找时只访问 key 数组，缓存里能装下更多的 key
+    // 单个插入/删除是 O(n)，适合读远多于写的配置表、路由表；
+    // 成批写入请用 insert(first, last)：新元素排序去重后与已有元素单趟归并
+    template<typename Key, typename T, typename Compare = std::less<Key>>
+    class flat_map
+    {
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<Key, T>;
+        using key_compare = Compare;
+        using iterator = detail::flat_map_iterator<Key, T>;
+        using const_iterator = detail::flat_map_iterator<Key, const T>;
+
+        flat_map() = default;
+
+        explicit flat_map(const Compare& comp)
+            : _comp(comp)
+        {}
+
+        // 批量构建：排序 + 去重，O(n log n)；重复的 key 保留最先出现的
+        template<typename InputIterator>
+        flat_map(InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : _comp(comp)
+        {
+            tiny::vector<value_type> batch(first, last);
+            sort_batch(batch);
+            _keys.reserve(batch.size());
+            _values.reserve(batch.size());
+            for (value_type& kv : batch)
+            {
+                _keys.push_back(std::move(kv.first));
+                _values.push_back(std::move(kv.second));
+            }
+        }
+
+        flat_map(std::initializer_list<value_type> il, const Compare& comp = Compare())
+            : flat_map(il.begin(), il.end(), comp)
+        {}
+
+        iterator begin() { return iterator(_keys.begin(), _values.begin()); }
+        iterator end() { return iterator(_keys.end(), _values.end()); }
+        const_iterator begin() const { return const_iterator(_keys.begin(), _values.begin()); }
+        const_iterator end() const { return const_iterator(_keys.end(), _values.end()); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        bool empty() const { return _keys.empty(); }
+        size_t size() const { return _keys.size(); }
+        key_compare key_comp() const { return _comp; }
+
+        void reserve(size_t n)
+        {
+            _keys.reserve(n);
+            _values.reserve(n);
+        }
+
+        void clear()
+        {
+            _keys.clear();
+            _values.clear();
+        }
+
+        // 直接访问底层的有序数组
+        const tiny::vector<Key>& keys() const { return _keys; }
+        const tiny::vector<T>& values() const { return _values; }
+
+        // ---------- 查找 ----------
+
+        iterator lower_bound(const Key& key) { return begin() + lower_index(key); }
+        const_iterator lower_bound(const Key& key) const { return begin() + lower_index(key); }
+        iterator upper_bound(const Key& key) { return begin() + upper_index(key); }
+        const_iterator upper_bound(const Key& key) const { return begin() + upper_index(key); }
+
+        iterator find(const Key& key) { return begin() + find_index(key); }
+        const_iterator find(const Key& key) const { return begin() + find_index(key); }
+        bool contains(const Key& key) const { return find_index(key) != size(); }
+        size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        iterator lower_bound(const K& key) { return begin() + lower_index(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator lower_bound(const K& key) const { return begin() + lower_index(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        iterator find(const K& key) { return begin() + find_index(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator find(const K& key) const { return begin() + find_index(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        bool contains(const K& key) const { return find_index(key) != size(); }
+
+        T& at(const Key& key)
+        {
+            size_t i = find_index(key);
+            if (i == size()) throw std::out_of_range("tiny::flat_map::at");
+            return _values[i];
+        }
+
+        const T& at(const Key& key) const
+        {
+            size_t i = find_index(key);
+            if (i == size()) throw std::out_of_range("tiny::flat_map::at");
+            return _values[i];
+        }
+
+        T& operator[](const Key& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        T& operator[](Key&& key)
+        {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        // ---------- 插入 ----------
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            return try_emplace_impl(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& kv)
+        {
+            return try_emplace_impl(kv.first, kv.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& kv)
+        {
+            return try_emplace_impl(std::move(kv.first), std::move(kv.second));
+        }
+
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+        {
+            auto result = try_emplace_impl(key, std::forward<M>(obj));
+            if (!result.second) result.first->second = std::forward<M>(obj);
+            return result;
+        }
+
+        // 批量插入：新元素先排序去重，再和已有元素单趟归并，O(n + m log m)
+        // 与已有 key 重复的新元素被忽略，语义同逐个 insert
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            tiny::vector<value_type> batch(first, last);
+            if (batch.empty()) return;
+            sort_batch(batch);
+
+            const size_t n = _keys.size() + batch.size();
+            tiny::vector<Key> keys;
+            tiny::vector<T> values;
+            keys.reserve(n);
+            values.reserve(n);
+
+            size_t a = 0;
+            value_type* b = batch.begin();
+            while (a != _keys.size() && b != batch.end())
+            {
+                if (_comp(b->first, _keys[a]))
+                {
+                    keys.push_back(std::move(b->first));
+                    values.push_back(std::move(b->second));
+                    ++b;
+                }
+                else
+                {
+                    if (!_comp(_keys[a], b->first)) ++b;   // 已存在，保留旧的
+                    keys.push_back(std::move(_keys[a]));
+                    values.push_back(std::move(_values[a]));
+                    ++a;
+                }
+            }
+            for (; a != _keys.size(); ++a)
+            {
+                keys.push_back(std::move(_keys[a]));
+                values.push_back(std::move(_values[a]));
+            }
+            for (; b != batch.end(); ++b)
+            {
+                keys.push_back(std::move(b->first));
+                values.push_back(std::move(b->second));
+            }
+
+            _keys.swap(keys);
+            _values.swap(values);
+        }
+
+        void insert(std::initializer_list<value_type> il)
+        {
+            insert(il.begin(), il.end());
+        }
+
+        // ---------- 删除 ----------
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            size_t i = first - cbegin();
+            size_t j = last - cbegin();
+            _keys.erase(_keys.begin() + i, _keys.begin() + j);
+            _values.erase(_values.begin() + i, _values.begin() + j);
+            return begin() + i;
+        }
+
+        size_t erase(const Key& key)
+        {
+            size_t i = find_index(key);
+            if (i == size()) return 0;
+            erase(cbegin() + i);
+            return 1;
+        }
+
+        void swap(flat_map& other)
+        {
+            _keys.swap(other._keys);
+            _values.swap(other._values);
+            std::swap(_comp, other._comp);
+        }
+
+    private:
+        void sort_batch(tiny::vector<value_type>& batch) const
+        {
+            detail::sort_unique(batch,
+                [this](const value_type& a, const value_type& b) { return _comp(a.first, b.first); });
+        }
+
+        template<typename K>
+        size_t lower_index(const K& key) const
+        {
+            return detail::branchless_lower_bound(_keys.begin(), _keys.size(), key, _comp);
+        }
+
+        template<typename K>
+        size_t upper_index(const K& key) const
+        {
+            return detail::branchless_upper_bound(_keys.begin(), _keys.size(), key, _comp);
+        }
+
+        // 找不到时返回 size()
+        template<typename K>
+        size_t find_index(const K& key) const
+        {
+            size_t i = lower_index(key);
+            if (i != _keys.size() && !_comp(key, _keys[i])) return i;
+            return _keys.size();
+        }
+
+        template<typename K, typename... Args>
+        std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args)
+        {
+            size_t i = lower_index(key);
+            if (i != _keys.size() && !_comp(key, _keys[i])) return {begin() + i, false};
+
+            // key 可能引用 _values 里的元素（如 m[m.at(k)]），插入 value 时 _values 会扩容搬家：
+            // 先把 key 构造出来；插入 key 失败时撤销已插入的 value，保持两个数组等长
+            Key k(std::forward<K>(key));
+            _values.emplace(_values.begin() + i, std::forward<Args>(args)...);
+            try
+            {
+                _keys.insert(_keys.begin() + i, std::move(k));
+            }
+            catch (...)
+            {
+                _values.erase(_values.begin() + i);
+                throw;
+            }
+            return {begin() + i, true};
+        }
+
+    private:
+        tiny::vector<Key> _keys;
+        tiny::vector<T> _values;
+        Compare _comp;
+    };
+
+    template<typename Key, typename T, typename Compare>
+    bool operator==(const flat_map<Key, T, Compare>& a, const flat_map<Key, T, Compare>& b)
+    {
+        return a.keys().size() == b.keys().size()
+            && std::equal(a.keys().begin(), a.keys().end(), b.keys().begin())
+            && std::equal(a.values().begin(), a.values().end(), b.values().begin());
+    }
+}
@@ -0,0 +1,253 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <utility>
+#include "../vector/vector.h"
+
+namespace tiny {
+
+    namespace detail {
+        template<typename Compare>
+        concept transparent_compare = requires { typename Compare::is_transparent; };
+
+        // 无分支二分查找，返回第一个不小于 key 的下标
+        // 每轮只根据比较结果移动 base（编译成条件传送），循环次数只和 n 有关，
+        // 不会因为分支预测失败而停顿
+        // 比较器与标准算法一样按值传递：通常是空对象，按引用传反而让 GCC 误报未初始化
+        template<typename T, typename K, typename Compare>
+        size_t branchless_lower_bound(const T* data, size_t n, const K& key, Compare comp)
+        {
+            if (n == 0) return 0;
+            const T* base = data;
+            while (n > 1)
+            {
+                size_t half = n / 2;
+                base = comp(base[half], key) ? base + half : base;
+                n -= half;
+            }
+            return static_cast<size_t>(base - data) + (comp(*base, key) ? 1 : 0);
+        }
+
+        // 第一个大于 key 的下标
+        template<typename T, typename K, typename Compare>
+        size_t branchless_upper_bound(const T* data, size_t n, const K& key, Compare comp)
+        {
+            if (n == 0) return 0;
+            const T* base = data;
+            while (n > 1)
+            {
+                size_t half = n / 2;
+                base = comp(key, base[half]) ? base : base + half;
+                n -= half;
+            }
+            return static_cast<size_t>(base - data) + (comp(key, *base) ? 0 : 1);
+        }
+
+        // 把一批元素按 key 稳定排序并去重，相同的 key 只保留最先出现的那个
+        template<typename T, typename KeyLess>
+        void sort_unique(tiny::vector<T>& v, const KeyLess& less)
+        {
+            std::stable_sort(v.begin(), v.end(), less);
+            auto last = std::unique(v.begin(), v.end(),
+                [&](const T& a, const T& b) { return !less(a, b); });
+            v.erase(last, v.end());
+        }
+    }
+
+    // 有序数组实现的集合：元素排好序连续存放在 tiny::vector 里
+    // 查找是对连续内存的二分，比节点式的红黑树省内存、缓存命中率高得多；
+    // 单个插入/删除要移动后面的元素，是 O(n)，适合读多写少的场景，
+    // 成批写入请用 insert(first, last)：一次排序加一次归并
+    template<typename Key, typename Compare = std::less<Key>>
+    class flat_set
+    {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using key_compare = Compare;
+        using iterator = const Key*;
+        using const_iterator = const Key*;
+
+        flat_set() = default;
+
+        explicit flat_set(const Compare& comp)
+            : _comp(comp)
+        {}
+
+        // 批量构建：排序 + 去重，O(n log n)
+        template<typename InputIterator>
+        flat_set(InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : _keys(first, last), _comp(comp)
+        {
+            detail::sort_unique(_keys, _comp);
+        }
+
+        flat_set(std::initializer_list<Key> il, const Compare& comp = Compare())
+            : flat_set(il.begin(), il.end(), comp)
+        {}
+
+        const_iterator begin() const { return _keys.begin(); }
+        const_iterator end() const { return _keys.end(); }
+        const_iterator cbegin() const { return _keys.begin(); }
+        const_iterator cend() const { return _keys.end(); }
+
+        bool empty() const { return _keys.empty(); }
+        size_t size() const { return _keys.size(); }
+        void reserve(size_t n) { _keys.reserve(n); }
+        void clear() { _keys.clear(); }
+
+        const Key& operator[](size_t index) const { return _keys[index]; }
+
+        key_compare key_comp() const { return _comp; }
+
+        // ---------- 查找 ----------
+
+        const_iterator lower_bound(const Key& key) const { return begin() + lower_index(key); }
+        const_iterator upper_bound(const Key& key) const { return begin() + upper_index(key); }
+        const_iterator find(const Key& key) const { return find_impl(key); }
+        bool contains(const Key& key) const { return find_impl(key) != end(); }
+        size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator lower_bound(const K& key) const { return begin() + lower_index(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator upper_bound(const K& key) const { return begin() + upper_index(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        const_iterator find(const K& key) const { return find_impl(key); }
+
+        template<typename K> requires detail::transparent_compare<Compare>
+        bool contains(const K& key) const { return find_impl(key) != end(); }
+
+        std::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+        {
+            return {lower_bound(key), upper_bound(key)};
+        }
+
+        // ---------- 修改 ----------
+
+        std::pair<const_iterator, bool> insert(const Key& key)
+        {
+            return emplace_impl(key);
+        }
+
+        std::pair<const_iterator, bool> insert(Key&& key)
+        {
+            return emplace_impl(std::move(key));
+        }
+
+        template<typename... Args>
+        std::pair<const_iterator, bool> emplace(Args&&... args)
+        {
+            return emplace_impl(Key(std::forward<Args>(args)...));
+        }
+
+        // 批量插入：新元素先排序去重，再和已有元素单趟归并，O(n + m log m)
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            tiny::vector<Key> batch(first, last);
+            if (batch.empty()) return;
+            detail::sort_unique(batch, _comp);
+            if (_keys.empty())
+            {
+                _keys.swap(batch);
+                return;
+            }
+
+            tiny::vector<Key> merged;
+            merged.reserve(_keys.size() + batch.size());
+            Key* a = _keys.begin();
+            Key* b = batch.begin();
+            while (a != _keys.end() && b != batch.end())
+            {
+                if (_comp(*b, *a)) merged.push_back(std::move(*b++));
+                else
+                {
+                    if (!_comp(*a, *b)) ++b;   // 已存在，保留旧的
+                    merged.push_back(std::move(*a++));
+                }
+            }
+            for (; a != _keys.end(); ++a) merged.push_back(std::move(*a));
+            for (; b != batch.end(); ++b) merged.push_back(std::move(*b));
+            _keys.swap(merged);
+        }
+
+        void insert(std::initializer_list<Key> il)
+        {
+            insert(il.begin(), il.end());
+        }
+
+        const_iterator erase(const_iterator pos)
+        {
+            size_t index = pos - begin();
+            _keys.erase(_keys.begin() + index);
+            return begin() + index;
+        }
+
+        const_iterator erase(const_iterator first, const_iterator last)
+        {
+            size_t index = first - begin();
+            _keys.erase(_keys.begin() + index, _keys.begin() + (last - begin()));
+            return begin() + index;
+        }
+
+        size_t erase(const Key& key)
+        {
+            const_iterator it = find(key);
+            if (it == end()) return 0;
+            erase(it);
+            return 1;
+        }
+
+        void swap(flat_set& other)
+        {
+            _keys.swap(other._keys);
+            std::swap(_comp, other._comp);
+        }
+
+    private:
+        template<typename K>
+        size_t lower_index(const K& key) const
+        {
+            return detail::branchless_lower_bound(_keys.begin(), _keys.size(), key, _comp);
+        }
+
+        template<typename K>
+        size_t upper_index(const K& key) const
+        {
+            return detail::branchless_upper_bound(_keys.begin(), _keys.size(), key, _comp);
+        }
+
+        template<typename K>
+        const_iterator find_impl(const K& key) const
+        {
+            size_t i = lower_index(key);
+            if (i != _keys.size() && !_comp(key, _keys[i])) return begin() + i;
+            return end();
+        }
+
+        template<typename K>
+        std::pair<const_iterator, bool> emplace_impl(K&& key)
+        {
+            size_t i = lower_index(key);
+            if (i != _keys.size() && !_comp(key, _keys[i])) return {begin() + i, false};
+            _keys.insert(_keys.begin() + i, std::forward<K>(key));
+            return {begin() + i, true};
+        }
+
+    private:
+        tiny::vector<Key> _keys;
+        Compare _comp;
+    };
+
+    template<typename Key, typename Compare>
+    bool operator==(const flat_set<Key, Compare>& a, const flat_set<Key, Compare>& b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+}
@@ -0,0 +1,204 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <map>
+#include <set>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <cassert>
+#include "flat_map.h"
+#include "flat_set.h"
+
+// 1. 基本操作
+void test_flat_map() {
+    tiny::flat_map<int, std::string> m;
+    assert(m.empty() && m.find(1) == m.end());
+
+    m[3] = "three";
+    m[1] = "one";
+    m.try_emplace(2, "two");
+    m.insert({5, "five"});
+    assert(m.size() == 4);
+    assert(!m.try_emplace(1, "uno").second && m.at(1) == "one");
+    m.insert_or_assign(1, "uno");
+    assert(m.at(1) == "uno");
+
+    // 按 key 有序遍历
+    int expected[] = {1, 2, 3, 5};
+    int i = 0;
+    for (auto kv : m) assert(kv.first == expected[i++]);
+
+    assert(m.lower_bound(4)->first == 5);
+    assert(m.upper_bound(3)->first == 5);
+    assert(m.lower_bound(6) == m.end());
+    m.find(2)->second = "deux";
+    assert(m[2] == "deux");
+
+    bool thrown = false;
+    try { m.at(4); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    assert(m.erase(3) == 1 && m.erase(3) == 0);
+    m.erase(m.begin());
+    assert(m.size() == 2 && m.begin()->first == 2);
+
+    const tiny::flat_map<int, std::string>& cm = m;
+    assert(cm.find(5)->second == "five" && cm.contains(2));
+
+    tiny::flat_map<int, std::string> copy(m);
+    assert(copy == m);
+}
+
+// 2. 批量构建与归并插入
+void test_bulk() {
+    // 重复的 key 保留最先出现的
+    std::vector<std::pair<int, int>> input = {{5, 0}, {1, 1}, {5, 2}, {3, 3}, {1, 4}};
+    tiny::flat_map<int, int> m(input.begin(), input.end());
+    assert(m.size() == 3);
+    assert(m.at(1) == 1 && m.at(3) == 3 && m.at(5) == 0);
+
+    // 已有的 key 不被覆盖，新 key 归并到正确位置
+    std::vector<std::pair<int, int>> batch = {{4, 40}, {0, 0}, {5, 50}, {9, 90}, {4, 41}};
+    m.insert(batch.begin(), batch.end());
+    int keys[] = {0, 1, 3, 4, 5, 9};
+    int values[] = {0, 1, 3, 40, 0, 90};
+    assert(m.size() == 6);
+    for (int i = 0; i < 6; ++i) {
+        assert(m.keys()[i] == keys[i]);
+        assert(m.values()[i] == values[i]);
+    }
+
+    tiny::flat_set<int> s = {9, 3, 7, 3, 1};
+    assert(s.size() == 4 && s[0] == 1 && s[3] == 9);
+    s.insert({8, 2, 7, 10});
+    int sorted[] = {1, 2, 3, 7, 8, 9, 10};
+    assert(s.size() == 7);
+    for (int i = 0; i < 7; ++i) assert(s[i] == sorted[i]);
+}
+
+// 3. 透明比较器：std::string 键用 string_view 查找
+void test_heterogeneous_lookup() {
+    tiny::flat_map<std::string, int, std::less<>> m = {{"route/a", 1}, {"route/b", 2}};
+    std::string_view key = "route/b";
+    assert(m.find(key)->second == 2);
+    assert(m.contains("route/a") && !m.contains("route/c"));
+
+    tiny::flat_set<std::string, std::less<>> s = {"x", "y"};
+    assert(s.contains(std::string_view("y")) && s.find("z") == s.end());
+}
+
+// 4. flat_set 基本操作
+void test_flat_set() {
+    tiny::flat_set<int> s;
+    assert(s.insert(5).second && s.insert(1).second && !s.insert(5).second);
+    s.emplace(3);
+    assert(s.size() == 3 && *s.begin() == 1);
+    assert(*s.lower_bound(2) == 3 && *s.upper_bound(3) == 5);
+    auto range = s.equal_range(3);
+    assert(range.second - range.first == 1);
+    assert(s.erase(3) == 1 && !s.contains(3));
+    s.erase(s.begin(), s.end());
+    assert(s.empty());
+}
+
+// 5. 随机操作，与 std::map / std::set 对比
+void test_random_against_std() {
+    std::mt19937 rng(11);
+    tiny::flat_map<int, int> m;
+    std::map<int, int> ref;
+    tiny::flat_set<int> s;
+    std::set<int> sref;
+
+    for (int step = 0; step < 20000; ++step) {
+        int key = int(rng() % 2000);
+        switch (rng() % 5) {
+        case 0:
+            m[key] = step;
+            ref[key] = step;
+            s.insert(key);
+            sref.insert(key);
+            break;
+        case 1:
+            assert(m.erase(key) == ref.erase(key));
+            assert(s.erase(key) == sref.erase(key));
+            break;
+        case 2: {
+            std::vector<std::pair<int, int>> batch;
+            std::vector<int> keys;
+            for (int k = 0; k < 20; ++k) {
+                int bk = int(rng() % 2000);
+                batch.push_back({bk, step});
+                keys.push_back(bk);
+            }
+            m.insert(batch.begin(), batch.end());
+            ref.insert(batch.begin(), batch.end());
+            s.insert(keys.begin(), keys.end());
+            sref.insert(keys.begin(), keys.end());
+            break;
+        }
+        default: {
+            auto it = m.lower_bound(key);
+            auto rit = ref.lower_bound(key);
+            assert((it == m.end()) == (rit == ref.end()));
+            if (rit != ref.end()) assert(it->first == rit->first && it->second == rit->second);
+            assert(s.contains(key) == (sref.count(key) == 1));
+            break;
+        }
+        }
+        assert(m.size() == ref.size() && s.size() == sref.size());
+    }
+
+    auto rit = ref.begin();
+    for (auto kv : m) {
+        assert(kv.first == rit->first && kv.second == rit->second);
+        ++rit;
+    }
+    assert(std::equal(s.begin(), s.end(), sref.begin()));
+}
+
+// 6. key 引用 values 里的元素；插入 key 抛异常时 keys/values 保持一致
+struct throwing_key {
+    static inline bool throw_on_move = false;
+    int v;
+    throwing_key(int x) : v(x) {}
+    throwing_key(const throwing_key&) = default;
+    throwing_key(throwing_key&& o) : v(o.v) { if (throw_on_move) throw std::runtime_error("move"); }
+    throwing_key& operator=(const throwing_key&) = default;
+    throwing_key& operator=(throwing_key&& o) { v = o.v; return *this; }
+    bool operator<(const throwing_key& o) const { return v < o.v; }
+};
+
+void test_aliasing_insert() {
+    tiny::flat_map<std::string, std::string> chain;
+    chain["k0"] = "k1";
+    for (int i = 1; i < 200; ++i) chain[chain.at("k" + std::to_string(i - 1))] = "k" + std::to_string(i + 1);
+    assert(chain.size() == 200);
+    for (int i = 0; i < 200; ++i) assert(chain.at("k" + std::to_string(i)) == "k" + std::to_string(i + 1));
+
+    tiny::flat_map<throwing_key, int> m;
+    for (int i = 0; i < 10; ++i) m.try_emplace(throwing_key(i * 2), i);
+    throwing_key::throw_on_move = true;
+    const throwing_key key(5);
+    bool thrown = false;
+    try {
+        m.try_emplace(key, 5);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    throwing_key::throw_on_move = false;
+    assert(thrown);
+    assert(m.size() == 10 && m.keys().size() == m.values().size());
+    for (int i = 0; i < 10; ++i) assert(m.at(throwing_key(i * 2)) == i);
+}
+
+int main() {
+    test_flat_map();
+    test_bulk();
+    test_heterogeneous_lookup();
+    test_flat_set();
+    test_random_against_std();
+    test_aliasing_insert();
+    std::cout << "all flat_map tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,350 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 容器分配统计，编译期开关：
+//   编译时定义 TINY_INSTRUMENTATION 才会记录；否则所有钩子都是空的内联函数，
+//   统计对象、注册表、原子操作都不会被实例化，零开销
+//
+// 统计维度：
+//   按容器类型   每个 tiny::vector<T> / tiny::string / tiny::list<T> 各一份
+//   按调用点标签 instrument::scope s("parse_request"); 作用域内本线程的分配额外记到这个标签下
+//
+// 导出：instrument::write_json(os) / instrument::write_prometheus(os)
+
+namespace tiny::instrument {
+
+#ifdef TINY_INSTRUMENTATION
+    inline constexpr bool enabled = true;
+#else
+    inline constexpr bool enabled = false;
+#endif
+
+    struct stats
+    {
+        std::string name;
+        bool is_tag = false;
+
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> deallocations{ 0 };
+        std::atomic<uint64_t> bytes_allocated{ 0 };
+        std::atomic<uint64_t> bytes_freed{ 0 };
+        std::atomic<uint64_t> reallocations{ 0 };    // 扩容时换了一块新内存
+        std::atomic<uint64_t> elements_moved{ 0 };   // 扩容时搬过去的元素
+        std::atomic<uint64_t> elements_copied{ 0 };  // 拷贝构造/赋值与 string 扩容时拷贝的元素
+        std::atomic<uint64_t> peak_capacity{ 0 };    // 单个容器见过的最大容量（元素个数，list 为节点数）
+
+        stats* next = nullptr;
+
+        void reset()
+        {
+            allocations = deallocations = bytes_allocated = bytes_freed = 0;
+            reallocations = elements_moved = elements_copied = peak_capacity = 0;
+        }
+    };
+
+    namespace detail {
+
+        // 从编译器生成的函数签名里截出类型名
+        template<typename T>
+        std::string_view type_name()
+        {
+#if defined(__clang__) || defined(__GNUC__)
+            std::string_view sig = __PRETTY_FUNCTION__;
+            size_t start = sig.find("T = ");
+            if (start == std::string_view::npos) return "unknown";
+            start += 4;
+            size_t end = sig.find_first_of(";]", start);
+            return sig.substr(start, end - start);
+#elif defined(_MSC_VER)
+            std::string_view sig = __FUNCSIG__;
+            size_t start = sig.find("type_name<");
+            if (start == std::string_view::npos) return "unknown";
+            start += 10;
+            size_t end = sig.rfind(">(");
+            return sig.substr(start, end - start);
+#else
+            return "unknown";
+#endif
+        }
+
+        // 所有统计对象串成单链表，只在注册与导出时加锁
+        class registry
+        {
+        public:
+            static registry& instance()
+            {
+                static registry r;
+                return r;
+            }
+
+            void add(stats* s)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                s->next = _head;
+                _head = s;
+            }
+
+            stats* find_or_create_tag(std::string_view name)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (stats* s = _head; s; s = s->next)
+                {
+                    if (s->is_tag && s->name == name) return s;
+                }
+                auto& owned = _tags.emplace_back(std::make_unique<stats>());
+                owned->name = std::string(name);
+                owned->is_tag = true;
+                owned->next = _head;
+                _head = owned.get();
+                return _head;
+            }
+
+            template<typename Fn>
+            void for_each(Fn&& fn)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (stats* s = _head; s; s = s->next) fn(*s);
+            }
+
+        private:
+            std::mutex _mutex;
+            stats* _head = nullptr;
+            std::vector<std::unique_ptr<stats>> _tags;   // 标签统计由注册表持有
+        };
+
+        template<typename Container>
+        stats& stats_for()
+        {
+            static stats* s = []
+            {
+                static stats instance;
+                instance.name = std::string(type_name<Container>());
+                registry::instance().add(&instance);
+                return &instance;
+            }();
+            return *s;
+        }
+
+        inline stats*& current_tag()
+        {
+            thread_local stats* tag = nullptr;
+            return tag;
+        }
+
+        inline void update_max(std::atomic<uint64_t>& target, uint64_t value)
+        {
+            uint64_t cur = target.load(std::memory_order_relaxed);
+            while (cur < value && !target.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+        }
+
+        // 同时记到类型统计与当前线程的标签统计上
+        template<typename Container, typename Fn>
+        void record(Fn&& fn)
+        {
+            fn(stats_for<Container>());
+            if (stats* tag = current_tag()) fn(*tag);
+        }
+    }
+
+    // 分配了一块 bytes 字节、能放 capacity 个元素的内存
+    template<typename Container>
+    inline void on_allocate([[maybe_unused]] size_t bytes, [[maybe_unused]] size_t capacity)
+    {
+        if constexpr (enabled)
+        {
+            detail::record<Container>([&](stats& s)
+            {
+                s.allocations.fetch_add(1, std::memory_order_relaxed);
+                s.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+                detail::update_max(s.peak_capacity, capacity);
+            });
+        }
+    }
+
+    template<typename Container>
+    inline void on_deallocate([[maybe_unused]] size_t bytes)
+    {
+        if constexpr (enabled)
+        {
+            detail::record<Container>([&](stats& s)
+            {
+                s.deallocations.fetch_add(1, std::memory_order_relaxed);
+                s.bytes_freed.fetch_add(bytes, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    // 扩容：旧内存里的元素被移动（或拷贝）到新内存
+    template<typename Container>
+    inline void on_reallocate([[maybe_unused]] size_t moved, [[maybe_unused]] size_t copied)
+    {
+        if constexpr (enabled)
+        {
+            detail::record<Container>([&](stats& s)
+            {
+                s.reallocations.fetch_add(1, std::memory_order_relaxed);
+                s.elements_moved.fetch_add(moved, std::memory_order_relaxed);
+                s.elements_copied.fetch_add(copied, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    template<typename Container>
+    inline void on_copy([[maybe_unused]] size_t copied)
+    {
+        if constexpr (enabled)
+        {
+            detail::record<Container>([&](stats& s)
+            {
+                s.elements_copied.fetch_add(copied, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    // 调用点标签：作用域内本线程的分配额外记到 name 下，可以嵌套
+    // name 按内容区分，同名的作用域共用一份统计
+    class scope
+    {
+    public:
+        explicit scope([[maybe_unused]] std::string_view name)
+        {
+            if constexpr (enabled)
+            {
+                _previous = detail::current_tag();
+                detail::current_tag() = detail::registry::instance().find_or_create_tag(name);
+            }
+        }
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+        ~scope()
+        {
+            if constexpr (enabled) detail::current_tag() = _previous;
+        }
+
+    private:
+        stats* _previous = nullptr;
+    };
+
+    // 按名字（标签名或类型名）取统计，没有时返回 nullptr
+    inline const stats* find([[maybe_unused]] std::string_view name)
+    {
+        const stats* found = nullptr;
+        if constexpr (enabled)
+        {
+            detail::registry::instance().for_each([&](const stats& s)
+            {
+                if (!found && s.name == name) found = &s;
+            });
+        }
+        return found;
+    }
+
+    template<typename Container>
+    const stats* find()
+    {
+        if constexpr (enabled) return &detail::stats_for<Container>();
+        else return nullptr;
+    }
+
+    inline void reset()
+    {
+        if constexpr (enabled)
+        {
+            detail::registry::instance().for_each([](stats& s) { s.reset(); });
+        }
+    }
+
+    namespace detail {
+        inline void write_escaped(std::ostream& os, std::string_view text)
+        {
+            for (char c : text)
+            {
+                if (c == '"' || c == '\\') os << '\\';
+                os << c;
+            }
+        }
+
+        template<typename Fn>
+        void for_each_field(const stats& s, Fn&& fn)
+        {
+            fn("allocations", "counter", s.allocations.load(std::memory_order_relaxed));
+            fn("deallocations", "counter", s.deallocations.load(std::memory_order_relaxed));
+            fn("bytes_allocated", "counter", s.bytes_allocated.load(std::memory_order_relaxed));
+            fn("bytes_freed", "counter", s.bytes_freed.load(std::memory_order_relaxed));
+            fn("reallocations", "counter", s.reallocations.load(std::memory_order_relaxed));
+            fn("elements_moved", "counter", s.elements_moved.load(std::memory_order_relaxed));
+            fn("elements_copied", "counter", s.elements_copied.load(std::memory_order_relaxed));
+            fn("peak_capacity", "gauge", s.peak_capacity.load(std::memory_order_relaxed));
+        }
+    }
+
+    // {"containers":[{"name":"tiny::vector<int>","allocations":3,...}],"tags":[...]}
+    inline void write_json(std::ostream& os)
+    {
+        bool first[2] = { true, true };
+        os << "{\"containers\":[";
+        if constexpr (enabled)
+        {
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                if (pass == 1) os << "],\"tags\":[";
+                detail::registry::instance().for_each([&](const stats& s)
+                {
+                    if (s.is_tag != (pass == 1)) return;
+                    if (!first[pass]) os << ',';
+                    first[pass] = false;
+                    os << "{\"name\":\"";
+                    detail::write_escaped(os, s.name);
+                    os << '"';
+                    detail::for_each_field(s, [&](const char* field, const char*, uint64_t value)
+                    {
+                        os << ",\"" << field << "\":" << value;
+                    });
+                    os << '}';
+                });
+            }
+        }
+        else
+        {
+            os << "],\"tags\":[";
+        }
+        os << "]}";
+    }
+
+    // Prometheus 文本格式，容器类型用 container 标签，调用点用 tag 标签：
+    //   tiny_container_allocations_total{container="tiny::vector<int>"} 3
+    inline void write_prometheus(std::ostream& os)
+    {
+        if constexpr (enabled)
+        {
+            // 每个指标先写一次 TYPE，再写各个序列
+            stats probe;
+            detail::for_each_field(probe, [&](const char* field, const char* type, uint64_t)
+            {
+                const bool counter = std::string_view(type) == "counter";
+                os << "# TYPE tiny_container_" << field << (counter ? "_total " : " ") << type << '\n';
+                detail::registry::instance().for_each([&](const stats& s)
+                {
+                    detail::for_each_field(s, [&](const char* f, const char*, uint64_t value)
+                    {
+                        if (std::string_view(f) != field) return;
+                        os << "tiny_container_" << field << (counter ? "_total" : "")
+                           << '{' << (s.is_tag ? "tag" : "container") << "=\"";
+                        detail::write_escaped(os, s.name);
+                        os << "\"} " << value << '\n';
+                    });
+                });
+            });
+        }
+    }
+}
@@ -0,0 +1,104 @@
+// 编译时需要打开统计：
+//   g++ -std=c++20 -DTINY_INSTRUMENTATION -pthread instrument/test.cpp
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <cassert>
+#include "instrument.h"
+#include "../vector/vector.h"
+#include "../string/string.h"
+#include "../list/list.h"
+
+static_assert(tiny::instrument::enabled, "compile with -DTINY_INSTRUMENTATION");
+
+namespace ins = tiny::instrument;
+
+// 1. 按容器类型统计
+void test_per_type() {
+    ins::reset();
+    {
+        tiny::vector<int> v;
+        for (int i = 0; i < 100; ++i) v.push_back(i);   // 4 8 16 32 64 128
+        tiny::vector<int> copy(v);
+        (void)copy;
+    }
+    const ins::stats* s = ins::find<tiny::vector<int>>();
+    assert(s && s->name == "tiny::vector<int>");
+    assert(s->allocations == 7 && s->deallocations == 7);
+    assert(s->bytes_allocated == s->bytes_freed);
+    assert(s->reallocations == 5);                    // 第一次分配不算
+    assert(s->elements_moved == 4 + 8 + 16 + 32 + 64);
+    assert(s->elements_copied == 100);
+    assert(s->peak_capacity == 128);
+
+    {
+        tiny::string str("abc");
+        for (int i = 0; i < 20; ++i) str.push_back('x');
+    }
+    const ins::stats* ss = ins::find<tiny::string>();
+    assert(ss->reallocations > 0 && ss->elements_copied > 0 && ss->allocations == ss->deallocations);
+
+    {
+        tiny::list<double> l;
+        for (int i = 0; i < 10; ++i) l.push_back(i);
+        l.pop_front();
+    }
+    const ins::stats* ls = ins::find<tiny::list<double>>();
+    assert(ls->allocations == 10 && ls->deallocations == 10 && ls->peak_capacity == 10);
+    assert(ins::find("tiny::list<double>") == ls);
+}
+
+// 2. 调用点标签：只记录作用域内、本线程的分配
+void test_tags() {
+    ins::reset();
+    {
+        ins::scope tag("parse_request");
+        tiny::vector<int> v;
+        v.reserve(10);
+        {
+            ins::scope inner("build_reply");
+            tiny::string reply("ok");
+        }
+        std::thread other([] { tiny::vector<int> w(50, 1); });   // 其他线程不受影响
+        other.join();
+    }
+    tiny::vector<int> outside(5, 0);
+
+    const ins::stats* parse = ins::find("parse_request");
+    const ins::stats* reply = ins::find("build_reply");
+    assert(parse && parse->is_tag && parse->allocations == 1 && parse->bytes_allocated == 10 * sizeof(int));
+    assert(reply && reply->allocations == 1 && reply->deallocations == 1);
+    assert(ins::find<tiny::vector<int>>()->allocations == 3);
+}
+
+// 3. 导出格式
+void test_dump() {
+    ins::reset();
+    {
+        ins::scope tag("dump \"quoted\"");
+        tiny::vector<int> v(3, 1);
+    }
+    std::ostringstream json;
+    ins::write_json(json);
+    const std::string j = json.str();
+    assert(j.rfind("{\"containers\":[", 0) == 0 && j.back() == '}');
+    assert(j.find("{\"name\":\"tiny::vector<int>\",\"allocations\":1,") != std::string::npos);
+    assert(j.find("\"tags\":[") != std::string::npos);
+    assert(j.find("dump \\\"quoted\\\"") != std::string::npos);
+
+    std::ostringstream prom;
+    ins::write_prometheus(prom);
+    const std::string p = prom.str();
+    assert(p.find("# TYPE tiny_container_allocations_total counter\n") != std::string::npos);
+    assert(p.find("# TYPE tiny_container_peak_capacity gauge\n") != std::string::npos);
+    assert(p.find("tiny_container_allocations_total{container=\"tiny::vector<int>\"} 1\n") != std::string::npos);
+    assert(p.find("tiny_container_bytes_allocated_total{tag=\"dump \\\"quoted\\\"\"} 12\n") != std::string::npos);
+}
+
+int main() {
+    test_per_type();
+    test_tags();
+    test_dump();
+    std::cout << "all instrument tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,369 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+namespace tiny{
+    // 侵入式链表的挂钩：prev/next 直接嵌在用户对象里
+    // 一个对象里放多个 list_hook 就能同时挂在多条链表上
+    struct list_hook
+    {
+        list_hook() :prev(nullptr), next(nullptr) {}
+
+        // 挂钩只描述"在哪条链表里"，拷贝对象时不应该把链接关系也拷过去
+        list_hook(const list_hook&) :prev(nullptr), next(nullptr) {}
+        list_hook& operator=(const list_hook&) { return *this; }
+
+        bool is_linked() const
+        {
+            return next != nullptr;
+        }
+
+        list_hook* prev;
+        list_hook* next;
+    };
+
+    template<typename T, list_hook T::* Hook>
+    class intrusive_list;
+
+    template<typename T, list_hook T::* Hook, class Ref, class Ptr>
+    struct IntrusiveListIterator
+    {
+        typedef IntrusiveListIterator<T, Hook, Ref, Ptr> Self;
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Ptr;
+        using reference = Ref;
+
+        list_hook* _node;
+
+        IntrusiveListIterator(list_hook* node = nullptr)
+            :_node(node)
+        {}
+
+        // iterator 可以隐式转换成 const_iterator
+        template<class Ref_other, class Ptr_other>
+        IntrusiveListIterator(const IntrusiveListIterator<T, Hook, Ref_other, Ptr_other>& it)
+            :_node(it._node)
+        {}
+
+        Ref operator*() const
+        {
+            return *intrusive_list<T, Hook>::to_value(_node);
+        }
+
+        Ptr operator->() const
+        {
+            return intrusive_list<T, Hook>::to_value(_node);
+        }
+
+        Self& operator++()
+        {
+            _node = _node->next;
+            return *this;
+        }
+
+        Self operator++(int)
+        {
+            Self tmp(*this);
+            _node = _node->next;
+            return tmp;
+        }
+
+        Self& operator--()
+        {
+            _node = _node->prev;
+            return *this;
+        }
+
+        Self operator--(int)
+        {
+            Self tmp(*this);
+            _node = _node->prev;
+            return tmp;
+        }
+
+        template<class Ref_other, class Ptr_other>
+        bool operator!=(const IntrusiveListIterator<T, Hook, Ref_other, Ptr_other>& it) const
+        {
+            return _node != it._node;
+        }
+
+        template<class Ref_other, class Ptr_other>
+        bool operator==(const IntrusiveListIterator<T, Hook, Ref_other, Ptr_other>& it) const
+        {
+            return _node == it._node;
+        }
+    };
+
+    // 侵入式双向循环链表
+    // 链表不拥有元素：插入不分配内存，析构/clear 只解除链接，不释放对象
+    // 用法：
+    //   struct Conn { list_hook idle; list_hook timeout; ... };
+    //   tiny::intrusive_list<Conn, &Conn::idle> idle_list;
+    template<typename T, list_hook T::* Hook>
+    class intrusive_list
+    {
+    public:
+        using iterator = IntrusiveListIterator<T, Hook, T&, T*>;
+        using const_iterator = IntrusiveListIterator<T, Hook, const T&, const T*>;
+
+        intrusive_list()
+        {
+            _root.next = &_root;
+            _root.prev = &_root;
+        }
+
+        // 元素只能挂在一条同名链表上，所以不允许拷贝
+        intrusive_list(const intrusive_list&) = delete;
+        intrusive_list& operator=(const intrusive_list&) = delete;
+
+        intrusive_list(intrusive_list&& other)
+            :intrusive_list()
+        {
+            splice(end(), other);
+        }
+
+        intrusive_list& operator=(intrusive_list&& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                splice(end(), other);
+            }
+            return *this;
+        }
+
+        ~intrusive_list()
+        {
+            clear();
+        }
+
+        // 解除所有元素的链接，元素本身的生命周期归用户管理
+        void clear()
+        {
+            list_hook* cur = _root.next;
+            while (cur != &_root)
+            {
+                list_hook* next = cur->next;
+                cur->prev = nullptr;
+                cur->next = nullptr;
+                cur = next;
+            }
+            _root.next = &_root;
+            _root.prev = &_root;
+            _size = 0;
+        }
+
+        iterator begin()
+        {
+            return iterator(_root.next);
+        }
+
+        iterator end()
+        {
+            return iterator(&_root);
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(_root.next);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(const_cast<list_hook*>(&_root));
+        }
+
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        // 由元素引用直接得到迭代器，O(1)
+        iterator iterator_to(T& value)
+        {
+            assert((value.*Hook).is_linked());
+            return iterator(&(value.*Hook));
+        }
+
+        const_iterator iterator_to(const T& value) const
+        {
+            assert((value.*Hook).is_linked());
+            return const_iterator(const_cast<list_hook*>(&(value.*Hook)));
+        }
+
+        iterator insert(const_iterator pos, T& value)
+        {
+            assert(pos._node != nullptr);
+
+            list_hook* node = &(value.*Hook);
+            assert(!node->is_linked()); // 同一个挂钩不能同时在两条链表里
+
+            link_before(pos._node, node);
+            ++_size;
+
+            return iterator(node);
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            assert(pos._node != &_root);
+
+            list_hook* cur = pos._node;
+            list_hook* next = cur->next;
+            unlink(cur);
+            --_size;
+
+            return iterator(next);
+        }
+
+        // 由元素引用直接摘除，O(1)
+        void erase(T& value)
+        {
+            erase(iterator_to(value));
+        }
+
+        // 把 other 中的 value 移动到本链表 pos 之前，O(1)
+        void splice(const_iterator pos, intrusive_list& other, T& value)
+        {
+            list_hook* node = &(value.*Hook);
+            assert(node->is_linked());
+
+            // 同一条链表内且位置不变
+            if (&other == this && (node == pos._node || node->next == pos._node)) return;
+
+            other.unlink(node);
+            --other._size;
+            link_before(pos._node, node);
+            ++_size;
+        }
+
+        // 把 other 的全部元素移动到本链表 pos 之前，O(1)
+        void splice(const_iterator pos, intrusive_list& other)
+        {
+            if (&other == this || other.empty()) return;
+
+            list_hook* first = other._root.next;
+            list_hook* last = other._root.prev;
+            other._root.next = &other._root;
+            other._root.prev = &other._root;
+
+            list_hook* cur = pos._node;
+            list_hook* prev = cur->prev;
+            prev->next = first;
+            first->prev = prev;
+            last->next = cur;
+            cur->prev = last;
+
+            _size += other._size;
+            other._size = 0;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+        T& front()
+        {
+            assert(!empty());
+            return *to_value(_root.next);
+        }
+
+        T& back()
+        {
+            assert(!empty());
+            return *to_value(_root.prev);
+        }
+
+        const T& front() const
+        {
+            assert(!empty());
+            return *to_value(_root.next);
+        }
+
+        const T& back() const
+        {
+            assert(!empty());
+            return *to_value(_root.prev);
+        }
+
+        void push_back(T& value)
+        {
+            insert(end(), value);
+        }
+
+        void push_front(T& value)
+        {
+            insert(begin(), value);
+        }
+
+        void pop_back()
+        {
+            assert(!empty());
+            erase(--end());
+        }
+
+        void pop_front()
+        {
+            assert(!empty());
+            erase(begin());
+        }
+
+        // 挂钩地址 -> 对象地址
+        static T* to_value(list_hook* node)
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<char*>(node) - hook_offset());
+        }
+
+        static const T* to_value(const list_hook* node)
+        {
+            return reinterpret_cast<const T*>(reinterpret_cast<const char*>(node) - hook_offset());
+        }
+
+    private:
+        static size_t hook_offset()
+        {
+            // 在一块未构造的对齐内存上求成员偏移，只做地址运算，不访问对象
+            alignas(T) static char probe[sizeof(T)];
+            T* p = reinterpret_cast<T*>(probe);
+            static const size_t offset =
+                reinterpret_cast<char*>(&(p->*Hook)) - reinterpret_cast<char*>(p);
+            return offset;
+        }
+
+        static void link_before(list_hook* cur, list_hook* node)
+        {
+            list_hook* prev = cur->prev;
+            node->next = cur;
+            node->prev = prev;
+            prev->next = node;
+            cur->prev = node;
+        }
+
+        static void unlink(list_hook* node)
+        {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            node->prev = nullptr;
+            node->next = nullptr;
+        }
+
+    private:
+        list_hook _root;
+        size_t _size = 0;
+    };
+}
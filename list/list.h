@@ -1,14 +1,26 @@
 #pragma once
 #include<cassert>
+#include<cstddef>
+#include<utility>
+#include "../memory/memory_resource.h"
+#include "../instrument/instrument.h"
 
 namespace tiny{
+    // 哨兵节点只有前后指针，不携带 T：
+    // 不要求 T 可默认构造，空链表也不为 T 付出任何空间
+    struct ListNodeBase
+    {
+        ListNodeBase() :prev(nullptr), next(nullptr) {}
+        ListNodeBase* prev;
+        ListNodeBase* next;
+    };
+
     template<typename T>
-    struct ListNode
+    struct ListNode : ListNodeBase
     {
-        ListNode() :prev(nullptr), next(nullptr), data(T()) {}
-        ListNode(const T& value) :prev(nullptr), next(nullptr), data(value) {}
-        ListNode<T>* prev;
-        ListNode<T>* next;
+        // 原地构造数据，push_back/emplace 都走这里
+        template<typename... Args>
+        ListNode(Args&&... args) :data(std::forward<Args>(args)...) {}
         T data;
     };
 
@@ -20,24 +32,30 @@ namespace tiny{
 
 		typedef ListIterator<T, Ref, Ptr> Self;
 
-		Node* _node;
+		ListNodeBase* _node;
 
-		ListIterator(Node* node)
+		ListIterator(ListNodeBase* node)
 			:_node(node)
 		{}
 
+		// iterator 可以隐式转换成 const_iterator
+		template<class Ref_other, class Ptr_other>
+		ListIterator(const ListIterator<T, Ref_other, Ptr_other>& it)
+			:_node(it._node)
+		{}
+
 		// *it
 		//T& operator*()
-		Ref operator*()
+		Ref operator*() const
 		{
-			return _node->data;
+			return static_cast<Node*>(_node)->data;
 		}
 		
 		// it->
 		//T* operator->()
-		Ptr operator->()
+		Ptr operator->() const
 		{
-			return &_node->data;
+			return &static_cast<Node*>(_node)->data;
 		}
 
 		// ++it
@@ -92,26 +110,37 @@ namespace tiny{
         using iterator = ListIterator<T, T&, T*>;
         using const_iterator = ListIterator<T, const T&, const T*>;
 
+        // 哨兵直接嵌在 list 对象里，空链表不做任何堆分配
         list()
         {
-            _head = new Node;
-            _head->next = _head;
-            _head->prev = _head;
-            _head->data = T();
+            _head.next = &_head;
+            _head.prev = &_head;
         }
 
-        list(const list<T>& l)
+        // 节点从 r 分配；不传时使用 get_default_resource()
+        explicit list(memory_resource* r)
+            :list()
         {
-            _head = new Node;
-            _head->next = _head;
-            _head->prev = _head;
-            _head->data = T();
-            _size = 0;
+            assert(r);
+            _resource = r;
+        }
 
-            for (Node* cur = l._head->next; cur != l._head; cur = cur->next)
+        // 拷贝得到的新链表使用默认资源
+        list(const list<T>& l)
+            :list()
+        {
+            for (const T& item : l)
             {
-                push_back(cur->data);
+                push_back(item);
             }
+            instrument::on_copy<list<T>>(l.size());
+        }
+
+        // 移动只需要把首尾节点改挂到新的哨兵上，O(1)，资源一起带走
+        list(list<T>&& l) noexcept
+            :list(l._resource)
+        {
+            steal(l);
         }
 
         list& operator=(const list<T>& other)
@@ -124,6 +153,30 @@ namespace tiny{
                 {
                     push_back(item);
                 }
+                instrument::on_copy<list<T>>(other.size());
+            }
+
+            return *this;
+        }
+
+        // 赋值不改变自己的资源：资源相同才能直接接管节点，否则逐个移动元素
+        list& operator=(list<T>&& other)
+        {
+            if(this != &other)
+            {
+                clear();
+                if (*_resource == *other._resource)
+                {
+                    steal(other);
+                }
+                else
+                {
+                    for (T& item : other)
+                    {
+                        push_back(std::move(item));
+                    }
+                    other.clear();
+                }
             }
 
             return *this;
@@ -132,61 +185,77 @@ namespace tiny{
         ~list()
         {
             clear();
-            delete _head;
-            _head = nullptr;
         }
 
         void clear()
         {
-            Node* cur = _head->next;
-            while (cur != _head)
+            ListNodeBase* cur = _head.next;
+            while (cur != &_head)
             {
-                Node* next = cur->next;
-                delete cur;
+                ListNodeBase* next = cur->next;
+                destroy_node_(static_cast<Node*>(cur));
                 cur = next;
             }
-            _head->next = _head;
-            _head->prev = _head;
+            _head.next = &_head;
+            _head.prev = &_head;
             _size = 0;
         }
+
+        // 节点与资源一起交换
+        void swap(list<T>& other) noexcept
+        {
+            if (this == &other) return;
+            list<T> tmp(other._resource);
+            tmp.steal(other);
+            other.steal(*this);
+            steal(tmp);
+            std::swap(_resource, other._resource);
+        }
+
+        memory_resource* resource() const
+        {
+            return _resource;
+        }
         
         iterator begin()
         {
-            return iterator(_head->next);
+            return iterator(_head.next);
         }
 
         iterator end()
         {
-            return iterator(_head);
+            return iterator(&_head);
         }
 
         const_iterator begin() const
         {
-            return const_iterator(_head->next);
+            return const_iterator(_head.next);
         }
 
         const_iterator end() const
         {
-            return const_iterator(_head);
+            return const_iterator(const_cast<ListNodeBase*>(&_head));
         }
 
         const_iterator cbegin() const
         {
-            return const_iterator(_head->next);
+            return begin();
         }
 
         const_iterator cend() const
         {
-            return const_iterator(_head);
+            return end();
         }
 
-        iterator insert(iterator pos, const T& value)
+        // 在 pos 之前原地构造一个元素
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
         {
             assert(pos._node != nullptr);
 
-            Node* newnode = new Node(value);
-            Node* cur = pos._node;
-            Node* prev = cur->prev;
+            Node* newnode = create_node_(std::forward<Args>(args)...);
+            ListNodeBase* cur = pos._node;
+            ListNodeBase* prev = cur->prev;
             newnode->next = cur;
             newnode->prev = prev;
             prev->next = newnode;
@@ -196,18 +265,28 @@ namespace tiny{
             return iterator(newnode);
         }
 
+        iterator insert(const_iterator pos, const T& value)
+        {
+            return emplace(pos, value);
+        }
 
-        iterator erase(iterator pos)
+        iterator insert(const_iterator pos, T&& value)
         {
-            assert(pos._node != _head);
+            return emplace(pos, std::move(value));
+        }
 
-            Node* cur = pos._node;
-            Node* prev = cur->prev;
-            Node* next = cur->next;
+
+        iterator erase(const_iterator pos)
+        {
+            assert(pos._node != &_head);
+
+            ListNodeBase* cur = pos._node;
+            ListNodeBase* prev = cur->prev;
+            ListNodeBase* next = cur->next;
 
             prev->next = next;
             next->prev = prev;
-            delete cur;
+            destroy_node_(static_cast<Node*>(cur));
 
             --_size;
 
@@ -227,36 +306,103 @@ namespace tiny{
         T& front()
         {
             assert(!empty());
-            return _head->next->data;
+            return static_cast<Node*>(_head.next)->data;
         }
         T& back()
         {
             assert(!empty());
-            return _head->prev->data;
+            return static_cast<Node*>(_head.prev)->data;
         }
 
         const T& front() const
         {
             assert(!empty());
-            return _head->next->data;
+            return static_cast<const Node*>(_head.next)->data;
         }
 
         const T& back() const
         {
             assert(!empty());
-            return _head->prev->data;
+            return static_cast<const Node*>(_head.prev)->data;
         }
 
 
 
         void push_back(const T& value)
         {
-            insert(end(), value);
+            emplace(end(), value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace(end(), std::move(value));
         }
 
         void push_front(const T& value)
         {
-            insert(begin(), value);
+            emplace(begin(), value);
+        }
+
+        void push_front(T&& value)
+        {
+            emplace(begin(), std::move(value));
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            return *emplace(end(), std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        T& emplace_front(Args&&... args)
+        {
+            return *emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        // 把 other 中 it 指向的节点移动到本链表 pos 之前，不拷贝不分配，O(1)
+        // other 可以就是 *this，此时相当于调整节点位置
+        void splice(const_iterator pos, list<T>& other, const_iterator it)
+        {
+            assert(it._node != &other._head);
+            assert(*_resource == *other._resource);  // 节点要由同一个资源释放
+
+            ListNodeBase* node = it._node;
+            ListNodeBase* cur = pos._node;
+            if (node == cur || node->next == cur) return; // 位置不变
+
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+            --other._size;
+
+            ListNodeBase* prev = cur->prev;
+            node->next = cur;
+            node->prev = prev;
+            prev->next = node;
+            cur->prev = node;
+            ++_size;
+        }
+
+        // 把 other 的全部节点移动到本链表 pos 之前，O(1)
+        void splice(const_iterator pos, list<T>& other)
+        {
+            if (&other == this || other.empty()) return;
+            assert(*_resource == *other._resource);
+
+            ListNodeBase* first = other._head.next;
+            ListNodeBase* last = other._head.prev;
+            ListNodeBase* cur = pos._node;
+            ListNodeBase* prev = cur->prev;
+
+            prev->next = first;
+            first->prev = prev;
+            last->next = cur;
+            cur->prev = last;
+            _size += other._size;
+
+            other._head.next = &other._head;
+            other._head.prev = &other._head;
+            other._size = 0;
         }
 
         void pop_back()
@@ -274,8 +420,50 @@ namespace tiny{
 
 
     private:
-        Node* _head;
+        template<typename... Args>
+        Node* create_node_(Args&&... args)
+        {
+            instrument::on_allocate<list<T>>(sizeof(Node), _size + 1);
+            void* p = _resource->allocate(sizeof(Node), alignof(Node));
+            try
+            {
+                return new (p) Node(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                _resource->deallocate(p, sizeof(Node), alignof(Node));
+                throw;
+            }
+        }
+
+        void destroy_node_(Node* node)
+        {
+            node->~Node();
+            instrument::on_deallocate<list<T>>(sizeof(Node));
+            _resource->deallocate(node, sizeof(Node), alignof(Node));
+        }
+
+        // 接管 other 的全部节点，要求本链表为空
+        void steal(list<T>& other) noexcept
+        {
+            assert(empty());
+            if (other.empty()) return;
+
+            _head.next = other._head.next;
+            _head.prev = other._head.prev;
+            _head.next->prev = &_head;
+            _head.prev->next = &_head;
+            _size = other._size;
+
+            other._head.next = &other._head;
+            other._head.prev = &other._head;
+            other._size = 0;
+        }
+
+    private:
+        ListNodeBase _head;
         size_t _size = 0;
+        memory_resource* _resource = get_default_resource();
 
     };
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 // 包含你的 list 实现头文件
 #include "list.h"
+#include "intrusive_list.h"
 
 // 一个简单的测试框架，用于打印测试结果
 void run_test(void (*test_func)(), const std::string& test_name) {
@@ -236,6 +237,106 @@ void test_with_complex_type() {
     assert(l2.front() == "你好");
 }
 
+// 7. 测试侵入式链表
+struct Conn {
+    int id;
+    tiny::list_hook idle;
+    tiny::list_hook active;
+    Conn(int i) : id(i) {}
+};
+
+void test_intrusive_list() {
+    Conn a(1), b(2), c(3);
+    tiny::intrusive_list<Conn, &Conn::idle> idle_list;
+    tiny::intrusive_list<Conn, &Conn::idle> timeout_list;
+    tiny::intrusive_list<Conn, &Conn::active> active_list;
+
+    // a. 插入不拷贝，元素就是原对象
+    idle_list.push_back(a);
+    idle_list.push_back(b);
+    idle_list.push_front(c);
+    assert(idle_list.size() == 3);
+    assert(&idle_list.front() == &c && &idle_list.back() == &b);
+    assert(a.idle.is_linked());
+
+    // b. 同一个对象可以同时挂在另一条挂钩的链表上
+    active_list.push_back(a);
+    assert(active_list.size() == 1 && &active_list.front() == &a);
+
+    // c. 由元素引用 O(1) 摘除
+    idle_list.erase(a);
+    assert(!a.idle.is_linked());
+    assert(a.active.is_linked());
+    int expected[] = {3, 2};
+    int i = 0;
+    for (const Conn& conn : idle_list) {
+        assert(conn.id == expected[i++]);
+    }
+    assert(i == 2);
+
+    // d. 在两条链表之间 O(1) 移动单个元素
+    timeout_list.splice(timeout_list.end(), idle_list, b);
+    assert(idle_list.size() == 1 && timeout_list.size() == 1);
+    assert(&timeout_list.front() == &b);
+
+    // e. 整条链表拼接与移动
+    idle_list.splice(idle_list.begin(), timeout_list);
+    assert(timeout_list.empty() && idle_list.size() == 2);
+    assert(&idle_list.front() == &b);
+    tiny::intrusive_list<Conn, &Conn::idle> moved(std::move(idle_list));
+    assert(idle_list.empty() && moved.size() == 2);
+
+    // f. 析构/clear 只解除链接，不释放元素
+    moved.clear();
+    assert(!b.idle.is_linked() && !c.idle.is_linked());
+    active_list.pop_front();
+    assert(!a.active.is_linked());
+}
+
+// 8. 测试移动语义与原地构造
+struct NoDefault {
+    int a;
+    std::string b;
+    NoDefault(int x, const std::string& y) : a(x), b(y) {}
+};
+
+void test_move_and_emplace() {
+    // a. T 不需要默认构造
+    tiny::list<NoDefault> l;
+    l.emplace_back(1, "one");
+    l.emplace_front(0, "zero");
+    l.emplace(l.end(), 2, "two");
+    assert(l.size() == 3);
+    assert(l.front().a == 0 && l.back().b == "two");
+
+    // b. push_back(T&&) 移走源对象
+    tiny::list<std::string> s;
+    std::string big(100, 'x');
+    s.push_back(std::move(big));
+    assert(big.empty());
+    assert(s.front().size() == 100);
+
+    // c. 移动构造 O(1)，源链表变空但可继续使用
+    tiny::list<NoDefault> m(std::move(l));
+    assert(l.empty() && m.size() == 3);
+    l.emplace_back(9, "nine");
+    assert(l.size() == 1);
+
+    // d. 移动赋值
+    l = std::move(m);
+    assert(m.empty() && l.size() == 3);
+    int expected = 0;
+    for (const NoDefault& v : l) {
+        assert(v.a == expected++);
+    }
+
+    // e. swap
+    m.emplace_back(7, "seven");
+    l.swap(m);
+    assert(l.size() == 1 && m.size() == 3);
+    assert(l.front().a == 7 && m.back().a == 2);
+}
+
 int main() {
     run_test(test_constructors_and_assignment, "Constructors and Assignment");
     run_test(test_push_pop_front_back, "Push, Pop, Front, Back");
@@ -243,6 +344,8 @@ int main() {
     run_test(test_insert_and_erase, "Insert and Erase");
     run_test(test_const_correctness, "Const Correctness");
     run_test(test_with_complex_type, "Complex Type (std::string)");
+    run_test(test_intrusive_list, "Intrusive List");
+    run_test(test_move_and_emplace, "Move and Emplace");
 
     std::cout << "========================================" << std::endl;
     std::cout << "      All tests completed successfully! " << std::endl;
@@ -0,0 +1,322 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../list/list.h"
+
+namespace tiny {
+
+    // LRU 缓存：tiny::list 维护最近使用顺序（表头最新，表尾最旧），
+    // 哈希表保存 key -> 链表节点迭代器，get/put/evict 都是 O(1)
+    //
+    // 容量按"权重"计算：默认每个条目权重为 1（即按条目数限制），
+    // 也可以传入 size_function 按字节数等自定义权重限制
+    template<typename K, typename V,
+             typename Hash = std::hash<K>,
+             typename KeyEqual = std::equal_to<K>>
+    class lru_cache
+    {
+    public:
+        using size_function = std::function<size_t(const K&, const V&)>;
+        using evict_callback = std::function<void(const K&, V&)>;
+
+        explicit lru_cache(size_t capacity, size_function weigh = nullptr)
+            : _capacity(capacity), _weigh(std::move(weigh))
+        {
+            assert(capacity > 0);
+        }
+
+        lru_cache(const lru_cache&) = delete;
+        lru_cache& operator=(const lru_cache&) = delete;
+
+        // 淘汰回调：因容量不足或调用 evict() 而淘汰条目时触发，erase/clear 不触发
+        void set_evict_callback(evict_callback cb)
+        {
+            _on_evict = std::move(cb);
+        }
+
+        // 命中时把条目移到表头并返回值的指针，未命中返回 nullptr
+        // 返回的指针在下一次修改缓存之前有效
+        V* get(const K& key)
+        {
+            auto found = _index.find(key);
+            if (found == _index.end()) return nullptr;
+
+            touch(found->second);
+            return &found->second->value;
+        }
+
+        // 只查询不更新最近使用顺序
+        const V* peek(const K& key) const
+        {
+            auto found = _index.find(key);
+            if (found == _index.end()) return nullptr;
+            return &found->second->value;
+        }
+
+        bool contains(const K& key) const
+        {
+            return _index.find(key) != _index.end();
+        }
+
+        // 插入或更新，条目成为最新；之后从表尾淘汰直到总权重不超过容量
+        // 刚插入的条目不会被淘汰，即使它自己就超过了容量
+        template<typename VV>
+        void put(const K& key, VV&& value)
+        {
+            auto found = _index.find(key);
+            if (found != _index.end())
+            {
+                Entry& entry = *found->second;
+                _weight -= entry.weight;
+                entry.value = std::forward<VV>(value);
+                entry.weight = weigh(entry.key, entry.value);
+                _weight += entry.weight;
+                touch(found->second);
+            }
+            else
+            {
+                Entry& entry = _order.emplace_front(key, std::forward<VV>(value));
+                entry.weight = weigh(entry.key, entry.value);
+                _weight += entry.weight;
+                _index.emplace(key, _order.begin());
+            }
+
+            while (_weight > _capacity && _order.size() > 1)
+            {
+                evict();
+            }
+        }
+
+        bool erase(const K& key)
+        {
+            auto found = _index.find(key);
+            if (found == _index.end()) return false;
+
+            _weight -= found->second->weight;
+            _order.erase(found->second);
+            _index.erase(found);
+            return true;
+        }
+
+        // 淘汰最久未使用的条目，缓存为空时返回 false
+        bool evict()
+        {
+            if (_order.empty()) return false;
+
+            Entry& victim = _order.back();
+            if (_on_evict) _on_evict(victim.key, victim.value);
+
+            _weight -= victim.weight;
+            _index.erase(victim.key);
+            _order.pop_back();
+            return true;
+        }
+
+        void clear()
+        {
+            _index.clear();
+            _order.clear();
+            _weight = 0;
+        }
+
+        // 调整容量，缩小时立即淘汰多出的部分
+        void set_capacity(size_t capacity)
+        {
+            assert(capacity > 0);
+            _capacity = capacity;
+            while (_weight > _capacity && !_order.empty())
+            {
+                evict();
+            }
+        }
+
+        bool empty() const { return _order.empty(); }
+        size_t size() const { return _order.size(); }
+        size_t weight() const { return _weight; }
+        size_t capacity() const { return _capacity; }
+
+        // 从最新到最旧遍历 key，不影响顺序
+        template<typename F>
+        void for_each(F&& f) const
+        {
+            for (const Entry& entry : _order)
+            {
+                f(entry.key, entry.value);
+            }
+        }
+
+    private:
+        struct Entry
+        {
+            template<typename VV>
+            Entry(const K& k, VV&& v) : key(k), value(std::forward<VV>(v)), weight(1) {}
+
+            K key;
+            V value;
+            size_t weight;
+        };
+
+        using order_list = list<Entry>;
+        using node_handle = typename order_list::iterator;
+
+        size_t weigh(const K& key, const V& value) const
+        {
+            return _weigh ? _weigh(key, value) : 1;
+        }
+
+        void touch(node_handle it)
+        {
+            _order.splice(_order.begin(), _order, it);
+        }
+
+    private:
+        order_list _order;
+        std::unordered_map<K, node_handle, Hash, KeyEqual> _index;
+        size_t _capacity;
+        size_t _weight = 0;
+        size_function _weigh;
+        evict_callback _on_evict;
+    };
+
+
+    // 分片加锁的并发 LRU 缓存：按 key 的哈希把条目分到若干个独立的 lru_cache，
+    // 每个分片一把锁，不同分片上的操作互不阻塞
+    // LRU 顺序只在分片内部严格成立，总容量平均分给各分片
+    // 淘汰回调在持有分片锁时调用，回调里不能再访问同一个缓存
+    template<typename K, typename V,
+             typename Hash = std::hash<K>,
+             typename KeyEqual = std::equal_to<K>>
+    class concurrent_lru_cache
+    {
+    public:
+        using shard_type = lru_cache<K, V, Hash, KeyEqual>;
+        using size_function = typename shard_type::size_function;
+        using evict_callback = typename shard_type::evict_callback;
+
+        // shards 会向上取整到 2 的幂
+        explicit concurrent_lru_cache(size_t capacity, size_t shards = 16, size_function weigh = nullptr)
+        {
+            assert(capacity > 0 && shards > 0);
+
+            size_t n = 1;
+            while (n < shards) n <<= 1;
+            _mask = n - 1;
+
+            size_t per_shard = (capacity + n - 1) / n;
+            _shards.reserve(n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                _shards.push_back(std::make_unique<Shard>(per_shard, weigh));
+            }
+        }
+
+        concurrent_lru_cache(const concurrent_lru_cache&) = delete;
+        concurrent_lru_cache& operator=(const concurrent_lru_cache&) = delete;
+
+        void set_evict_callback(const evict_callback& cb)
+        {
+            for (const std::unique_ptr<Shard>& shard : _shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                shard->cache.set_evict_callback(cb);
+            }
+        }
+
+        // 并发场景下不能把内部指针交出去，命中时返回值的拷贝
+        std::optional<V> get(const K& key)
+        {
+            Shard& shard = shard_for(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            V* value = shard.cache.get(key);
+            if (!value) return std::nullopt;
+            return *value;
+        }
+
+        bool contains(const K& key) const
+        {
+            Shard& shard = shard_for(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.cache.contains(key);
+        }
+
+        template<typename VV>
+        void put(const K& key, VV&& value)
+        {
+            Shard& shard = shard_for(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.cache.put(key, std::forward<VV>(value));
+        }
+
+        bool erase(const K& key)
+        {
+            Shard& shard = shard_for(key);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.cache.erase(key);
+        }
+
+        void clear()
+        {
+            for (const std::unique_ptr<Shard>& shard : _shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                shard->cache.clear();
+            }
+        }
+
+        // 逐个分片加锁求和，结果只是某一时刻的近似值
+        size_t size() const
+        {
+            size_t total = 0;
+            for (const std::unique_ptr<Shard>& shard : _shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                total += shard->cache.size();
+            }
+            return total;
+        }
+
+        size_t weight() const
+        {
+            size_t total = 0;
+            for (const std::unique_ptr<Shard>& shard : _shards)
+            {
+                std::lock_guard<std::mutex> lock(shard->mutex);
+                total += shard->cache.weight();
+            }
+            return total;
+        }
+
+        size_t shard_count() const { return _shards.size(); }
+
+    private:
+        // 每个分片独占缓存行，避免相邻分片的锁互相伪共享
+        struct alignas(64) Shard
+        {
+            Shard(size_t capacity, const size_function& weigh) : cache(capacity, weigh) {}
+
+            std::mutex mutex;
+            shard_type cache;
+        };
+
+        Shard& shard_for(const K& key) const
+        {
+            size_t h = Hash()(key);
+            // 混合高位，避免 std::hash 对整数是恒等映射时只用到低位
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return *_shards[h & _mask];
+        }
+
+    private:
+        std::vector<std::unique_ptr<Shard>> _shards;   // 构造中途抛异常时已建好的分片自动释放
+        size_t _mask = 0;
+    };
+}
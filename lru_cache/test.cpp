@@ -0,0 +1,100 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cassert>
+#include "lru_cache.h"
+
+// 1. 基本的 get/put 与淘汰顺序
+void test_get_put_evict() {
+    tiny::lru_cache<int, std::string> cache(3);
+    cache.put(1, "one");
+    cache.put(2, "two");
+    cache.put(3, "three");
+    assert(cache.size() == 3);
+
+    // get 会把 1 变成最新，此时最旧的是 2
+    assert(cache.get(1) && *cache.get(1) == "one");
+    cache.put(4, "four");
+    assert(cache.size() == 3);
+    assert(!cache.contains(2));
+    assert(cache.contains(1) && cache.contains(3) && cache.contains(4));
+
+    // 更新已有 key 不增加条目
+    cache.put(3, "THREE");
+    assert(cache.size() == 3);
+    assert(*cache.peek(3) == "THREE");
+
+    // peek 不改变顺序：1 仍然是最旧的
+    cache.put(5, "five");
+    assert(!cache.contains(1));
+
+    assert(cache.erase(5));
+    assert(!cache.erase(5));
+    assert(cache.get(5) == nullptr);
+    assert(cache.size() == 2);
+
+    cache.clear();
+    assert(cache.empty() && cache.weight() == 0);
+}
+
+// 2. 按字节数限制容量，以及淘汰回调
+void test_weight_and_callback() {
+    tiny::lru_cache<std::string, std::string> cache(10,
+        [](const std::string&, const std::string& v) { return v.size(); });
+
+    std::vector<std::string> evicted;
+    cache.set_evict_callback([&](const std::string& k, std::string&) { evicted.push_back(k); });
+
+    cache.put("a", std::string(4, 'a'));
+    cache.put("b", std::string(4, 'b'));
+    assert(cache.weight() == 8);
+
+    cache.put("c", std::string(4, 'c')); // 12 > 10，淘汰 a
+    assert(cache.weight() == 8);
+    assert(evicted.size() == 1 && evicted[0] == "a");
+
+    // 超过容量的单个条目仍然保留，但会挤掉其余所有条目
+    cache.put("big", std::string(20, 'x'));
+    assert(cache.size() == 1 && cache.contains("big"));
+    assert(evicted.size() == 3);
+
+    // 缩小容量立即淘汰
+    cache.set_capacity(5);
+    assert(cache.empty() && evicted.size() == 4);
+}
+
+// 3. 分片并发缓存
+void test_concurrent() {
+    tiny::concurrent_lru_cache<int, int> cache(1024, 8);
+    assert(cache.shard_count() == 8);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (int i = 0; i < 10000; ++i) {
+                int key = (i * 7 + t) % 2000;
+                if (auto v = cache.get(key)) {
+                    assert(*v == key * 2);
+                } else {
+                    cache.put(key, key * 2);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    assert(cache.size() <= 1024);
+    cache.put(42, 84);
+    assert(cache.get(42).value() == 84);
+    assert(cache.erase(42));
+    assert(!cache.get(42));
+}
+
+int main() {
+    test_get_put_evict();
+    test_weight_and_callback();
+    test_concurrent();
+    std::cout << "all lru_cache tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,418 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace tiny {
+
+    // 多态内存资源：容器只持有一个 memory_resource*，分配/释放都经过它
+    // 与 std::pmr 的接口一致，子类实现 do_allocate / do_deallocate / do_is_equal
+    class memory_resource
+    {
+    public:
+        static constexpr size_t max_align = alignof(std::max_align_t);
+
+        virtual ~memory_resource() = default;
+
+        void* allocate(size_t bytes, size_t alignment = max_align)
+        {
+            assert((alignment & (alignment - 1)) == 0);
+            return do_allocate(bytes, alignment);
+        }
+
+        void deallocate(void* p, size_t bytes, size_t alignment = max_align)
+        {
+            if (p) do_deallocate(p, bytes, alignment);
+        }
+
+        bool is_equal(const memory_resource& other) const noexcept
+        {
+            return this == &other || do_is_equal(other);
+        }
+
+    private:
+        virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+        virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+        virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+    };
+
+    inline bool operator==(const memory_resource& a, const memory_resource& b) noexcept
+    {
+        return a.is_equal(b);
+    }
+
+    namespace detail {
+
+        inline size_t align_up(size_t n, size_t alignment)
+        {
+            return (n + alignment - 1) & ~(alignment - 1);
+        }
+
+        // 直接走全局 operator new/delete，是默认资源
+        class new_delete_resource_impl : public memory_resource
+        {
+            void* do_allocate(size_t bytes, size_t alignment) override
+            {
+                if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                    return ::operator new(bytes, std::align_val_t(alignment));
+                return ::operator new(bytes);
+            }
+
+            void do_deallocate(void* p, size_t, size_t alignment) override
+            {
+                if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                    ::operator delete(p, std::align_val_t(alignment));
+                else
+                    ::operator delete(p);
+            }
+
+            bool do_is_equal(const memory_resource& other) const noexcept override
+            {
+                return this == &other;
+            }
+        };
+    }
+
+    inline memory_resource* new_delete_resource() noexcept
+    {
+        static detail::new_delete_resource_impl instance;
+        return &instance;
+    }
+
+    namespace detail {
+        inline std::atomic<memory_resource*>& default_resource_slot()
+        {
+            static std::atomic<memory_resource*> slot{ new_delete_resource() };
+            return slot;
+        }
+    }
+
+    // 不显式传资源的容器都用默认资源，初始为 new_delete_resource()
+    inline memory_resource* get_default_resource() noexcept
+    {
+        return detail::default_resource_slot().load(std::memory_order_acquire);
+    }
+
+    // 返回旧的默认资源；传 nullptr 恢复为 new_delete_resource()
+    inline memory_resource* set_default_resource(memory_resource* r) noexcept
+    {
+        if (!r) r = new_delete_resource();
+        return detail::default_resource_slot().exchange(r, std::memory_order_acq_rel);
+    }
+
+    // 单调分配器（arena）：指针只往前推，deallocate 什么也不做，
+    // release() 一次性把所有块还给上游，适合“一次请求内大量短命容器、结束时整体丢弃”
+    // 不是线程安全的，多线程请用 thread_arena()
+    class monotonic_buffer_resource : public memory_resource
+    {
+    public:
+        monotonic_buffer_resource() = default;
+
+        explicit monotonic_buffer_resource(memory_resource* upstream)
+            : _upstream(upstream)
+        {}
+
+        explicit monotonic_buffer_resource(size_t initial_size, memory_resource* upstream = new_delete_resource())
+            : _upstream(upstream), _next_size(initial_size < kMinChunk ? kMinChunk : initial_size)
+        {}
+
+        // 先用调用者提供的缓冲区（比如栈上数组），用完再向上游要
+        monotonic_buffer_resource(void* buffer, size_t size, memory_resource* upstream = new_delete_resource())
+            : _upstream(upstream), _initial(static_cast<char*>(buffer)), _initial_size(size),
+              _cur(static_cast<char*>(buffer)), _end(static_cast<char*>(buffer) + size)
+        {
+            if (size > _next_size) _next_size = size;
+        }
+
+        monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+        monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+        ~monotonic_buffer_resource() override
+        {
+            release();
+        }
+
+        // 释放全部块，回到刚构造完的状态；之前分出去的内存全部失效
+        void release()
+        {
+            while (_chunks)
+            {
+                chunk* next = _chunks->next;
+                _upstream->deallocate(_chunks, _chunks->size, alignof(chunk));
+                _chunks = next;
+            }
+            _cur = _initial;
+            _end = _initial ? _initial + _initial_size : nullptr;
+        }
+
+        // 请求结束时用：只保留最近（也是最大）的一块，其余归还上游，
+        // 下一轮直接在这块上分配，稳态下不再向上游要内存
+        void reset()
+        {
+            if (!_chunks)
+            {
+                release();
+                return;
+            }
+            chunk* keep = _chunks;
+            _chunks = keep->next;
+            release();
+            keep->next = nullptr;
+            _chunks = keep;
+            _cur = reinterpret_cast<char*>(keep + 1);
+            _end = reinterpret_cast<char*>(keep) + keep->size;
+        }
+
+        memory_resource* upstream_resource() const { return _upstream; }
+
+        // 已经从上游拿到的字节数，不含初始缓冲区
+        size_t bytes_reserved() const
+        {
+            size_t total = 0;
+            for (chunk* c = _chunks; c; c = c->next) total += c->size;
+            return total;
+        }
+
+    private:
+        struct chunk
+        {
+            chunk* next;
+            size_t size;
+        };
+
+        static constexpr size_t kMinChunk = 1024;
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            char* p = align_(_cur, alignment);
+            if (!p || p + bytes > _end)
+            {
+                new_chunk_(bytes, alignment);
+                p = align_(_cur, alignment);
+            }
+            _cur = p + bytes;
+            return p;
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {}
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        static char* align_(char* p, size_t alignment)
+        {
+            if (!p) return nullptr;
+            return reinterpret_cast<char*>(detail::align_up(reinterpret_cast<uintptr_t>(p), alignment));
+        }
+
+        // 块大小按 2 倍增长，单次大请求直接给够
+        void new_chunk_(size_t bytes, size_t alignment)
+        {
+            size_t need = sizeof(chunk) + bytes + alignment;
+            size_t size = _next_size > need ? _next_size : need;
+            chunk* c = static_cast<chunk*>(_upstream->allocate(size, alignof(chunk)));
+            c->next = _chunks;
+            c->size = size;
+            _chunks = c;
+            _cur = reinterpret_cast<char*>(c + 1);
+            _end = reinterpret_cast<char*>(c) + size;
+            _next_size = size * 2;
+        }
+
+    private:
+        memory_resource* _upstream = new_delete_resource();
+        char* _initial = nullptr;
+        size_t _initial_size = 0;
+        char* _cur = nullptr;
+        char* _end = nullptr;
+        chunk* _chunks = nullptr;
+        size_t _next_size = kMinChunk;
+    };
+
+    // 按大小分级的池：8 ~ max_block 字节按 2 的幂分成若干级，每级一条空闲链表，
+    // 释放的块回到对应链表被复用；超过 max_block 的请求直接转给上游但仍被记录，
+    // release() 或析构时统一归还。不是线程安全的
+    class pool_resource : public memory_resource
+    {
+    public:
+        static constexpr size_t kMinBlock = 8;
+
+        explicit pool_resource(size_t max_block = 4096, memory_resource* upstream = new_delete_resource())
+            : _upstream(upstream)
+        {
+            assert(max_block >= kMinBlock && max_block <= (size_t(1) << (kMinShift + kMaxPools - 1)));
+            while ((kMinBlock << _pool_count) < max_block) ++_pool_count;
+            ++_pool_count;
+        }
+
+        pool_resource(const pool_resource&) = delete;
+        pool_resource& operator=(const pool_resource&) = delete;
+
+        ~pool_resource() override
+        {
+            release();
+        }
+
+        void release()
+        {
+            for (size_t i = 0; i < _pool_count; ++i)
+            {
+                pool& p = _pools[i];
+                while (p.chunks)
+                {
+                    chunk* next = p.chunks->next;
+                    _upstream->deallocate(p.chunks, p.chunks->size, kChunkAlign);
+                    p.chunks = next;
+                }
+                p.free = nullptr;
+                p.blocks_per_chunk = 8;
+            }
+            while (_large.next != &_large)
+            {
+                large_header* h = _large.next;
+                unlink_(h);
+                _upstream->deallocate(reinterpret_cast<char*>(h + 1) - h->offset, h->total, h->alignment);
+            }
+        }
+
+        size_t max_block() const { return kMinBlock << (_pool_count - 1); }
+        memory_resource* upstream_resource() const { return _upstream; }
+
+    private:
+        struct free_block { free_block* next; };
+
+        struct chunk
+        {
+            chunk* next;
+            size_t size;
+        };
+
+        struct pool
+        {
+            free_block* free = nullptr;
+            chunk* chunks = nullptr;
+            size_t blocks_per_chunk = 8;
+        };
+
+        // 大块前面挂一个头，串成双向链表，release() 时能找到
+        struct large_header
+        {
+            large_header* prev;
+            large_header* next;
+            size_t total;
+            size_t alignment;
+            size_t offset;   // 头 + 填充的长度，用户指针减去它得到块首
+        };
+
+        static constexpr size_t kMinShift = 3;
+        static constexpr size_t kMaxPools = 16;
+        static constexpr size_t kMaxBlocksPerChunk = 1024;
+        static constexpr size_t kChunkAlign = 64;
+
+        // 块大小是 2 的幂，按大小对齐即满足 alignment <= 块大小的请求
+        static size_t pool_index_(size_t bytes, size_t alignment)
+        {
+            size_t need = bytes > alignment ? bytes : alignment;
+            if (need < kMinBlock) need = kMinBlock;
+            size_t index = 0;
+            while ((kMinBlock << index) < need) ++index;
+            return index;
+        }
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            size_t index = pool_index_(bytes, alignment);
+            if (index >= _pool_count || alignment > kChunkAlign) return allocate_large_(bytes, alignment);
+
+            pool& p = _pools[index];
+            if (!p.free) refill_(p, kMinBlock << index);
+            free_block* b = p.free;
+            p.free = b->next;
+            return b;
+        }
+
+        void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+        {
+            size_t index = pool_index_(bytes, alignment);
+            if (index >= _pool_count || alignment > kChunkAlign)
+            {
+                large_header* h = static_cast<large_header*>(ptr) - 1;
+                unlink_(h);
+                _upstream->deallocate(static_cast<char*>(ptr) - h->offset, h->total, h->alignment);
+                return;
+            }
+
+            pool& p = _pools[index];
+            free_block* b = static_cast<free_block*>(ptr);
+            b->next = p.free;
+            p.free = b;
+        }
+
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+        // 新块切成等长小块挂到空闲链表上，每次补充的块数翻倍
+        void refill_(pool& p, size_t block_size)
+        {
+            const size_t header = detail::align_up(sizeof(chunk), block_size < kChunkAlign ? block_size : kChunkAlign);
+            const size_t size = header + block_size * p.blocks_per_chunk;
+            chunk* c = static_cast<chunk*>(_upstream->allocate(size, kChunkAlign));
+            c->next = p.chunks;
+            c->size = size;
+            p.chunks = c;
+
+            char* first = reinterpret_cast<char*>(c) + header;
+            for (size_t i = p.blocks_per_chunk; i-- > 0;)
+            {
+                free_block* b = reinterpret_cast<free_block*>(first + i * block_size);
+                b->next = p.free;
+                p.free = b;
+            }
+            if (p.blocks_per_chunk < kMaxBlocksPerChunk) p.blocks_per_chunk *= 2;
+        }
+
+        void* allocate_large_(size_t bytes, size_t alignment)
+        {
+            const size_t align = alignment > alignof(large_header) ? alignment : alignof(large_header);
+            const size_t offset = detail::align_up(sizeof(large_header), align);
+            const size_t total = offset + bytes;
+            char* base = static_cast<char*>(_upstream->allocate(total, align));
+
+            large_header* h = reinterpret_cast<large_header*>(base + offset) - 1;
+            h->total = total;
+            h->alignment = align;
+            h->offset = offset;
+            h->prev = &_large;
+            h->next = _large.next;
+            _large.next->prev = h;
+            _large.next = h;
+            return base + offset;
+        }
+
+        static void unlink_(large_header* h)
+        {
+            h->prev->next = h->next;
+            h->next->prev = h->prev;
+        }
+
+    private:
+        memory_resource* _upstream;
+        pool _pools[kMaxPools];
+        size_t _pool_count = 0;
+        large_header _large{ &_large, &_large, 0, 0, 0 };
+    };
+
+    // 每个线程一个 arena，线程内随用随取，不需要加锁；
+    // 线程退出时自动释放，请求结束时调用 thread_arena().reset() 整体回收
+    inline monotonic_buffer_resource& thread_arena()
+    {
+        thread_local monotonic_buffer_resource arena(64 * 1024);
+        return arena;
+    }
+}
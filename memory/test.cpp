@@ -0,0 +1,196 @@
+#include <iostream>
+#include <thread>
+#include <cstdint>
+#include <cassert>
+#include "memory_resource.h"
+#include "../vector/vector.h"
+#include "../string/string.h"
+#include "../list/list.h"
+
+// 记录上游分配次数与未归还字节数，用来确认容器确实走了指定的资源
+class counting_resource : public tiny::memory_resource
+{
+public:
+    size_t allocations = 0;
+    size_t outstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations;
+        outstanding += bytes;
+        return tiny::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        outstanding -= bytes;
+        tiny::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const tiny::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+bool aligned(void* p, size_t alignment)
+{
+    return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+}
+
+// 1. 单调分配器：对齐、初始缓冲区、release/reset
+void test_monotonic() {
+    counting_resource upstream;
+    {
+        alignas(16) char stack_buf[256];
+        tiny::monotonic_buffer_resource arena(stack_buf, sizeof(stack_buf), &upstream);
+
+        void* a = arena.allocate(10, 1);
+        void* b = arena.allocate(8, 8);
+        assert(a == stack_buf && aligned(b, 8));
+        assert(upstream.allocations == 0);   // 初始缓冲区还够用
+
+        for (int i = 0; i < 100; ++i) assert(aligned(arena.allocate(24, 64), 64));
+        assert(upstream.allocations > 0 && upstream.outstanding > 0);
+
+        arena.release();
+        assert(upstream.outstanding == 0);
+        assert(arena.allocate(10, 1) == stack_buf);   // 回到初始缓冲区
+    }
+
+    tiny::monotonic_buffer_resource arena(&upstream);
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 1000; ++i) arena.allocate(32);
+        arena.reset();
+    }
+    // 稳态后只剩一块，且后几轮不再向上游要内存
+    size_t before = upstream.allocations;
+    for (int i = 0; i < 1000; ++i) arena.allocate(32);
+    assert(upstream.allocations == before);
+    arena.release();
+    assert(upstream.outstanding == 0);
+}
+
+// 2. 分级池：释放的块被复用，大块直接走上游，release 全部归还
+void test_pool() {
+    counting_resource upstream;
+    {
+        tiny::pool_resource pool(1024, &upstream);
+        assert(pool.max_block() == 1024);
+
+        void* a = pool.allocate(24, 8);
+        pool.deallocate(a, 24, 8);
+        void* b = pool.allocate(32, 8);   // 同一级（32 字节）
+        assert(a == b);
+
+        void* blocks[500];
+        for (int i = 0; i < 500; ++i) {
+            blocks[i] = pool.allocate(100, 16);
+            assert(aligned(blocks[i], 16));
+        }
+        for (int i = 0; i < 500; ++i) pool.deallocate(blocks[i], 100, 16);
+        size_t chunks = upstream.allocations;
+        for (int i = 0; i < 500; ++i) blocks[i] = pool.allocate(100, 16);
+        assert(upstream.allocations == chunks);   // 全部来自空闲链表
+
+        void* big = pool.allocate(10000, 128);
+        assert(aligned(big, 128) && upstream.allocations == chunks + 1);
+        pool.deallocate(big, 10000, 128);
+        pool.allocate(5000);   // 不归还，交给 release
+    }
+    assert(upstream.outstanding == 0);
+}
+
+// 3. 容器从 arena 分配，赋值/移动不改变各自的资源
+void test_containers() {
+    counting_resource upstream;
+    tiny::monotonic_buffer_resource arena(&upstream);
+
+    tiny::vector<int> v(&arena);
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+    assert(v.resource() == &arena && upstream.allocations > 0);
+
+    tiny::vector<int> heap(5, 7);
+    assert(heap.resource() == tiny::get_default_resource());
+    heap = v;                       // 拷贝赋值：元素拷进堆上的缓冲区
+    assert(heap.resource() == tiny::get_default_resource() && heap.size() == 1000 && heap[999] == 999);
+
+    tiny::vector<int> moved(std::move(v));   // 移动构造：连同 arena 一起带走
+    assert(moved.resource() == &arena && moved.size() == 1000 && v.empty());
+
+    tiny::vector<int> other(&arena);
+    other = std::move(heap);        // 资源不同：逐个移动，other 仍在 arena 里
+    assert(other.resource() == &arena && other.size() == 1000 && other[10] == 10);
+
+    tiny::string s("hello, arena", &arena);
+    for (int i = 0; i < 100; ++i) s.push_back('!');
+    assert(s.resource() == &arena && s.size() == 112);
+    tiny::string copy = s;
+    assert(copy.resource() == tiny::get_default_resource() && copy == s);
+    tiny::string in_arena(&arena);
+    in_arena = copy;
+    assert(in_arena.resource() == &arena && in_arena == s);
+
+    tiny::list<tiny::string> names(&arena);
+    for (int i = 0; i < 100; ++i) names.emplace_back("name", &arena);
+    tiny::list<tiny::string> more(&arena);
+    more.splice(more.end(), names);
+    assert(more.size() == 100 && names.empty());
+
+    tiny::list<tiny::string> heap_list;
+    heap_list = std::move(more);   // 资源不同，节点重新在堆上分配
+    assert(heap_list.size() == 100 && heap_list.resource() == tiny::get_default_resource());
+
+    // 嵌套容器都放进同一个 arena，结束时一次 release 全部回收
+    {
+        tiny::vector<tiny::vector<int>> rows(&arena);
+        for (int r = 0; r < 50; ++r) {
+            rows.emplace_back(&arena);
+            for (int c = 0; c < 20; ++c) rows.back().push_back(r * c);
+        }
+        assert(rows[49][19] == 49 * 19);
+    }
+
+    // 池资源：元素被释放的块会被后续节点复用
+    tiny::pool_resource pool(4096, &upstream);
+    tiny::list<int> l(&pool);
+    for (int i = 0; i < 1000; ++i) l.push_back(i);
+    size_t after_fill = upstream.allocations;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 500; ++i) l.pop_front();
+        for (int i = 0; i < 500; ++i) l.push_back(i);
+    }
+    assert(upstream.allocations == after_fill && l.size() == 1000);
+}
+
+// 4. 每个线程各有一个 arena
+void test_thread_arena() {
+    tiny::memory_resource* main_arena = &tiny::thread_arena();
+    tiny::memory_resource* worker_arena = nullptr;
+    std::thread t([&] {
+        worker_arena = &tiny::thread_arena();
+        tiny::vector<int> v(&tiny::thread_arena());
+        for (int i = 0; i < 10000; ++i) v.push_back(i);
+        assert(v[9999] == 9999);
+    });
+    t.join();
+    assert(worker_arena && worker_arena != main_arena);
+
+    for (int request = 0; request < 3; ++request) {
+        {
+            tiny::vector<tiny::string> parts(&tiny::thread_arena());
+            for (int i = 0; i < 100; ++i) parts.emplace_back("part", &tiny::thread_arena());
+        }
+        tiny::thread_arena().reset();
+    }
+}
+
+int main() {
+    test_monotonic();
+    test_pool();
+    test_containers();
+    test_thread_arena();
+    std::cout << "all memory_resource tests passed!" << std::endl;
+    return 0;
+}
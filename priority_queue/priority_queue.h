@@ -0,0 +1,329 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "../vector/vector.h"
+
+namespace tiny {
+
+    namespace detail {
+        // d 叉堆的基本操作，供 priority_queue 与 indexed_priority_queue 共用
+        // 4 叉堆的高度只有二叉堆的一半，同一个父节点的 4 个孩子通常落在同一条缓存行里，
+        // 下沉时每层多比较几次，但访存次数明显减少
+        constexpr size_t kHeapArity = 4;
+
+        inline size_t heap_parent(size_t i) { return (i - 1) / kHeapArity; }
+        inline size_t heap_first_child(size_t i) { return i * kHeapArity + 1; }
+
+        // get(i) 取第 i 个元素的引用，place(i, value) 把值放到第 i 个位置，
+        // less(a, b) 为真表示 a 的优先级低于 b；返回元素最终所在的位置
+        template<typename Get, typename Less, typename Place>
+        size_t sift_up(size_t i, Get&& get, Less&& less, Place&& place)
+        {
+            auto value = std::move(get(i));
+            while (i > 0)
+            {
+                size_t parent = heap_parent(i);
+                if (!less(get(parent), value)) break;
+                place(i, std::move(get(parent)));
+                i = parent;
+            }
+            place(i, std::move(value));
+            return i;
+        }
+
+        template<typename Get, typename Less, typename Place>
+        size_t sift_down(size_t i, size_t n, Get&& get, Less&& less, Place&& place)
+        {
+            auto value = std::move(get(i));
+            for (;;)
+            {
+                size_t first = heap_first_child(i);
+                if (first >= n) break;
+
+                // 在最多 kHeapArity 个孩子里选优先级最高的
+                size_t last = first + kHeapArity < n ? first + kHeapArity : n;
+                size_t best = first;
+                for (size_t c = first + 1; c < last; ++c)
+                {
+                    if (less(get(best), get(c))) best = c;
+                }
+
+                if (!less(value, get(best))) break;
+                place(i, std::move(get(best)));
+                i = best;
+            }
+            place(i, std::move(value));
+            return i;
+        }
+    }
+
+    // 基于 4 叉堆的优先队列适配器，语义与 std::priority_queue 相同：
+    // Compare 为 std::less 时 top() 是最大元素
+    template<typename T, typename Container = tiny::vector<T>, typename Compare = std::less<T>>
+    class priority_queue
+    {
+    public:
+        priority_queue() = default;
+
+        explicit priority_queue(const Compare& comp)
+            : _comp(comp)
+        {}
+
+        // 从区间建堆，O(n)
+        template<typename InputIterator>
+        priority_queue(InputIterator first, InputIterator last, const Compare& comp = Compare())
+            : _comp(comp)
+        {
+            for (; first != last; ++first) _con.push_back(*first);
+            heapify();
+        }
+
+        explicit priority_queue(Container&& con, const Compare& comp = Compare())
+            : _con(std::move(con)), _comp(comp)
+        {
+            heapify();
+        }
+
+        const T& top() const
+        {
+            assert(!empty());
+            return _con.front();
+        }
+
+        bool empty() const
+        {
+            return _con.empty();
+        }
+
+        size_t size() const
+        {
+            return _con.size();
+        }
+
+        void push(const T& value)
+        {
+            _con.push_back(value);
+            up(_con.size() - 1);
+        }
+
+        void push(T&& value)
+        {
+            _con.push_back(std::move(value));
+            up(_con.size() - 1);
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args)
+        {
+            _con.emplace_back(std::forward<Args>(args)...);
+            up(_con.size() - 1);
+        }
+
+        // 批量插入：新元素多于现有元素时整体重新建堆（O(n)），否则逐个上浮
+        template<typename InputIterator>
+        void push_bulk(InputIterator first, InputIterator last)
+        {
+            const size_t old_size = _con.size();
+            for (; first != last; ++first) _con.push_back(*first);
+
+            const size_t added = _con.size() - old_size;
+            if (added > old_size)
+            {
+                heapify();
+            }
+            else
+            {
+                for (size_t i = old_size; i < _con.size(); ++i) up(i);
+            }
+        }
+
+        void pop()
+        {
+            assert(!empty());
+            const size_t n = _con.size() - 1;
+            if (n > 0)
+            {
+                _con[0] = std::move(_con[n]);
+                _con.pop_back();
+                down(0);
+            }
+            else
+            {
+                _con.pop_back();
+            }
+        }
+
+    private:
+        // 自底向上，从最后一个非叶子节点开始逐个下沉，O(n)
+        void heapify()
+        {
+            const size_t n = _con.size();
+            if (n < 2) return;
+            for (size_t i = detail::heap_parent(n - 1) + 1; i-- > 0;)
+            {
+                down(i);
+            }
+        }
+
+        void up(size_t i)
+        {
+            detail::sift_up(i,
+                [this](size_t k) -> T& { return _con[k]; },
+                _comp,
+                [this](size_t k, T&& v) { _con[k] = std::move(v); });
+        }
+
+        void down(size_t i)
+        {
+            detail::sift_down(i, _con.size(),
+                [this](size_t k) -> T& { return _con[k]; },
+                _comp,
+                [this](size_t k, T&& v) { _con[k] = std::move(v); });
+        }
+
+    private:
+        Container _con;
+        Compare _comp;
+    };
+
+
+    // 带句柄的优先队列：push 返回一个句柄，之后可以按句柄 O(log n) 修改优先级或删除
+    // 堆里只存句柄，另有一张 句柄 -> 堆中位置 的表，元素移动时同步更新
+    // 句柄在元素弹出或删除后回收复用
+    template<typename T, typename Compare = std::less<T>>
+    class indexed_priority_queue
+    {
+    public:
+        using handle = size_t;
+
+        indexed_priority_queue() = default;
+
+        explicit indexed_priority_queue(const Compare& comp)
+            : _comp(comp)
+        {}
+
+        bool empty() const { return _heap.empty(); }
+        size_t size() const { return _heap.size(); }
+
+        const T& top() const
+        {
+            assert(!empty());
+            return _values[_heap[0]];
+        }
+
+        handle top_handle() const
+        {
+            assert(!empty());
+            return _heap[0];
+        }
+
+        handle push(const T& value)
+        {
+            handle h = allocate(value);
+            _heap.push_back(h);
+            _pos[h] = _heap.size() - 1;
+            up(_heap.size() - 1);
+            return h;
+        }
+
+        void pop()
+        {
+            assert(!empty());
+            erase(_heap[0]);
+        }
+
+        bool contains(handle h) const
+        {
+            return h < _pos.size() && _pos[h] != npos;
+        }
+
+        const T& value(handle h) const
+        {
+            assert(contains(h));
+            return _values[h];
+        }
+
+        // 修改元素的值；新值优先级变高就上浮，变低就下沉（即 decrease-key/increase-key）
+        void update(handle h, const T& value)
+        {
+            assert(contains(h));
+            const bool raise = _comp(_values[h], value);
+            _values[h] = value;
+            if (raise) up(_pos[h]);
+            else down(_pos[h]);
+        }
+
+        void erase(handle h)
+        {
+            assert(contains(h));
+            const size_t i = _pos[h];
+            const size_t last = _heap.size() - 1;
+
+            if (i != last)
+            {
+                handle moved = _heap[last];
+                _heap[i] = moved;
+                _pos[moved] = i;
+                _heap.pop_back();
+
+                // 补位的元素可能比原来的大也可能小
+                if (i > 0 && _comp(_values[_heap[detail::heap_parent(i)]], _values[moved])) up(i);
+                else down(i);
+            }
+            else
+            {
+                _heap.pop_back();
+            }
+
+            _pos[h] = npos;
+            _free.push_back(h);
+        }
+
+    private:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        handle allocate(const T& value)
+        {
+            if (!_free.empty())
+            {
+                handle h = _free.back();
+                _free.pop_back();
+                _values[h] = value;
+                return h;
+            }
+            _values.push_back(value);
+            _pos.push_back(npos);
+            return _values.size() - 1;
+        }
+
+        bool less(handle a, handle b) const
+        {
+            return _comp(_values[a], _values[b]);
+        }
+
+        void up(size_t i)
+        {
+            detail::sift_up(i,
+                [this](size_t k) -> handle& { return _heap[k]; },
+                [this](handle a, handle b) { return less(a, b); },
+                [this](size_t k, handle h) { _heap[k] = h; _pos[h] = k; });
+        }
+
+        void down(size_t i)
+        {
+            detail::sift_down(i, _heap.size(),
+                [this](size_t k) -> handle& { return _heap[k]; },
+                [this](handle a, handle b) { return less(a, b); },
+                [this](size_t k, handle h) { _heap[k] = h; _pos[h] = k; });
+        }
+
+    private:
+        tiny::vector<handle> _heap;    // 堆，存句柄
+        tiny::vector<size_t> _pos;     // 句柄 -> 堆中下标，不在堆中为 npos
+        tiny::vector<T> _values;       // 句柄 -> 值
+        tiny::vector<handle> _free;    // 可复用的句柄
+        Compare _comp;
+    };
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cassert>
+#include "priority_queue.h"
+
+// 1. 基本操作：默认是大顶堆
+void test_priority_queue() {
+    tiny::priority_queue<int> pq;
+    assert(pq.empty());
+    int input[] = {5, 1, 8, 3, 9, 2, 7};
+    for (int x : input) pq.push(x);
+    assert(pq.size() == 7 && pq.top() == 9);
+
+    int expected[] = {9, 8, 7, 5, 3, 2, 1};
+    for (int e : expected) {
+        assert(pq.top() == e);
+        pq.pop();
+    }
+    assert(pq.empty());
+
+    // 小顶堆 + 原地构造
+    tiny::priority_queue<std::string, tiny::vector<std::string>, std::greater<std::string>> minq;
+    minq.emplace(3, 'c');
+    minq.push("b");
+    minq.push(std::string("a"));
+    assert(minq.top() == "a");
+    minq.pop();
+    assert(minq.top() == "b");
+}
+
+// 2. 从区间建堆与批量插入，与排序结果对比
+void test_heapify_and_bulk() {
+    std::mt19937 rng(42);
+    std::vector<int> data(1000);
+    for (int& x : data) x = int(rng() % 10000);
+
+    tiny::priority_queue<int> pq(data.begin(), data.begin() + 100);
+    pq.push_bulk(data.begin() + 100, data.begin() + 110);   // 少量：逐个上浮
+    pq.push_bulk(data.begin() + 110, data.end());           // 大量：整体重新建堆
+    assert(pq.size() == data.size());
+
+    std::sort(data.begin(), data.end(), std::greater<int>());
+    for (int x : data) {
+        assert(pq.top() == x);
+        pq.pop();
+    }
+}
+
+// 3. 带句柄的优先队列：decrease-key 与按句柄删除
+void test_indexed_priority_queue() {
+    // 小顶堆，模拟 Dijkstra 的距离表
+    tiny::indexed_priority_queue<int, std::greater<int>> pq;
+    auto a = pq.push(50);
+    auto b = pq.push(20);
+    auto c = pq.push(30);
+    auto d = pq.push(40);
+    assert(pq.top() == 20 && pq.top_handle() == b);
+
+    pq.update(d, 10);                   // decrease-key
+    assert(pq.top_handle() == d);
+    pq.update(d, 60);                   // increase-key
+    assert(pq.top_handle() == b);
+
+    pq.erase(c);
+    assert(!pq.contains(c) && pq.size() == 3);
+
+    pq.pop();                           // 弹出 b(20)
+    assert(pq.top_handle() == a && pq.value(a) == 50);
+
+    // 句柄回收后复用
+    auto e = pq.push(1);
+    assert(!pq.contains(b) || e == b || e == c);
+    assert(pq.top() == 1);
+
+    // 随机操作与暴力结果对比
+    std::mt19937 rng(7);
+    tiny::indexed_priority_queue<int> big;
+    std::vector<std::pair<size_t, int>> live;
+    for (int step = 0; step < 5000; ++step) {
+        int op = int(rng() % 4);
+        if (op < 2 || live.empty()) {
+            int v = int(rng() % 100000);
+            live.push_back({big.push(v), v});
+        } else if (op == 2) {
+            size_t k = rng() % live.size();
+            int v = int(rng() % 100000);
+            big.update(live[k].first, v);
+            live[k].second = v;
+        } else {
+            size_t k = rng() % live.size();
+            big.erase(live[k].first);
+            live.erase(live.begin() + k);
+        }
+        int best = -1;
+        for (auto& p : live) best = std::max(best, p.second);
+        assert(big.size() == live.size());
+        if (!live.empty()) assert(big.top() == best);
+    }
+}
+
+int main() {
+    test_priority_queue();
+    test_heapify_and_bulk();
+    test_indexed_priority_queue();
+    std::cout << "all priority_queue tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tiny {
+namespace detail {
+
+    // 在 32 位原子变量上挂起，直到它不再等于 expected、被唤醒或超时
+    // 可能出现虚假唤醒，调用方必须在循环里重新检查条件
+    // Linux 下直接用 futex，带超时；其它平台没有超时版本的 atomic::wait，
+    // 退化为短暂睡眠后返回
+    inline void atomic_wait_for(std::atomic<uint32_t>& word, uint32_t expected,
+                                std::chrono::nanoseconds timeout)
+    {
+#ifdef __linux__
+        timespec ts;
+        ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+                FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+#else
+        if (word.load(std::memory_order_acquire) != expected) return;
+        std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::milliseconds(1)));
+#endif
+    }
+
+    inline void atomic_wait(std::atomic<uint32_t>& word, uint32_t expected)
+    {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+                FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+        word.wait(expected, std::memory_order_acquire);
+#endif
+    }
+
+    inline void atomic_notify_all(std::atomic<uint32_t>& word)
+    {
+#ifdef __linux__
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+                FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+        word.notify_all();
+#endif
+    }
+
+    // 自旋等待时让出流水线，减少对另一个超线程的干扰
+    inline void cpu_relax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+}
+}
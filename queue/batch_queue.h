@@ -0,0 +1,186 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <utility>
+#include "../vector/vector.h"
+
+namespace tiny {
+
+    // 按批取出的多生产者/多消费者队列
+    //
+    // 消费者一次加锁就把最多 max 个（默认全部）待处理元素取进调用方的 tiny::vector，
+    // 同步开销按批而不是按元素支付；生产者可以一次加锁入队一整段 span
+    //
+    // 待处理元素存放在一个 vector 里，_head 之前是已经取走的部分：
+    //   全部取走、out 为空且两者内存资源相同时直接交换两个 vector，O(1)，
+    //   out 原来的容量留给生产者继续用
+    //   只取一部分时把 [_head, _head + n) 移动到 out，_head 后移；前面的空洞在
+    //   超过一半时才压缩，均摊 O(1)
+    //
+    // 阻塞等待用条件变量，只有在有消费者等待时生产者才去 notify；
+    // 被唤醒的消费者只取走一部分时再接力唤醒下一个
+    template<typename T>
+    class batch_queue
+    {
+    public:
+        static constexpr size_t all = SIZE_MAX;
+
+        batch_queue() = default;
+
+        batch_queue(const batch_queue&) = delete;
+        batch_queue& operator=(const batch_queue&) = delete;
+
+        // ---------- 生产者 ----------
+
+        // 关闭后入队失败，返回 false
+        bool push(const T& value) { return emplace(value); }
+        bool push(T&& value) { return emplace(std::move(value)); }
+
+        template<typename... Args>
+        bool emplace(Args&&... args)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_closed) return false;
+            compact_();
+            _items.emplace_back(std::forward<Args>(args)...);
+            notify_(lock);
+            return true;
+        }
+
+        // 一次加锁入队整段，最多扩容一次
+        bool push_bulk(std::span<const T> values)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_closed) return false;
+            if (values.empty()) return true;
+            compact_();
+            _items.reserve(_items.size() + values.size());
+            for (const T& v : values) _items.push_back(v);
+            notify_(lock);
+            return true;
+        }
+
+        // ---------- 消费者 ----------
+
+        // 把最多 max 个元素追加到 out 末尾，不等待；返回取出的个数
+        size_t try_drain(vector<T>& out, size_t max = all)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return drain_(out, max);
+        }
+
+        // 队列为空时等待；返回 0 表示已关闭且取空
+        size_t drain(vector<T>& out, size_t max = all)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            wait_(lock, [this] { return pending_() != 0 || _closed; });
+            return drain_(out, max);
+        }
+
+        // 最多等待 timeout；超时或已关闭且取空时返回 0
+        template<typename Rep, typename Period>
+        size_t drain_for(vector<T>& out, std::chrono::duration<Rep, Period> timeout, size_t max = all)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            ++_waiters;
+            _cv.wait_until(lock, deadline, [this] { return pending_() != 0 || _closed; });
+            --_waiters;
+            return drain_(out, max);
+        }
+
+        // 唤醒所有等待的消费者；剩余元素仍然可以取出
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _closed = true;
+            }
+            _cv.notify_all();
+        }
+
+        bool closed() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _closed;
+        }
+
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return pending_();
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+        size_t pending_() const { return _items.size() - _head; }
+
+        template<typename Pred>
+        void wait_(std::unique_lock<std::mutex>& lock, Pred pred)
+        {
+            ++_waiters;
+            _cv.wait(lock, pred);
+            --_waiters;
+        }
+
+        // 没有消费者在等时不必 notify；先解锁再唤醒，被唤醒的线程不用再等锁
+        void notify_(std::unique_lock<std::mutex>& lock)
+        {
+            if (_waiters == 0) return;
+            lock.unlock();
+            _cv.notify_one();
+        }
+
+        size_t drain_(vector<T>& out, size_t max)
+        {
+            const size_t n = std::min(max, pending_());
+            if (n == 0) return 0;
+
+            // 交换会把 out 的内存资源一起换过来；只有两边资源相同时才能走这条路，
+            // 否则生产者会在消费者的（通常不是线程安全的、可能被提前释放的）arena 上分配
+            if (n == _items.size() && out.empty() && *out.resource() == *_items.resource())
+            {
+                _items.swap(out);
+                _items.clear();
+                return n;
+            }
+
+            out.reserve(out.size() + n);
+            for (size_t i = 0; i < n; ++i) out.push_back(std::move(_items[_head + i]));
+            _head += n;
+            if (_head == _items.size())
+            {
+                _items.clear();
+                _head = 0;
+            }
+            // 只取走了一部分：生产者那次 notify_one 只叫醒了自己，把剩下的交给下一个等待者
+            else if (_waiters != 0)
+            {
+                _cv.notify_one();
+            }
+            return n;
+        }
+
+        // 已取走的空洞超过一半时整体前移
+        void compact_()
+        {
+            if (_head == 0 || _head < _items.size() / 2) return;
+            _items.erase(_items.begin(), _items.begin() + _head);
+            _head = 0;
+        }
+
+    private:
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        vector<T> _items;
+        size_t _head = 0;
+        size_t _waiters = 0;
+        bool _closed = false;
+    };
+}
@@ -0,0 +1,280 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "atomic_wait.h"
+
+namespace tiny {
+
+    // 有界、无锁的多生产者/多消费者队列（Vyukov 的按槽位序号算法）
+    //
+    // 每个槽位带一个序号 seq：
+    //   seq == pos      槽位空闲，可以写入第 pos 个元素
+    //   seq == pos + 1  第 pos 个元素已写好，可以读出
+    // 生产者/消费者各自用 CAS 抢一个位置，抢到后只和该槽位打交道，
+    // 不同位置的读写互不干扰
+    //
+    // try_push/try_pop 永不阻塞；push/pop 先短暂自旋，再挂起在 futex 上等待，
+    // push_for/pop_for 带超时。可以直接替换"mutex + condvar + queue"的用法
+    template<typename T>
+    class mpmc_queue
+    {
+        static constexpr size_t kCacheLine = 64;
+        static constexpr int kSpinCount = 128;
+
+    public:
+        // capacity 会向上取整到 2 的幂，至少为 2
+        explicit mpmc_queue(size_t capacity)
+        {
+            size_t n = 2;
+            while (n < capacity) n <<= 1;
+            _mask = n - 1;
+            _cells = static_cast<Cell*>(::operator new(n * sizeof(Cell), std::align_val_t(alignof(Cell))));
+            for (size_t i = 0; i < n; ++i)
+            {
+                new (&_cells[i].seq) std::atomic<size_t>(i);
+            }
+        }
+
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+        // 析构时不能再有其它线程访问队列
+        ~mpmc_queue()
+        {
+            size_t head = _dequeue_pos.load(std::memory_order_relaxed);
+            size_t tail = _enqueue_pos.load(std::memory_order_relaxed);
+            for (; head != tail; ++head)
+            {
+                _cells[head & _mask].value()->~T();
+            }
+            for (size_t i = 0; i <= _mask; ++i)
+            {
+                _cells[i].seq.~atomic();
+            }
+            ::operator delete(_cells, std::align_val_t(alignof(Cell)));
+        }
+
+        size_t capacity() const { return _mask + 1; }
+
+        // ---------- 非阻塞 ----------
+
+        template<typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            Cell* cell;
+            size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                const size_t seq = cell->seq.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // 队列已满
+                }
+                else
+                {
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (cell->storage) T(std::forward<Args>(args)...);
+            cell->seq.store(pos + 1, std::memory_order_release);
+            notify(_item_signal, _pop_waiters);
+            return true;
+        }
+
+        bool try_push(const T& value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        bool try_pop(T& out)
+        {
+            Cell* cell;
+            size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &_cells[pos & _mask];
+                const size_t seq = cell->seq.load(std::memory_order_acquire);
+                const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                {
+                    return false; // 队列为空
+                }
+                else
+                {
+                    pos = _dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+
+            T* value = cell->value();
+            out = std::move(*value);
+            value->~T();
+            cell->seq.store(pos + _mask + 1, std::memory_order_release);
+            notify(_space_signal, _push_waiters);
+            return true;
+        }
+
+        // ---------- 阻塞 ----------
+
+        void push(const T& value)
+        {
+            wait_until_done(_space_signal, _push_waiters, [&] { return try_push(value); }, nullptr);
+        }
+
+        void push(T&& value)
+        {
+            // try_emplace 失败时不会构造对象，value 不会被提前移走
+            wait_until_done(_space_signal, _push_waiters, [&] { return try_push(std::move(value)); }, nullptr);
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args)
+        {
+            wait_until_done(_space_signal, _push_waiters,
+                            [&] { return try_emplace(std::forward<Args>(args)...); }, nullptr);
+        }
+
+        void pop(T& out)
+        {
+            wait_until_done(_item_signal, _pop_waiters, [&] { return try_pop(out); }, nullptr);
+        }
+
+        // 超时返回 false
+        template<typename Rep, typename Period>
+        bool push_for(const T& value, std::chrono::duration<Rep, Period> timeout)
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            return wait_until_done(_space_signal, _push_waiters, [&] { return try_push(value); }, &deadline);
+        }
+
+        template<typename Rep, typename Period>
+        bool push_for(T&& value, std::chrono::duration<Rep, Period> timeout)
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            return wait_until_done(_space_signal, _push_waiters,
+                                   [&] { return try_push(std::move(value)); }, &deadline);
+        }
+
+        template<typename Rep, typename Period>
+        bool pop_for(T& out, std::chrono::duration<Rep, Period> timeout)
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            return wait_until_done(_item_signal, _pop_waiters, [&] { return try_pop(out); }, &deadline);
+        }
+
+        // ---------- 观察 ----------
+
+        // 近似值：并发修改时只是某一时刻的快照
+        size_t size_approx() const
+        {
+            const size_t tail = _enqueue_pos.load(std::memory_order_acquire);
+            const size_t head = _dequeue_pos.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        bool empty_approx() const
+        {
+            return size_approx() == 0;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> seq;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+        };
+
+        // 有人在等时才递增信号并唤醒；没有等待者时只多一次读，不做系统调用
+        // 栅栏与等待方登记 waiters 之后的栅栏配对，保证"写入元素"和"读 waiters"不会重排
+        static void notify(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) != 0)
+            {
+                signal.fetch_add(1, std::memory_order_release);
+                detail::atomic_notify_all(signal);
+            }
+        }
+
+        // 反复执行 attempt 直到成功：先自旋，再登记为等待者并挂起在 signal 上
+        // deadline 为空表示无限等待
+        template<typename F>
+        static bool wait_until_done(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiters,
+                                    F&& attempt, const std::chrono::steady_clock::time_point* deadline)
+        {
+            for (int i = 0; i < kSpinCount; ++i)
+            {
+                if (attempt()) return true;
+                detail::cpu_relax();
+            }
+
+            for (;;)
+            {
+                const uint32_t ticket = signal.load(std::memory_order_acquire);
+                waiters.fetch_add(1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (attempt())
+                {
+                    waiters.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+
+                if (deadline)
+                {
+                    auto now = std::chrono::steady_clock::now();
+                    if (now >= *deadline)
+                    {
+                        waiters.fetch_sub(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    detail::atomic_wait_for(signal, ticket, *deadline - now);
+                }
+                else
+                {
+                    detail::atomic_wait(signal, ticket);
+                }
+                waiters.fetch_sub(1, std::memory_order_relaxed);
+
+                if (attempt()) return true;
+            }
+        }
+
+    private:
+        Cell*  _cells = nullptr;
+        size_t _mask = 0;
+
+        alignas(kCacheLine) std::atomic<size_t> _enqueue_pos{0};
+        alignas(kCacheLine) std::atomic<size_t> _dequeue_pos{0};
+
+        // 等待"有元素"的消费者 / 等待"有空位"的生产者
+        alignas(kCacheLine) std::atomic<uint32_t> _item_signal{0};
+        std::atomic<uint32_t> _pop_waiters{0};
+        alignas(kCacheLine) std::atomic<uint32_t> _space_signal{0};
+        std::atomic<uint32_t> _push_waiters{0};
+    };
+}
@@ -1,16 +1,43 @@
 #pragma once
-#include<deque>
-using std::deque;
+#include<cstddef>
+#include<span>
+#include<utility>
+#include "ring_buffer.h"
 
-template<typename T, typename Container = deque<T>>
+// 默认用 tiny::ring_buffer 做底层容器：一整块连续内存、掩码回绕，
+// 比分块存储局部性更好；需要元素地址稳定时可以换成 tiny::deque<T>
+template<typename T, typename Container = tiny::ring_buffer<T>>
 class queue
 {
-pubblic:
+public:
     void push(const T& value)
     {
         _con.push_back(value);
     }
 
+    void push(T&& value)
+    {
+        _con.push_back(std::move(value));
+    }
+
+    template<typename... Args>
+    decltype(auto) emplace(Args&&... args)
+    {
+        return _con.emplace_back(std::forward<Args>(args)...);
+    }
+
+    // 批量入队/出队，要求底层容器支持 push_back_bulk/pop_front_bulk
+    void push_bulk(std::span<const T> values)
+    {
+        _con.push_back_bulk(values);
+    }
+
+    // 出队最多 out.size() 个元素到 out，返回实际个数
+    size_t pop_bulk(std::span<T> out)
+    {
+        return _con.pop_front_bulk(out);
+    }
+
     void pop()
     {
         _con.pop_front();
@@ -47,4 +74,4 @@ pubblic:
     }
 private:
     Container _con;
-};
\ No newline at end of file
+};
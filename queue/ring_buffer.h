@@ -0,0 +1,287 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace tiny {
+
+    // 可增长的环形缓冲区
+    // 容量始终是 2 的幂，下标用 & _mask 回绕，不做取模；
+    // 元素存放在一整块连续内存里，push_back/pop_front 都是 O(1)
+    template<typename T>
+    class ring_buffer
+    {
+    public:
+        using value_type = T;
+        using reference = T&;
+        using const_reference = const T&;
+        using size_type = size_t;
+
+        ring_buffer() = default;
+
+        explicit ring_buffer(size_t capacity)
+        {
+            reserve(capacity);
+        }
+
+        ring_buffer(const ring_buffer& other)
+        {
+            reserve(other._size);
+            for (size_t i = 0; i < other._size; ++i)
+            {
+                new (_data + i) T(other[i]);
+            }
+            _size = other._size;
+        }
+
+        ring_buffer(ring_buffer&& other) noexcept
+        {
+            swap(other);
+        }
+
+        ring_buffer& operator=(ring_buffer other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        ~ring_buffer()
+        {
+            clear();
+            deallocate_(_data);
+        }
+
+        void swap(ring_buffer& other) noexcept
+        {
+            std::swap(_data, other._data);
+            std::swap(_head, other._head);
+            std::swap(_size, other._size);
+            std::swap(_mask, other._mask);
+        }
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        size_t capacity() const { return _data ? _mask + 1 : 0; }
+
+        // 下标 0 是队头
+        T& operator[](size_t index)
+        {
+            assert(index < _size);
+            return _data[(_head + index) & _mask];
+        }
+
+        const T& operator[](size_t index) const
+        {
+            assert(index < _size);
+            return _data[(_head + index) & _mask];
+        }
+
+        T& front()
+        {
+            assert(!empty());
+            return _data[_head];
+        }
+
+        const T& front() const
+        {
+            assert(!empty());
+            return _data[_head];
+        }
+
+        T& back()
+        {
+            assert(!empty());
+            return _data[(_head + _size - 1) & _mask];
+        }
+
+        const T& back() const
+        {
+            assert(!empty());
+            return _data[(_head + _size - 1) & _mask];
+        }
+
+        // 满的时候先在新缓冲区里构造新元素，再搬旧元素：
+        // args 可能引用本缓冲区里的元素（rb.push_back(rb.front())），必须趁旧内存还在时读取
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (_size < capacity())
+            {
+                T* slot = _data + ((_head + _size) & _mask);
+                new (slot) T(std::forward<Args>(args)...);
+                ++_size;
+                return *slot;
+            }
+
+            const size_t new_cap = grown_capacity_(_size + 1);
+            T* newdata = allocate_(new_cap);
+            try
+            {
+                new (newdata + _size) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                deallocate_(newdata);
+                throw;
+            }
+            relocate_(newdata, new_cap, 1);
+            ++_size;
+            return newdata[_size - 1];
+        }
+
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_front()
+        {
+            assert(!empty());
+            _data[_head].~T();
+            _head = (_head + 1) & _mask;
+            --_size;
+        }
+
+        void pop_back()
+        {
+            assert(!empty());
+            --_size;
+            _data[(_head + _size) & _mask].~T();
+        }
+
+        // 批量入队：最多扩容一次，并按环回绕点分两段连续拷贝
+        // values 可以指向本缓冲区内的元素：需要扩容时先拷进新缓冲区再搬旧元素；
+        // 不扩容时只写空闲槽位，不会覆盖源元素。拷贝抛异常时缓冲区保持原样
+        void push_back_bulk(std::span<const T> values)
+        {
+            const size_t n = values.size();
+            if (n == 0) return;
+
+            if (_size + n > capacity())
+            {
+                const size_t new_cap = grown_capacity_(_size + n);
+                T* newdata = allocate_(new_cap);
+                try
+                {
+                    std::uninitialized_copy_n(values.data(), n, newdata + _size);
+                }
+                catch (...)
+                {
+                    deallocate_(newdata);
+                    throw;
+                }
+                relocate_(newdata, new_cap, n);
+                _size += n;
+                return;
+            }
+
+            const size_t tail = (_head + _size) & _mask;
+            const size_t first = std::min(n, capacity() - tail);
+            std::uninitialized_copy_n(values.data(), first, _data + tail);
+            try
+            {
+                std::uninitialized_copy_n(values.data() + first, n - first, _data);
+            }
+            catch (...)
+            {
+                std::destroy_n(_data + tail, first);
+                throw;
+            }
+            _size += n;
+        }
+
+        // 批量出队：把队头最多 out.size() 个元素移动到 out，返回实际出队个数
+        size_t pop_front_bulk(std::span<T> out)
+        {
+            const size_t n = std::min(out.size(), _size);
+            for (size_t i = 0; i < n; ++i)
+            {
+                T& slot = _data[(_head + i) & _mask];
+                out[i] = std::move(slot);
+                slot.~T();
+            }
+            _head = (_head + n) & _mask;
+            _size -= n;
+            return n;
+        }
+
+        void clear()
+        {
+            for (size_t i = 0; i < _size; ++i)
+            {
+                _data[(_head + i) & _mask].~T();
+            }
+            _head = 0;
+            _size = 0;
+        }
+
+        void reserve(size_t n)
+        {
+            if (n > capacity()) grow_(n);
+        }
+
+    private:
+        // 不小于 min_cap 的 2 的幂，至少翻倍
+        size_t grown_capacity_(size_t min_cap) const
+        {
+            size_t new_cap = capacity() ? capacity() * 2 : 8;
+            while (new_cap < min_cap) new_cap *= 2;
+            return new_cap;
+        }
+
+        static T* allocate_(size_t n)
+        {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        static void deallocate_(T* p)
+        {
+            ::operator delete(p, std::align_val_t(alignof(T)));
+        }
+
+        void grow_(size_t min_cap)
+        {
+            const size_t new_cap = grown_capacity_(min_cap);
+            relocate_(allocate_(new_cap), new_cap, 0);
+        }
+
+        // 把元素按顺序搬到 newdata 开头并切换过去；newdata[_size, _size + extra) 已经构造好。
+        // 拷贝构造抛异常时销毁新缓冲区里的一切，旧缓冲区保持不变
+        void relocate_(T* newdata, size_t new_cap, size_t extra)
+        {
+            size_t i = 0;
+            try
+            {
+                for (; i < _size; ++i) new (newdata + i) T(std::move_if_noexcept(_data[(_head + i) & _mask]));
+            }
+            catch (...)
+            {
+                std::destroy_n(newdata, i);
+                std::destroy_n(newdata + _size, extra);
+                deallocate_(newdata);
+                throw;
+            }
+            for (size_t j = 0; j < _size; ++j) _data[(_head + j) & _mask].~T();
+            deallocate_(_data);
+
+            _data = newdata;
+            _head = 0;
+            _mask = new_cap - 1;
+        }
+
+    private:
+        T*     _data = nullptr;
+        size_t _head = 0;   // 队头下标
+        size_t _size = 0;   // 元素个数
+        size_t _mask = 0;   // 容量 - 1
+    };
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace tiny {
+
+    // 有界、无锁、wait-free 的单生产者/单消费者队列
+    // 只允许一个线程 push、一个线程 pop
+    //
+    // _head 只由消费者写，_tail 只由生产者写，两者各占一条缓存行；
+    // 双方各自缓存一份对方的下标，只有在缓存值显示"满/空"时才去读对方的原子变量，
+    // 大多数操作不会触碰对方的缓存行
+    template<typename T>
+    class spsc_queue
+    {
+        static constexpr size_t kCacheLine = 64;
+
+    public:
+        // capacity 会向上取整到 2 的幂
+        explicit spsc_queue(size_t capacity)
+        {
+            assert(capacity > 0);
+            size_t n = 1;
+            while (n < capacity) n <<= 1;
+            _mask = n - 1;
+            _data = static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+
+        spsc_queue(const spsc_queue&) = delete;
+        spsc_queue& operator=(const spsc_queue&) = delete;
+
+        ~spsc_queue()
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            for (; head != tail; ++head)
+            {
+                _data[head & _mask].~T();
+            }
+            ::operator delete(_data, std::align_val_t(alignof(T)));
+        }
+
+        size_t capacity() const { return _mask + 1; }
+
+        // ---------- 生产者 ----------
+
+        template<typename... Args>
+        bool try_emplace(Args&&... args)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _head_cache == capacity())
+            {
+                _head_cache = _head.load(std::memory_order_acquire);
+                if (tail - _head_cache == capacity()) return false;
+            }
+
+            new (_data + (tail & _mask)) T(std::forward<Args>(args)...);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool try_push(const T& value)
+        {
+            return try_emplace(value);
+        }
+
+        bool try_push(T&& value)
+        {
+            return try_emplace(std::move(value));
+        }
+
+        // 尽可能多地入队，只发布一次 _tail，返回实际入队个数
+        size_t try_push_bulk(std::span<const T> values)
+        {
+            const size_t tail = _tail.load(std::memory_order_relaxed);
+            size_t free = capacity() - (tail - _head_cache);
+            if (free < values.size())
+            {
+                _head_cache = _head.load(std::memory_order_acquire);
+                free = capacity() - (tail - _head_cache);
+            }
+
+            const size_t n = std::min(free, values.size());
+            for (size_t i = 0; i < n; ++i)
+            {
+                new (_data + ((tail + i) & _mask)) T(values[i]);
+            }
+            if (n) _tail.store(tail + n, std::memory_order_release);
+            return n;
+        }
+
+        // ---------- 消费者 ----------
+
+        bool try_pop(T& out)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _tail_cache)
+            {
+                _tail_cache = _tail.load(std::memory_order_acquire);
+                if (head == _tail_cache) return false;
+            }
+
+            T& slot = _data[head & _mask];
+            out = std::move(slot);
+            slot.~T();
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 队头元素的指针，队列为空时返回 nullptr；配合 pop() 可以避免一次移动
+        T* front()
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _tail_cache)
+            {
+                _tail_cache = _tail.load(std::memory_order_acquire);
+                if (head == _tail_cache) return nullptr;
+            }
+            return _data + (head & _mask);
+        }
+
+        // 弹出 front() 返回的元素，调用前 front() 必须非空
+        void pop()
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            assert(head != _tail_cache);
+            _data[head & _mask].~T();
+            _head.store(head + 1, std::memory_order_release);
+        }
+
+        // 尽可能多地出队到 out，只发布一次 _head，返回实际出队个数
+        size_t try_pop_bulk(std::span<T> out)
+        {
+            const size_t head = _head.load(std::memory_order_relaxed);
+            size_t avail = _tail_cache - head;
+            if (avail < out.size())
+            {
+                _tail_cache = _tail.load(std::memory_order_acquire);
+                avail = _tail_cache - head;
+            }
+
+            const size_t n = std::min(avail, out.size());
+            for (size_t i = 0; i < n; ++i)
+            {
+                T& slot = _data[(head + i) & _mask];
+                out[i] = std::move(slot);
+                slot.~T();
+            }
+            if (n) _head.store(head + n, std::memory_order_release);
+            return n;
+        }
+
+        // ---------- 任意线程 ----------
+
+        // 近似值：读取时另一端可能正在修改
+        size_t size_approx() const
+        {
+            const size_t head = _head.load(std::memory_order_acquire);
+            const size_t tail = _tail.load(std::memory_order_acquire);
+            return tail - head;
+        }
+
+        bool empty_approx() const
+        {
+            return size_approx() == 0;
+        }
+
+    private:
+        // 只读字段，双方共享
+        T*     _data = nullptr;
+        size_t _mask = 0;
+
+        // 消费者独占的缓存行
+        alignas(kCacheLine) std::atomic<size_t> _head{0};
+        size_t _tail_cache = 0;
+
+        // 生产者独占的缓存行
+        alignas(kCacheLine) std::atomic<size_t> _tail{0};
+        size_t _head_cache = 0;
+    };
+}
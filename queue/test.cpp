@@ -0,0 +1,366 @@
+#include <iostream>
+#include <string>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cassert>
+#include "queue.h"
+#include "spsc_queue.h"
+#include "mpmc_queue.h"
+#include "ws_deque.h"
+#include "batch_queue.h"
+
+// 1. ring_buffer 的环回绕与扩容
+void test_ring_buffer() {
+    tiny::ring_buffer<int> rb;
+    assert(rb.empty() && rb.capacity() == 0);
+
+    // 让队头走到缓冲区中间，再写满触发回绕
+    for (int i = 0; i < 6; ++i) rb.push_back(i);
+    for (int i = 0; i < 5; ++i) rb.pop_front();
+    for (int i = 6; i < 13; ++i) rb.push_back(i);   // {5..12}，已回绕
+    assert(rb.size() == 8 && rb.capacity() == 8);
+    for (size_t i = 0; i < rb.size(); ++i) {
+        assert(rb[i] == int(i) + 5);
+    }
+
+    // 回绕状态下扩容，元素顺序不变，容量保持 2 的幂
+    rb.push_back(13);
+    assert(rb.capacity() == 16);
+    assert(rb.front() == 5 && rb.back() == 13);
+
+    rb.pop_back();
+    assert(rb.back() == 12);
+
+    // 拷贝与移动
+    tiny::ring_buffer<int> copy = rb;
+    tiny::ring_buffer<int> moved = std::move(rb);
+    assert(copy.size() == 8 && moved.size() == 8 && rb.empty());
+    assert(copy.front() == 5 && moved.back() == 12);
+
+    // 参数引用自身元素时扩容：新元素要在旧内存释放前构造
+    tiny::ring_buffer<std::string> srb;
+    for (int i = 0; i < 8; ++i) srb.push_back(std::string(32, char('a' + i)));
+    assert(srb.size() == srb.capacity());
+    srb.push_back(srb.front());
+    assert(srb.size() == 9 && srb.back() == std::string(32, 'a'));
+
+    // 批量入队的源数据就在缓冲区里，扩容与不扩容两种情况
+    tiny::ring_buffer<std::string> brb;
+    for (int i = 0; i < 8; ++i) brb.push_back(std::to_string(i));
+    brb.push_back_bulk(std::span<const std::string>(&brb[0], 1));   // 满了，扩容
+    assert(brb.size() == 9 && brb.back() == "0");
+    brb.pop_front();
+    brb.pop_front();
+    brb.push_back_bulk(std::span<const std::string>(&brb[0], 3));   // 不扩容，有空槽位
+    assert(brb.size() == 10 && brb[7] == "2" && brb[8] == "3" && brb[9] == "4");
+}
+
+// 2. queue 的基本操作与原地构造
+void test_queue() {
+    queue<std::string> q;
+    q.push("a");
+    std::string b = "b";
+    q.push(std::move(b));
+    q.emplace(3, 'c');
+    assert(q.size() == 3);
+    assert(q.front() == "a" && q.back() == "ccc");
+
+    q.pop();
+    assert(q.front() == "b");
+
+    // 只能移动的类型
+    queue<std::unique_ptr<int>> uq;
+    uq.push(std::make_unique<int>(1));
+    uq.emplace(new int(2));
+    assert(*uq.front() == 1 && *uq.back() == 2);
+    uq.pop();
+    assert(*uq.front() == 2);
+
+    // 仍然可以换成 std::deque 做底层容器
+    queue<int, std::deque<int>> dq;
+    dq.push(1);
+    dq.push(2);
+    dq.pop();
+    assert(dq.front() == 2 && dq.size() == 1);
+}
+
+// 3. 批量入队出队
+void test_bulk() {
+    queue<int> q;
+    for (int i = 0; i < 5; ++i) q.push(i);
+    q.pop();
+    q.pop();                                    // {2,3,4}
+
+    int in[10];
+    for (int i = 0; i < 10; ++i) in[i] = i + 5;
+    q.push_bulk(in);                            // {2..14}，跨越回绕点与扩容
+    assert(q.size() == 13);
+
+    int out[8];
+    size_t n = q.pop_bulk(out);
+    assert(n == 8);
+    for (int i = 0; i < 8; ++i) assert(out[i] == i + 2);
+
+    n = q.pop_bulk(out);
+    assert(n == 5 && q.empty());
+    assert(out[0] == 10 && out[4] == 14);
+}
+
+// 4. SPSC 队列
+void test_spsc_queue() {
+    tiny::spsc_queue<int> q(5);
+    assert(q.capacity() == 8);
+
+    // a. 单线程：满/空边界
+    for (int i = 0; i < 8; ++i) assert(q.try_push(i));
+    assert(!q.try_push(8));
+    int v = -1;
+    assert(q.try_pop(v) && v == 0);
+    assert(*q.front() == 1);
+    q.pop();
+    assert(q.size_approx() == 6);
+
+    // b. 批量操作只处理放得下/取得到的部分
+    int in[4] = {100, 101, 102, 103};
+    assert(q.try_push_bulk(in) == 2);
+    int out[16];
+    assert(q.try_pop_bulk(out) == 8);
+    assert(out[0] == 2 && out[7] == 101);
+    assert(q.front() == nullptr && !q.try_pop(v));
+
+    // c. 跨线程传递，验证顺序和完整性
+    const int N = 200000;
+    tiny::spsc_queue<int> pipe(1024);
+    std::thread producer([&] {
+        int next = 0;
+        int batch[32];
+        while (next < N) {
+            if (next % 3 == 0) {
+                int cnt = 0;
+                for (; cnt < 32 && next + cnt < N; ++cnt) batch[cnt] = next + cnt;
+                next += int(pipe.try_push_bulk(std::span<const int>(batch, cnt)));
+            } else if (pipe.try_push(next)) {
+                ++next;
+            }
+        }
+    });
+
+    int expected = 0;
+    int buf[64];
+    while (expected < N) {
+        size_t n = pipe.try_pop_bulk(buf);
+        for (size_t i = 0; i < n; ++i) assert(buf[i] == expected++);
+        if (pipe.try_pop(v)) assert(v == expected++);
+    }
+    producer.join();
+    assert(pipe.empty_approx());
+}
+
+// 5. MPMC 队列
+void test_mpmc_queue() {
+    using namespace std::chrono_literals;
+
+    // a. 单线程：满/空与超时
+    tiny::mpmc_queue<std::string> q(4);
+    assert(q.capacity() == 4);
+    for (int i = 0; i < 4; ++i) assert(q.try_push(std::to_string(i)));
+    assert(!q.try_push("x"));
+    assert(!q.push_for("x", 1ms));
+    std::string s;
+    assert(q.try_pop(s) && s == "0");
+    assert(q.push_for("4", 1ms));
+    for (int i = 1; i <= 4; ++i) {
+        q.pop(s);
+        assert(s == std::to_string(i));
+    }
+    assert(!q.pop_for(s, 1ms));
+
+    // b. 多生产者多消费者，队列很小以便频繁阻塞/唤醒
+    const int P = 4, C = 4, N = 20000;
+    tiny::mpmc_queue<int> mq(16);
+    std::atomic<long long> sum{0};
+    std::atomic<int> count{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < P; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 1; i <= N; ++i) mq.push(p * N + i);
+        });
+    }
+    for (int c = 0; c < C; ++c) {
+        threads.emplace_back([&] {
+            int v;
+            while (count.load() < P * N) {
+                if (mq.pop_for(v, 10ms)) {
+                    sum += v;
+                    ++count;
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    long long total = (long long)P * N;
+    assert(count.load() == total);
+    assert(sum.load() == total * (total + 1) / 2);
+    assert(mq.empty_approx());
+}
+
+// 6. 工作窃取双端队列
+void test_ws_deque() {
+    // a. 拥有者单线程：底部 LIFO，顶部 FIFO，自动扩容
+    tiny::ws_deque<int> d(4);
+    for (int i = 0; i < 10; ++i) d.push(i);
+    assert(d.capacity() >= 10 && d.size_approx() == 10);
+    assert(d.pop().value() == 9);
+    assert(d.steal().value() == 0);
+    assert(d.size_approx() == 8);
+    while (d.pop()) {}
+    assert(!d.steal() && !d.pop());
+
+    // b. 拥有者边推边弹，多个窃取者同时偷，每个元素恰好被取走一次
+    const int N = 100000, THIEVES = 3;
+    tiny::ws_deque<int> wd(8);
+    std::vector<std::atomic<int>> seen(N);
+    std::atomic<bool> done{false};
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; ++t) {
+        thieves.emplace_back([&] {
+            while (!done.load()) {
+                if (auto v = wd.steal()) ++seen[*v];
+            }
+            while (auto v = wd.steal()) ++seen[*v];
+        });
+    }
+    for (int i = 0; i < N; ++i) {
+        wd.push(i);
+        if (i % 3 == 0) {
+            if (auto v = wd.pop()) ++seen[*v];
+        }
+    }
+    while (auto v = wd.pop()) ++seen[*v];
+    done = true;
+    for (auto& th : thieves) th.join();
+
+    for (int i = 0; i < N; ++i) assert(seen[i].load() == 1);
+}
+
+// 7. 批量取出队列
+void test_batch_queue() {
+    using namespace std::chrono_literals;
+
+    // a. 单线程：全部取出走交换路径，部分取出按 FIFO 顺序追加
+    tiny::batch_queue<std::string> q;
+    std::string in[5] = {"a", "b", "c", "d", "e"};
+    assert(q.push_bulk(in) && q.push("f") && q.size() == 6);
+
+    tiny::vector<std::string> out;
+    assert(q.try_drain(out, 2) == 2 && out.size() == 2 && out[1] == "b");
+    assert(q.try_drain(out, 3) == 3 && out.size() == 5 && out[4] == "e");
+    assert(q.try_drain(out) == 1 && out.back() == "f" && q.empty());
+    assert(q.try_drain(out) == 0 && out.size() == 6);
+
+    tiny::vector<std::string> batch;
+    for (int i = 0; i < 100; ++i) q.push(std::to_string(i));
+    assert(q.drain(batch) == 100 && batch.size() == 100 && batch[99] == "99");
+    assert(q.drain_for(batch, 1ms) == 0 && batch.size() == 100);
+
+    // b. 部分取出与入队交替，空洞被压缩后顺序仍然正确
+    tiny::batch_queue<int> iq;
+    int next_in = 0, next_out = 0;
+    tiny::vector<int> ibuf;
+    for (int round = 0; round < 1000; ++round) {
+        for (int k = 0; k < 7; ++k) iq.push(next_in++);
+        ibuf.clear();
+        iq.try_drain(ibuf, 5);
+        for (size_t i = 0; i < ibuf.size(); ++i) assert(ibuf[i] == next_out++);
+    }
+    ibuf.clear();
+    iq.try_drain(ibuf);
+    for (size_t i = 0; i < ibuf.size(); ++i) assert(ibuf[i] == next_out++);
+    assert(next_out == next_in);
+
+    // c. 关闭：入队失败，剩余元素仍可取出，之后 drain 立即返回 0
+    iq.push(1);
+    iq.close();
+    assert(!iq.push(2) && iq.closed());
+    ibuf.clear();
+    assert(iq.drain(ibuf) == 1 && iq.drain(ibuf) == 0);
+
+    // d. out 用的是消费者自己的 arena：不能把 arena 换给队列，arena 销毁后队列照常工作
+    {
+        tiny::batch_queue<std::string> aq;
+        auto arena = std::make_unique<tiny::monotonic_buffer_resource>();
+        {
+            tiny::vector<std::string> local(arena.get());
+            for (int i = 0; i < 10; ++i) aq.push(std::string(40, char('a' + i)));
+            assert(aq.drain(local) == 10 && local.size() == 10 && local.resource() == arena.get());
+        }
+        arena.reset();
+        for (int i = 0; i < 100; ++i) aq.push(std::to_string(i));
+        tiny::vector<std::string> rest;
+        assert(aq.drain(rest) == 100 && rest[99] == "99");
+    }
+
+    // e. 一次 push_bulk 唤醒一个消费者，它只取一部分时其余等待者也要被叫醒
+    {
+        tiny::batch_queue<int> wq;
+        std::atomic<int> got{0};
+        std::vector<std::thread> waiters;
+        for (int c = 0; c < 4; ++c) {
+            waiters.emplace_back([&] {
+                tiny::vector<int> local;
+                if (wq.drain(local, 1) == 1) ++got;   // 每个只取一个，然后退出
+            });
+        }
+        std::this_thread::sleep_for(20ms);   // 让 4 个消费者都挂起
+        int four[4] = {1, 2, 3, 4};
+        wq.push_bulk(four);
+        for (auto& th : waiters) th.join();   // 修复前会有消费者永远睡着
+        assert(got == 4 && wq.empty());
+    }
+
+    // f. 多生产者按 span 入队，多消费者阻塞批量取出，每个元素恰好取到一次
+    const int P = 4, C = 3, N = 20000, CHUNK = 16;
+    tiny::batch_queue<int> mq;
+    std::vector<std::atomic<int>> seen(P * N);
+    std::vector<std::thread> producers, consumers;
+    for (int p = 0; p < P; ++p) {
+        producers.emplace_back([&, p] {
+            int chunk[CHUNK];
+            for (int i = 0; i < N; i += CHUNK) {
+                for (int k = 0; k < CHUNK; ++k) chunk[k] = p * N + i + k;
+                mq.push_bulk(chunk);
+            }
+        });
+    }
+    for (int c = 0; c < C; ++c) {
+        consumers.emplace_back([&] {
+            tiny::vector<int> local;
+            for (;;) {
+                local.clear();
+                if (mq.drain(local, 256) == 0) break;
+                for (size_t i = 0; i < local.size(); ++i) ++seen[local[i]];
+            }
+        });
+    }
+    for (auto& th : producers) th.join();
+    mq.close();
+    for (auto& th : consumers) th.join();
+    for (int i = 0; i < P * N; ++i) assert(seen[i].load() == 1);
+}
+
+int main() {
+    test_ring_buffer();
+    test_queue();
+    test_bulk();
+    test_spsc_queue();
+    test_mpmc_queue();
+    test_ws_deque();
+    test_batch_queue();
+    std::cout << "all queue tests passed!" << std::endl;
+    return 0;
+}
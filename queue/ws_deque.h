@@ -0,0 +1,172 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace tiny {
+
+    // Chase-Lev 工作窃取双端队列（内存序按 Lê 等人的 C11 版本）
+    //
+    // 拥有者线程在底部 push/pop（LIFO，局部性好），
+    // 其它线程从顶部 steal（FIFO，偷走最老、通常也是最大的任务）
+    // 只有底部只剩一个元素时拥有者才需要和窃取者竞争一次 CAS
+    //
+    // 存储满了由拥有者扩容为两倍；旧数组可能仍被窃取者读取，
+    // 所以不立即释放，而是留到析构时统一回收
+    //
+    // 窃取者可能读到正在被覆盖的槽位再由 CAS 判定作废，
+    // 因此 T 必须可以平凡拷贝，典型用法是存任务指针
+    template<typename T>
+    class ws_deque
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "ws_deque<T> requires a trivially copyable T");
+
+        static constexpr size_t kCacheLine = 64;
+
+    public:
+        // capacity 会向上取整到 2 的幂
+        explicit ws_deque(size_t capacity = 64)
+        {
+            size_t n = 2;
+            while (n < capacity) n <<= 1;
+            _array.store(new Array(n), std::memory_order_relaxed);
+        }
+
+        ws_deque(const ws_deque&) = delete;
+        ws_deque& operator=(const ws_deque&) = delete;
+
+        ~ws_deque()
+        {
+            delete _array.load(std::memory_order_relaxed);
+            for (Array* old : _retired) delete old;
+        }
+
+        // ---------- 仅拥有者线程 ----------
+
+        void push(T value)
+        {
+            const int64_t b = _bottom.load(std::memory_order_relaxed);
+            const int64_t t = _top.load(std::memory_order_acquire);
+            Array* a = _array.load(std::memory_order_relaxed);
+
+            if (b - t > static_cast<int64_t>(a->capacity) - 1)
+            {
+                a = grow(a, b, t);
+            }
+
+            a->put(b, value);
+            std::atomic_thread_fence(std::memory_order_release);
+            _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        std::optional<T> pop()
+        {
+            const int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+            Array* a = _array.load(std::memory_order_relaxed);
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = _top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                // 已经空了，恢复 bottom
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T value = a->get(b);
+            if (t == b)
+            {
+                // 最后一个元素，和窃取者抢
+                const bool won = _top.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed);
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                if (!won) return std::nullopt;
+            }
+            return value;
+        }
+
+        // ---------- 任意线程 ----------
+
+        // 偷顶部最老的元素；队列为空或与别人竞争失败时返回空，调用方可以稍后重试
+        std::optional<T> steal()
+        {
+            int64_t t = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = _bottom.load(std::memory_order_acquire);
+
+            if (t >= b) return std::nullopt;
+
+            Array* a = _array.load(std::memory_order_acquire);
+            T value = a->get(t);
+            if (!_top.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        // 近似值：并发修改时只是某一时刻的快照
+        size_t size_approx() const
+        {
+            const int64_t b = _bottom.load(std::memory_order_relaxed);
+            const int64_t t = _top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<size_t>(b - t) : 0;
+        }
+
+        bool empty_approx() const
+        {
+            return size_approx() == 0;
+        }
+
+        size_t capacity() const
+        {
+            return _array.load(std::memory_order_relaxed)->capacity;
+        }
+
+    private:
+        // 环形数组，下标是单调递增的 64 位位置，用掩码回绕
+        struct Array
+        {
+            explicit Array(size_t n) : capacity(n), mask(n - 1), slots(new std::atomic<T>[n]) {}
+            ~Array() { delete[] slots; }
+
+            T get(int64_t i) const
+            {
+                return slots[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(int64_t i, T value)
+            {
+                slots[static_cast<size_t>(i) & mask].store(value, std::memory_order_relaxed);
+            }
+
+            const size_t capacity;
+            const size_t mask;
+            std::atomic<T>* slots;
+        };
+
+        Array* grow(Array* old, int64_t b, int64_t t)
+        {
+            Array* a = new Array(old->capacity * 2);
+            for (int64_t i = t; i < b; ++i)
+            {
+                a->put(i, old->get(i));
+            }
+            _retired.push_back(old);
+            _array.store(a, std::memory_order_release);
+            return a;
+        }
+
+    private:
+        alignas(kCacheLine) std::atomic<int64_t> _top{0};
+        alignas(kCacheLine) std::atomic<int64_t> _bottom{0};
+        std::atomic<Array*> _array{nullptr};
+        std::vector<Array*> _retired;   // 只由拥有者访问
+    };
+}
@@ -0,0 +1,537 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "../memory/memory_resource.h"
+#include "../vector/vector.h"
+#include "../string/string.h"
+#include "../list/list.h"
+
+namespace tiny {
+
+    // 二进制格式：
+    //   整数/浮点/枚举   定长小端
+    //   bool            1 字节
+    //   string          u64 长度 + 原始字节
+    //   vector / list   u64 元素个数 + 逐个元素；元素可按位存放时整段一次 memcpy
+    // 不带任何对齐填充，反序列化时可以直接在 mmap 或网络缓冲区上建立视图
+
+    // 可以按位整段拷贝的类型：算术类型与枚举（bool 除外）。
+    // 没有填充字节的可平凡拷贝结构体可以特化为 true，按主机布局整块写入
+    template<typename T, typename = void>
+    struct is_bitwise_serializable : std::false_type {};
+
+    template<typename T>
+    struct is_bitwise_serializable<T, std::enable_if_t<(std::is_arithmetic_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>>>
+        : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool is_bitwise_serializable_v = is_bitwise_serializable<T>::value;
+
+    namespace detail {
+
+        // 大端主机上算术类型要逐个翻转字节；小端主机上什么也不做
+        template<typename T>
+        inline constexpr bool needs_byteswap_v =
+            std::endian::native == std::endian::big && (std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) > 1;
+
+        template<typename T>
+        T byteswap(T value)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (size_t i = 0; i < sizeof(T) / 2; ++i) std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+
+        // 从任意（可能不对齐的）地址读一个小端值
+        template<typename T>
+        T load_le(const unsigned char* p)
+        {
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            if constexpr (needs_byteswap_v<T>) value = byteswap(value);
+            return value;
+        }
+    }
+
+    // 序列化输出缓冲区，按 2 倍增长，内存来自 memory_resource
+    class binary_writer
+    {
+    public:
+        binary_writer() = default;
+
+        explicit binary_writer(memory_resource* r)
+            : _resource(r)
+        {
+            assert(r);
+        }
+
+        binary_writer(const binary_writer&) = delete;
+        binary_writer& operator=(const binary_writer&) = delete;
+
+        ~binary_writer()
+        {
+            _resource->deallocate(_data, _capacity, 1);
+        }
+
+        const unsigned char* data() const { return _data; }
+        size_t size() const { return _size; }
+        std::span<const unsigned char> bytes() const { return { _data, _size }; }
+
+        void clear() { _size = 0; }
+
+        void reserve(size_t n)
+        {
+            if (n > _capacity) reallocate_(n);
+        }
+
+        void write_bytes(const void* p, size_t n)
+        {
+            if (n == 0) return;
+            if (_size + n > _capacity) grow_(_size + n);
+            std::memcpy(_data + _size, p, n);
+            _size += n;
+        }
+
+        template<typename T> requires is_bitwise_serializable_v<T>
+        void write(T value)
+        {
+            if constexpr (detail::needs_byteswap_v<T>) value = detail::byteswap(value);
+            write_bytes(&value, sizeof(T));
+        }
+
+        // 按位类型的数组：小端主机上一次 memcpy
+        template<typename T> requires is_bitwise_serializable_v<T>
+        void write_array(const T* p, size_t n)
+        {
+            if constexpr (detail::needs_byteswap_v<T>)
+            {
+                reserve(_size + n * sizeof(T));
+                for (size_t i = 0; i < n; ++i) write(p[i]);
+            }
+            else
+            {
+                write_bytes(p, n * sizeof(T));
+            }
+        }
+
+        void write_size(size_t n) { write(static_cast<uint64_t>(n)); }
+
+    private:
+        void grow_(size_t min_cap)
+        {
+            size_t new_cap = _capacity ? _capacity * 2 : 256;
+            if (new_cap < min_cap) new_cap = min_cap;
+            reallocate_(new_cap);
+        }
+
+        void reallocate_(size_t new_cap)
+        {
+            unsigned char* tmp = static_cast<unsigned char*>(_resource->allocate(new_cap, 1));
+            if (_size) std::memcpy(tmp, _data, _size);
+            _resource->deallocate(_data, _capacity, 1);
+            _data = tmp;
+            _capacity = new_cap;
+        }
+
+    private:
+        unsigned char* _data = nullptr;
+        size_t _size = 0;
+        size_t _capacity = 0;
+        memory_resource* _resource = get_default_resource();
+    };
+
+    // 在一段只读字节上顺序读取，不拷贝底层缓冲区。
+    // 数据不够时置失败标志并停在原处，之后的读取都直接失败，最后检查一次 ok() 即可
+    class binary_reader
+    {
+    public:
+        binary_reader(const void* data, size_t size)
+            : _cur(static_cast<const unsigned char*>(data)),
+              _end(static_cast<const unsigned char*>(data) + size)
+        {}
+
+        explicit binary_reader(std::span<const unsigned char> bytes)
+            : binary_reader(bytes.data(), bytes.size())
+        {}
+
+        bool ok() const { return _ok; }
+        size_t remaining() const { return _end - _cur; }
+
+        // 返回指向缓冲区内部的指针并前进 n 字节；失败返回 nullptr
+        const unsigned char* read_bytes(size_t n)
+        {
+            if (!_ok || n > remaining())
+            {
+                _ok = false;
+                return nullptr;
+            }
+            const unsigned char* p = _cur;
+            _cur += n;
+            return p;
+        }
+
+        template<typename T> requires is_bitwise_serializable_v<T>
+        bool read(T& value)
+        {
+            const unsigned char* p = read_bytes(sizeof(T));
+            if (!p) return false;
+            value = detail::load_le<T>(p);
+            return true;
+        }
+
+        // 元素个数；超过剩余字节能容纳的数量视为损坏，避免按伪造的长度分配巨量内存
+        bool read_size(size_t& n, size_t min_element_bytes)
+        {
+            uint64_t count = 0;
+            if (!read(count)) return false;
+            if (min_element_bytes && count > remaining() / min_element_bytes)
+            {
+                _ok = false;
+                return false;
+            }
+            n = static_cast<size_t>(count);
+            return true;
+        }
+
+        void fail() { _ok = false; }
+
+    private:
+        const unsigned char* _cur;
+        const unsigned char* _end;
+        bool _ok = true;
+    };
+
+    // 每种类型的读写方式，自定义类型特化 serializer<T> 提供 write/read 即可嵌套在容器里
+    template<typename T, typename = void>
+    struct serializer;
+
+    namespace detail {
+        // 序列化后每个元素至少占用的字节数，用来校验读到的元素个数。
+        // 未声明时按 1 字节校验；确实不占字节的类型需要显式声明 min_bytes = 0
+        template<typename T>
+        constexpr size_t serialized_min_bytes()
+        {
+            if constexpr (requires { serializer<T>::min_bytes; })
+                return serializer<T>::min_bytes;
+            else
+                return 1;
+        }
+    }
+
+    template<typename T>
+    struct serializer<T, std::enable_if_t<is_bitwise_serializable_v<T>>>
+    {
+        static constexpr size_t min_bytes = sizeof(T);
+
+        static void write(binary_writer& w, const T& value)
+        {
+            if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+                w.write(value);
+            else
+                w.write_bytes(&value, sizeof(T));
+        }
+
+        static bool read(binary_reader& r, T& value)
+        {
+            if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>)
+                return r.read(value);
+
+            const unsigned char* p = r.read_bytes(sizeof(T));
+            if (p) std::memcpy(&value, p, sizeof(T));
+            return p != nullptr;
+        }
+    };
+
+    template<>
+    struct serializer<bool>
+    {
+        static constexpr size_t min_bytes = 1;
+
+        static void write(binary_writer& w, bool value)
+        {
+            w.write(static_cast<uint8_t>(value));
+        }
+
+        static bool read(binary_reader& r, bool& value)
+        {
+            uint8_t byte = 0;
+            if (!r.read(byte)) return false;
+            if (byte > 1) r.fail();
+            value = byte == 1;
+            return r.ok();
+        }
+    };
+
+    template<>
+    struct serializer<string>
+    {
+        static constexpr size_t min_bytes = sizeof(uint64_t);
+
+        static void write(binary_writer& w, const string& s)
+        {
+            w.write_size(s.size());
+            w.write_bytes(s.data(), s.size());
+        }
+
+        static bool read(binary_reader& r, string& s)
+        {
+            size_t n = 0;
+            if (!r.read_size(n, 1)) return false;
+            const unsigned char* p = r.read_bytes(n);
+            if (!p) return false;
+            s.resize(n);
+            if (n) std::memcpy(s.begin(), p, n);
+            return true;
+        }
+    };
+
+    template<typename T>
+    struct serializer<vector<T>, std::enable_if_t<!std::is_same_v<T, bool>>>
+    {
+        static constexpr size_t min_bytes = sizeof(uint64_t);
+
+        static void write(binary_writer& w, const vector<T>& v)
+        {
+            w.write_size(v.size());
+            if constexpr (is_bitwise_serializable_v<T>)
+            {
+                w.write_array(v.data(), v.size());
+            }
+            else
+            {
+                for (const T& item : v) serializer<T>::write(w, item);
+            }
+        }
+
+        // 读入 v 原有的资源里
+        static bool read(binary_reader& r, vector<T>& v)
+        {
+            size_t n = 0;
+            if (!r.read_size(n, detail::serialized_min_bytes<T>())) return false;
+            v.clear();
+            if constexpr (is_bitwise_serializable_v<T>)
+            {
+                const unsigned char* p = r.read_bytes(n * sizeof(T));
+                if (!p) return false;
+                v.resize(n);
+                if constexpr (detail::needs_byteswap_v<T>)
+                {
+                    for (size_t i = 0; i < n; ++i) v[i] = detail::load_le<T>(p + i * sizeof(T));
+                }
+                else if (n)
+                {
+                    std::memcpy(v.data(), p, n * sizeof(T));
+                }
+                return true;
+            }
+            else
+            {
+                // 元素个数可能没有被校验（min_bytes = 0），预留的空间不超过剩余字节数
+                v.reserve(std::min(n, r.remaining()));
+                for (size_t i = 0; i < n; ++i)
+                {
+                    T& item = emplace_in_(v);
+                    if (!serializer<T>::read(r, item)) return false;
+                }
+                return true;
+            }
+        }
+
+    private:
+        // 嵌套容器与外层共用同一个资源
+        static T& emplace_in_(vector<T>& v)
+        {
+            if constexpr (std::is_constructible_v<T, memory_resource*>)
+                return v.emplace_back(v.resource());
+            else
+                return v.emplace_back();
+        }
+    };
+
+    template<typename T>
+    struct serializer<list<T>>
+    {
+        static constexpr size_t min_bytes = sizeof(uint64_t);
+
+        static void write(binary_writer& w, const list<T>& l)
+        {
+            w.write_size(l.size());
+            for (const T& item : l) serializer<T>::write(w, item);
+        }
+
+        static bool read(binary_reader& r, list<T>& l)
+        {
+            size_t n = 0;
+            if (!r.read_size(n, detail::serialized_min_bytes<T>())) return false;
+            l.clear();
+            for (size_t i = 0; i < n; ++i)
+            {
+                T* item;
+                if constexpr (std::is_constructible_v<T, memory_resource*>)
+                    item = &l.emplace_back(l.resource());
+                else
+                    item = &l.emplace_back();
+                if (!serializer<T>::read(r, *item)) return false;
+            }
+            return true;
+        }
+    };
+
+    template<typename T>
+    void serialize(binary_writer& w, const T& value)
+    {
+        serializer<T>::write(w, value);
+    }
+
+    // 失败（数据截断或损坏）时返回 false，value 处于有效但未指定的状态
+    template<typename T>
+    bool deserialize(binary_reader& r, T& value)
+    {
+        return serializer<T>::read(r, value) && r.ok();
+    }
+
+    template<typename T>
+    bool deserialize(std::span<const unsigned char> bytes, T& value)
+    {
+        binary_reader r(bytes);
+        return deserialize(r, value);
+    }
+
+    // 零拷贝视图：直接指向输入缓冲区里按位存放的数组。
+    // 缓冲区可能不满足 T 的对齐，元素按值读出（编译成普通的非对齐加载）
+    template<typename T> requires is_bitwise_serializable_v<T>
+    class vector_view
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = T;
+            using pointer = void;
+
+            iterator() = default;
+            explicit iterator(const unsigned char* p) : _p(p) {}
+
+            T operator*() const { return detail::load_le<T>(_p); }
+            T operator[](difference_type n) const { return detail::load_le<T>(_p + n * sizeof(T)); }
+
+            iterator& operator++() { _p += sizeof(T); return *this; }
+            iterator& operator--() { _p -= sizeof(T); return *this; }
+            iterator operator++(int) { iterator tmp(*this); _p += sizeof(T); return tmp; }
+            iterator operator--(int) { iterator tmp(*this); _p -= sizeof(T); return tmp; }
+            iterator& operator+=(difference_type n) { _p += n * difference_type(sizeof(T)); return *this; }
+            iterator& operator-=(difference_type n) { _p -= n * difference_type(sizeof(T)); return *this; }
+            iterator operator+(difference_type n) const { return iterator(_p + n * difference_type(sizeof(T))); }
+            iterator operator-(difference_type n) const { return iterator(_p - n * difference_type(sizeof(T))); }
+            difference_type operator-(const iterator& it) const { return (_p - it._p) / difference_type(sizeof(T)); }
+
+            bool operator==(const iterator& it) const { return _p == it._p; }
+            bool operator!=(const iterator& it) const { return _p != it._p; }
+            bool operator<(const iterator& it) const { return _p < it._p; }
+
+        private:
+            const unsigned char* _p = nullptr;
+        };
+
+        vector_view() = default;
+
+        vector_view(const unsigned char* bytes, size_t size)
+            : _bytes(bytes), _size(size)
+        {}
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        T operator[](size_t index) const
+        {
+            assert(index < _size);
+            return detail::load_le<T>(_bytes + index * sizeof(T));
+        }
+
+        iterator begin() const { return iterator(_bytes); }
+        iterator end() const { return iterator(_bytes + _size * sizeof(T)); }
+
+        // 底层字节，可直接整段拷走
+        const unsigned char* bytes() const { return _bytes; }
+
+        // 小端主机且缓冲区恰好对齐时可以当作 T 数组使用，否则返回 nullptr
+        const T* data() const
+        {
+            if constexpr (detail::needs_byteswap_v<T>) return nullptr;
+            if (reinterpret_cast<uintptr_t>(_bytes) % alignof(T) != 0) return nullptr;
+            return reinterpret_cast<const T*>(_bytes);
+        }
+
+        // 拷贝成真正的容器
+        vector<T> to_vector(memory_resource* r = get_default_resource()) const
+        {
+            vector<T> v(r);
+            v.resize(_size);
+            if constexpr (detail::needs_byteswap_v<T>)
+            {
+                for (size_t i = 0; i < _size; ++i) v[i] = (*this)[i];
+            }
+            else if (_size)
+            {
+                std::memcpy(v.data(), _bytes, _size * sizeof(T));
+            }
+            return v;
+        }
+
+    private:
+        const unsigned char* _bytes = nullptr;
+        size_t _size = 0;
+    };
+
+    // 读出 string 的视图，指向输入缓冲区
+    inline bool read_view(binary_reader& r, std::string_view& view)
+    {
+        size_t n = 0;
+        if (!r.read_size(n, 1)) return false;
+        const unsigned char* p = r.read_bytes(n);
+        if (!p) return false;
+        view = std::string_view(reinterpret_cast<const char*>(p), n);
+        return true;
+    }
+
+    // 读出按位存放的 vector<T> 的视图，指向输入缓冲区
+    template<typename T>
+    bool read_view(binary_reader& r, vector_view<T>& view)
+    {
+        size_t n = 0;
+        if (!r.read_size(n, sizeof(T))) return false;
+        const unsigned char* p = r.read_bytes(n * sizeof(T));
+        if (!p) return false;
+        view = vector_view<T>(p, n);
+        return true;
+    }
+
+    // 外层是 vector/list、元素是 string 或按位数组时，逐个读出视图，不拷贝元素内容
+    template<typename View>
+    bool read_views(binary_reader& r, vector<View>& views)
+    {
+        size_t n = 0;
+        if (!r.read_size(n, sizeof(uint64_t))) return false;
+        views.clear();
+        views.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (!read_view(r, views.emplace_back())) return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,196 @@
+#include <iostream>
+#include <cstdint>
+#include <cassert>
+#include <stdexcept>
+#include "serialize.h"
+
+enum class color : uint8_t { red, green, blue };
+
+struct point { int32_t x; int32_t y; };
+
+// 没有填充的结构体可以声明为按位存放
+template<>
+struct tiny::is_bitwise_serializable<point> : std::true_type {};
+
+// 自定义类型：特化 serializer 后可以放进任意容器
+struct record
+{
+    tiny::string name;
+    tiny::vector<double> samples;
+    bool active = false;
+};
+
+template<>
+struct tiny::serializer<record>
+{
+    static void write(binary_writer& w, const record& r)
+    {
+        serialize(w, r.name);
+        serialize(w, r.samples);
+        serialize(w, r.active);
+    }
+
+    static bool read(binary_reader& in, record& r)
+    {
+        return deserialize(in, r.name) && deserialize(in, r.samples) && deserialize(in, r.active);
+    }
+};
+
+// 1. 标量与字符串，确认是小端定长格式
+void test_scalars() {
+    tiny::binary_writer w;
+    tiny::serialize(w, uint32_t(0x01020304));
+    tiny::serialize(w, -1.5);
+    tiny::serialize(w, color::blue);
+    tiny::serialize(w, true);
+    tiny::serialize(w, tiny::string("hi"));
+    assert(w.size() == 4 + 8 + 1 + 1 + 8 + 2);
+    assert(w.data()[0] == 0x04 && w.data()[3] == 0x01);
+    assert(w.data()[14] == 2 && w.data()[22] == 'h');
+
+    tiny::binary_reader r(w.bytes());
+    uint32_t u = 0; double d = 0; color c = color::red; bool b = false; tiny::string s;
+    assert(tiny::deserialize(r, u) && tiny::deserialize(r, d) && tiny::deserialize(r, c));
+    assert(tiny::deserialize(r, b) && tiny::deserialize(r, s));
+    assert(u == 0x01020304 && d == -1.5 && c == color::blue && b && s == tiny::string("hi"));
+    assert(r.remaining() == 0);
+}
+
+// 2. 嵌套容器往返
+void test_containers() {
+    tiny::vector<int64_t> numbers;
+    for (int i = 0; i < 10000; ++i) numbers.push_back(int64_t(i) * 1000003 - 7);
+
+    tiny::vector<tiny::vector<tiny::string>> table;
+    for (int r = 0; r < 20; ++r) {
+        table.emplace_back();
+        for (int c = 0; c < r; ++c) table.back().push_back(tiny::string("cell"));
+    }
+
+    tiny::list<record> records;
+    for (int i = 0; i < 50; ++i) {
+        record& rec = records.emplace_back();
+        rec.name = tiny::string("sensor");
+        rec.name.push_back(char('a' + i % 26));
+        for (int k = 0; k < i; ++k) rec.samples.push_back(k * 0.5);
+        rec.active = i % 2 == 0;
+    }
+
+    tiny::vector<point> points;
+    for (int i = 0; i < 100; ++i) points.push_back({i, -i});
+
+    tiny::binary_writer w;
+    tiny::serialize(w, numbers);
+    tiny::serialize(w, table);
+    tiny::serialize(w, records);
+    tiny::serialize(w, points);
+
+    tiny::binary_reader r(w.bytes());
+    tiny::vector<int64_t> numbers2;
+    tiny::vector<tiny::vector<tiny::string>> table2;
+    tiny::list<record> records2;
+    tiny::vector<point> points2;
+    assert(tiny::deserialize(r, numbers2) && tiny::deserialize(r, table2));
+    assert(tiny::deserialize(r, records2) && tiny::deserialize(r, points2));
+    assert(r.remaining() == 0);
+
+    assert(numbers2.size() == numbers.size());
+    for (size_t i = 0; i < numbers.size(); ++i) assert(numbers2[i] == numbers[i]);
+    assert(table2.size() == 20 && table2[19].size() == 19 && table2[19][18] == tiny::string("cell"));
+    assert(records2.size() == 50);
+    auto it = records2.begin();
+    for (const record& rec : records) {
+        assert(it->name == rec.name && it->active == rec.active && it->samples.size() == rec.samples.size());
+        ++it;
+    }
+    assert(points2.size() == 100 && points2[42].x == 42 && points2[42].y == -42);
+
+    // 读入 arena：嵌套的元素也落在同一个资源里
+    tiny::monotonic_buffer_resource arena;
+    tiny::vector<tiny::vector<tiny::string>> in_arena(&arena);
+    tiny::binary_reader r2(w.bytes());
+    assert(tiny::deserialize(r2, numbers2) && tiny::deserialize(r2, in_arena));
+    assert(in_arena[5].resource() == &arena && in_arena[5][0].resource() == &arena);
+}
+
+// 3. 截断、伪造长度都能被发现
+void test_corrupt_input() {
+    tiny::vector<tiny::string> words;
+    for (int i = 0; i < 10; ++i) words.push_back(tiny::string("word"));
+    tiny::binary_writer w;
+    tiny::serialize(w, words);
+
+    for (size_t cut = 0; cut < w.size(); ++cut) {
+        tiny::vector<tiny::string> out;
+        assert(!tiny::deserialize(std::span<const unsigned char>(w.data(), cut), out));
+    }
+
+    // 声称有 2^60 个元素
+    tiny::binary_writer bad;
+    bad.write_size(size_t(1) << 60);
+    tiny::vector<int> out;
+    assert(!tiny::deserialize(bad.bytes(), out));
+
+    // 自定义 serializer 没有声明 min_bytes 时元素个数同样要校验，
+    // 伪造的个数不能直接拿去 reserve（n * sizeof(record) 会溢出）
+    tiny::binary_writer forged;
+    forged.write_size(size_t(768614336404564651ull));
+    forged.write_size(0);
+    tiny::vector<record> records;
+    assert(!tiny::deserialize(forged.bytes(), records));
+    assert(records.capacity() < 16);
+
+    // vector 本身拒绝字节数溢出的容量
+    bool threw = false;
+    try { records.reserve(tiny::vector<record>::max_size() + 1); } catch (const std::length_error&) { threw = true; }
+    assert(threw);
+
+    unsigned char not_bool = 7;
+    bool b;
+    assert(!tiny::deserialize(std::span<const unsigned char>(&not_bool, 1), b));
+}
+
+// 4. 零拷贝视图：直接指向输入缓冲区，包括不对齐的位置
+void test_views() {
+    tiny::vector<uint32_t> ids;
+    for (uint32_t i = 0; i < 1000; ++i) ids.push_back(i * 3);
+    tiny::vector<tiny::string> names;
+    names.push_back(tiny::string("alpha"));
+    names.push_back(tiny::string("beta"));
+
+    tiny::binary_writer w;
+    tiny::serialize(w, uint8_t(1));   // 让后面的数组不对齐
+    tiny::serialize(w, ids);
+    tiny::serialize(w, tiny::string("header"));
+    tiny::serialize(w, names);
+
+    tiny::binary_reader r(w.bytes());
+    uint8_t tag;
+    tiny::vector_view<uint32_t> id_view;
+    std::string_view header;
+    tiny::vector<std::string_view> name_views;
+    assert(r.read(tag) && tiny::read_view(r, id_view) && tiny::read_view(r, header));
+    assert(tiny::read_views(r, name_views) && r.ok() && r.remaining() == 0);
+
+    assert(id_view.size() == 1000 && id_view[999] == 2997);
+    assert(id_view.bytes() == w.data() + 1 + 8);   // 没有拷贝
+    assert(id_view.data() == nullptr);             // 不对齐，不能当数组用
+    uint64_t sum = 0;
+    for (uint32_t id : id_view) sum += id;
+    assert(sum == 3ull * 999 * 1000 / 2);
+    tiny::vector<uint32_t> copy = id_view.to_vector();
+    assert(copy.size() == 1000 && copy[500] == 1500);
+
+    assert(header == "header");
+    assert(name_views.size() == 2 && name_views[0] == "alpha" && name_views[1] == "beta");
+    assert(name_views[1].data() > reinterpret_cast<const char*>(w.data()));
+}
+
+int main() {
+    test_scalars();
+    test_containers();
+    test_corrupt_input();
+    test_views();
+    std::cout << "all serialize tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace tiny {
+
+    // 危险指针（hazard pointer）安全内存回收
+    //
+    // 读者在解引用共享节点之前，先把节点地址登记到自己的危险指针槽里；
+    // 写者摘下节点后不直接 delete，而是 retire() 到本线程的待回收列表，
+    // 列表攒够一定数量时扫描所有线程的槽位，没有被任何槽位引用的节点才真正释放
+    //
+    // 每个线程最多同时持有 kSlotsPerThread 个危险指针，
+    // 槽位记录在线程第一次使用时分配，线程退出后归还给后来的线程复用
+    class hazard_domain
+    {
+    public:
+        static constexpr size_t kSlotsPerThread = 2;
+
+        struct alignas(64) record
+        {
+            std::atomic<const void*> ptr{nullptr};
+            std::atomic<bool> active{false};
+            record* next = nullptr;
+        };
+
+        static hazard_domain& global()
+        {
+            static hazard_domain domain;
+            return domain;
+        }
+
+        hazard_domain() = default;
+        hazard_domain(const hazard_domain&) = delete;
+        hazard_domain& operator=(const hazard_domain&) = delete;
+
+        // 进程退出时已经没有读者，剩下的节点可以全部释放
+        ~hazard_domain()
+        {
+            for (retired& r : _orphans) r.deleter(r.ptr);
+
+            record* rec = _records.load(std::memory_order_relaxed);
+            while (rec)
+            {
+                record* next = rec->next;
+                delete rec;
+                rec = next;
+            }
+        }
+
+        // 当前线程第 slot 个危险指针槽
+        record& local_record(size_t slot)
+        {
+            assert(slot < kSlotsPerThread);
+            thread_state& ts = local_state();
+            if (!ts.records[slot]) ts.records[slot] = acquire_record();
+            return *ts.records[slot];
+        }
+
+        // 延迟释放 p，deleter 负责真正的析构与释放
+        void retire(void* p, void (*deleter)(void*))
+        {
+            thread_state& ts = local_state();
+            ts.retired.push_back(retired{p, deleter});
+            if (ts.retired.size() >= scan_threshold()) scan(ts.retired);
+        }
+
+    private:
+        struct retired
+        {
+            void* ptr;
+            void (*deleter)(void*);
+        };
+
+        struct thread_state
+        {
+            explicit thread_state(hazard_domain& d) : domain(d) {}
+
+            // 线程退出：归还槽位，还没法释放的节点交给全局孤儿列表
+            ~thread_state()
+            {
+                for (record* rec : records)
+                {
+                    if (!rec) continue;
+                    rec->ptr.store(nullptr, std::memory_order_release);
+                    rec->active.store(false, std::memory_order_release);
+                }
+                if (!retired.empty())
+                {
+                    domain.scan(retired);
+                    std::lock_guard<std::mutex> lock(domain._orphan_mutex);
+                    domain._orphans.insert(domain._orphans.end(), retired.begin(), retired.end());
+                    domain._has_orphans.store(true, std::memory_order_relaxed);
+                }
+            }
+
+            hazard_domain& domain;
+            record* records[kSlotsPerThread] = {};
+            std::vector<hazard_domain::retired> retired;
+        };
+
+        thread_state& local_state()
+        {
+            thread_local thread_state ts(*this);
+            assert(&ts.domain == this); // 每个线程只支持一个 domain
+            return ts;
+        }
+
+        record* acquire_record()
+        {
+            // 先复用已归还的记录
+            for (record* rec = _records.load(std::memory_order_acquire); rec; rec = rec->next)
+            {
+                bool expected = false;
+                if (!rec->active.load(std::memory_order_relaxed) &&
+                    rec->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    return rec;
+                }
+            }
+
+            // 没有空闲记录，新建一个挂到表头；记录只增不减
+            record* rec = new record;
+            rec->active.store(true, std::memory_order_relaxed);
+            record* head = _records.load(std::memory_order_relaxed);
+            do
+            {
+                rec->next = head;
+            } while (!_records.compare_exchange_weak(head, rec,
+                         std::memory_order_release, std::memory_order_relaxed));
+            _record_count.fetch_add(1, std::memory_order_relaxed);
+            return rec;
+        }
+
+        // 待回收数量超过危险指针总数的两倍再扫描，均摊下来每次 retire 是 O(1)
+        size_t scan_threshold() const
+        {
+            return std::max<size_t>(64, 2 * kSlotsPerThread * _record_count.load(std::memory_order_relaxed));
+        }
+
+        void scan(std::vector<retired>& list)
+        {
+            // 顺便接手已退出线程留下的节点
+            // _orphans 只能在锁内访问，锁外只看标志，没有遗留节点时不碰锁
+            if (_has_orphans.load(std::memory_order_relaxed))
+            {
+                std::unique_lock<std::mutex> lock(_orphan_mutex, std::try_to_lock);
+                if (lock.owns_lock())
+                {
+                    list.insert(list.end(), _orphans.begin(), _orphans.end());
+                    _orphans.clear();
+                    _has_orphans.store(false, std::memory_order_relaxed);
+                }
+            }
+
+            // 与读者"登记后再校验"之间的栅栏配对
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            std::vector<const void*> hazards;
+            for (record* rec = _records.load(std::memory_order_acquire); rec; rec = rec->next)
+            {
+                if (const void* p = rec->ptr.load(std::memory_order_acquire)) hazards.push_back(p);
+            }
+            std::sort(hazards.begin(), hazards.end());
+
+            size_t kept = 0;
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                if (std::binary_search(hazards.begin(), hazards.end(), static_cast<const void*>(list[i].ptr)))
+                    list[kept++] = list[i];
+                else
+                    list[i].deleter(list[i].ptr);
+            }
+            list.resize(kept);
+        }
+
+    private:
+        std::atomic<record*> _records{nullptr};
+        std::atomic<size_t> _record_count{0};
+
+        std::mutex _orphan_mutex;
+        std::vector<retired> _orphans;
+        std::atomic<bool> _has_orphans{false};   // 在 _orphan_mutex 内修改
+    };
+
+    // 当前线程某个危险指针槽的轻量句柄，析构时自动清空登记
+    class hazard_pointer
+    {
+    public:
+        explicit hazard_pointer(size_t slot = 0)
+            : _rec(hazard_domain::global().local_record(slot))
+        {}
+
+        hazard_pointer(const hazard_pointer&) = delete;
+        hazard_pointer& operator=(const hazard_pointer&) = delete;
+
+        ~hazard_pointer()
+        {
+            clear();
+        }
+
+        // 登记 p；调用方随后必须重新读取源指针确认 p 仍然可达
+        void set(const void* p)
+        {
+            _rec.ptr.store(p, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void clear()
+        {
+            _rec.ptr.store(nullptr, std::memory_order_release);
+        }
+
+        // 读取 src 并登记，直到登记前后读到的值一致
+        template<typename T>
+        T* protect(const std::atomic<T*>& src)
+        {
+            T* p = src.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                set(p);
+                T* again = src.load(std::memory_order_acquire);
+                if (again == p) return p;
+                p = again;
+            }
+        }
+
+    private:
+        hazard_domain::record& _rec;
+    };
+
+    // 延迟 delete p，直到没有任何危险指针引用它
+    template<typename T>
+    void retire(T* p)
+    {
+        hazard_domain::global().retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+}
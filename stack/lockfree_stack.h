@@ -0,0 +1,212 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include "hazard_pointer.h"
+
+namespace tiny {
+
+    // 无锁 Treiber 栈
+    //
+    // 栈顶是一个 64 位的带标签指针：低 48 位存节点地址，高 16 位是修改计数。
+    // 每次成功修改栈顶都会让标签加一，所以"弹出 A、压入 B、又压回 A"之后，
+    // 旧的比较交换也会因为标签不同而失败（ABA 问题）
+    // 标签只保证 CAS 的正确性，不保证节点仍然可读：
+    // pop 在读取 top->next 之前用危险指针登记 top，弹出的节点通过 retire() 延迟释放
+    //
+    // 依赖用户态地址只占低 48 位（x86-64 与 AArch64 的常见配置）
+    template<typename T>
+    class lockfree_stack
+    {
+        static_assert(sizeof(void*) == 8, "lockfree_stack packs a 16-bit tag into a 64-bit pointer");
+
+        struct Node
+        {
+            template<typename... Args>
+            Node(Args&&... args) : value(std::forward<Args>(args)...), next(nullptr) {}
+
+            T value;
+            Node* next;
+        };
+
+        static constexpr int kTagShift = 48;
+        static constexpr uint64_t kPtrMask = (uint64_t(1) << kTagShift) - 1;
+
+    public:
+        // 事先在本地串好的一串节点，push_chain 一次 CAS 整串压入
+        // 串内顺序与逐个 push 相同：最后 push 的元素最先被弹出
+        class chain
+        {
+        public:
+            chain() = default;
+            chain(const chain&) = delete;
+            chain& operator=(const chain&) = delete;
+
+            chain(chain&& other) noexcept
+                : _first(other._first), _last(other._last), _size(other._size)
+            {
+                other._first = other._last = nullptr;
+                other._size = 0;
+            }
+
+            ~chain()
+            {
+                while (_first)
+                {
+                    Node* next = _first->next;
+                    delete _first;
+                    _first = next;
+                }
+            }
+
+            template<typename... Args>
+            void emplace(Args&&... args)
+            {
+                Node* node = new Node(std::forward<Args>(args)...);
+                node->next = _first;
+                _first = node;
+                if (!_last) _last = node;
+                ++_size;
+            }
+
+            void push(const T& value) { emplace(value); }
+            void push(T&& value) { emplace(std::move(value)); }
+
+            bool empty() const { return _first == nullptr; }
+            size_t size() const { return _size; }
+
+        private:
+            friend class lockfree_stack;
+
+            Node* _first = nullptr;
+            Node* _last = nullptr;
+            size_t _size = 0;
+        };
+
+        lockfree_stack() = default;
+        lockfree_stack(const lockfree_stack&) = delete;
+        lockfree_stack& operator=(const lockfree_stack&) = delete;
+
+        // 析构时不能再有其它线程访问栈
+        ~lockfree_stack()
+        {
+            Node* cur = unpack(_top.load(std::memory_order_relaxed));
+            while (cur)
+            {
+                Node* next = cur->next;
+                delete cur;
+                cur = next;
+            }
+        }
+
+        template<typename... Args>
+        void emplace(Args&&... args)
+        {
+            Node* node = new Node(std::forward<Args>(args)...);
+            link(node, node);
+        }
+
+        void push(const T& value)
+        {
+            emplace(value);
+        }
+
+        void push(T&& value)
+        {
+            emplace(std::move(value));
+        }
+
+        // 整串压入，只做一次成功的 CAS
+        void push_chain(chain&& c)
+        {
+            if (c.empty()) return;
+            link(c._first, c._last);
+            c._first = c._last = nullptr;
+            c._size = 0;
+        }
+
+        std::optional<T> pop()
+        {
+            hazard_pointer hp;
+            Node* node;
+            uint64_t old = _top.load(std::memory_order_acquire);
+            for (;;)
+            {
+                node = unpack(old);
+                if (!node) return std::nullopt;
+
+                // 登记后重新读取栈顶，确认 node 在登记之前没有被摘走
+                hp.set(node);
+                const uint64_t again = _top.load(std::memory_order_acquire);
+                if (again != old)
+                {
+                    old = again;
+                    continue;
+                }
+
+                const uint64_t desired = pack(node->next, tag(old) + 1);
+                if (_top.compare_exchange_weak(old, desired,
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                    break;
+                }
+            }
+            hp.clear();
+
+            std::optional<T> result(std::move(node->value));
+            retire(node);
+            return result;
+        }
+
+        bool try_pop(T& out)
+        {
+            std::optional<T> v = pop();
+            if (!v) return false;
+            out = std::move(*v);
+            return true;
+        }
+
+        // 近似值：返回时可能已经被其它线程改变
+        bool empty_approx() const
+        {
+            return unpack(_top.load(std::memory_order_relaxed)) == nullptr;
+        }
+
+    private:
+        static uint64_t pack(Node* p, uint64_t tag)
+        {
+            const uint64_t bits = reinterpret_cast<uintptr_t>(p);
+            assert((bits & ~kPtrMask) == 0);
+            return bits | (tag << kTagShift);
+        }
+
+        static Node* unpack(uint64_t v)
+        {
+            return reinterpret_cast<Node*>(static_cast<uintptr_t>(v & kPtrMask));
+        }
+
+        static uint64_t tag(uint64_t v)
+        {
+            return v >> kTagShift;
+        }
+
+        // 把 first..last 这一串接到栈顶
+        void link(Node* first, Node* last)
+        {
+            uint64_t old = _top.load(std::memory_order_relaxed);
+            uint64_t desired;
+            do
+            {
+                last->next = unpack(old);
+                desired = pack(first, tag(old) + 1);
+            } while (!_top.compare_exchange_weak(old, desired,
+                         std::memory_order_release, std::memory_order_relaxed));
+        }
+
+    private:
+        alignas(64) std::atomic<uint64_t> _top{0};
+    };
+}
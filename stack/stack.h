@@ -1,7 +1,11 @@
 #pragma once
 #include<vector>
+#include<utility>
 using std::vector;
 
+// Container 需要提供 push_back/emplace_back/pop_back/back/empty/size，
+// 例如 std::vector、tiny::vector、tiny::deque（增长时不搬动元素）；
+// 用 tiny::static_vector<T, N> 则完全不分配堆内存
 template<typename T, typename Container = vector<T>>
 class stack
 {
@@ -11,6 +15,17 @@ public:
         _con.push_back(value);
     }
 
+    void push(T&& value)
+    {
+        _con.push_back(std::move(value));
+    }
+
+    template<typename... Args>
+    decltype(auto) emplace(Args&&... args)
+    {
+        return _con.emplace_back(std::forward<Args>(args)...);
+    }
+
     void pop()
     {
         _con.pop_back();
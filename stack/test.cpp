@@ -0,0 +1,84 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cassert>
+#include "stack.h"
+#include "lockfree_stack.h"
+
+// 1. stack 适配器
+void test_stack() {
+    stack<int> s;
+    assert(s.empty());
+    s.push(1);
+    s.push(2);
+    assert(s.top() == 2 && s.size() == 2);
+    s.pop();
+    assert(s.top() == 1);
+}
+
+// 2. 无锁栈：单线程语义与整串压入
+void test_lockfree_stack_basic() {
+    tiny::lockfree_stack<std::string> s;
+    assert(s.empty_approx() && !s.pop());
+
+    s.push("a");
+    s.emplace(3, 'b');
+    assert(s.pop().value() == "bbb");
+
+    tiny::lockfree_stack<std::string>::chain c;
+    c.push("x");
+    c.push("y");
+    c.push("z");
+    assert(c.size() == 3);
+    s.push_chain(std::move(c));
+    assert(c.empty());
+
+    // 整串压入与逐个 push 顺序一致
+    const char* expected[] = {"z", "y", "x", "a"};
+    for (const char* e : expected) {
+        std::string v;
+        assert(s.try_pop(v) && v == e);
+    }
+    assert(s.empty_approx());
+}
+
+// 3. 多线程共享空闲缓冲区：每个元素恰好被取走一次
+void test_lockfree_stack_concurrent() {
+    const int THREADS = 8, PER_THREAD = 20000;
+    tiny::lockfree_stack<int> s;
+    std::vector<std::atomic<int>> taken(THREADS * PER_THREAD);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            int base = t * PER_THREAD;
+            for (int i = 0; i < PER_THREAD; i += 4) {
+                if (i % 8 == 0) {
+                    tiny::lockfree_stack<int>::chain c;
+                    for (int k = 0; k < 4; ++k) c.push(base + i + k);
+                    s.push_chain(std::move(c));
+                } else {
+                    for (int k = 0; k < 4; ++k) s.push(base + i + k);
+                }
+                // 压入之后立刻弹出一些，制造 push/pop 交错
+                for (int k = 0; k < 3; ++k) {
+                    if (auto v = s.pop()) ++taken[*v];
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    while (auto v = s.pop()) ++taken[*v];
+
+    for (auto& cnt : taken) assert(cnt.load() == 1);
+}
+
+int main() {
+    test_stack();
+    test_lockfree_stack_basic();
+    test_lockfree_stack_concurrent();
+    std::cout << "all stack tests passed!" << std::endl;
+    return 0;
+}
@@ -4,6 +4,9 @@
 #include <algorithm> // std::max
 #include <utility>   // std::swap
 #include <memory>    // std::unique_ptr
+#include <string_view>
+#include "../memory/memory_resource.h"
+#include "../instrument/instrument.h"
 
 namespace tiny {
 
@@ -25,39 +28,50 @@ namespace tiny {
 
         // 构造函数 / 析构函数
         string()
-            : _data(new char[1]), _size(0), _capacity(0)
-        { _data[0] = '\0'; }
+            : string(get_default_resource())
+        {}
+
+        // 字符缓冲区从 r 分配；不传时使用 get_default_resource()
+        explicit string(memory_resource* r)
+            : _resource(r)
+        {
+            assert(r);
+            _data = allocate_(1);
+            _data[0] = '\0';
+        }
 
         ~string() noexcept
         {
-            delete[] _data;
+            deallocate_(_data, _capacity);
             _data = nullptr;
             _size = 0;
             _capacity = 0;
         }
 
-        string(const char* s)
+        string(const char* s, memory_resource* r = get_default_resource())
+            : _resource(r)
         {
-            assert(s);
+            assert(s && r);
             _size = std::strlen(s);
             _capacity = _size;
-            _data = new char[_capacity + 1];
+            _data = allocate_(_capacity);
             std::memcpy(_data, s, _size);
             _data[_size] = '\0';
         }
 
-        // 拷贝构造
+        // 拷贝构造，新字符串使用默认资源
         string(const string& s)
             : _size(s._size), _capacity(s._capacity)
         {
-            _data = new char[_capacity + 1]; // 保证容量一致
+            _data = allocate_(_capacity); // 保证容量一致
             if (_size) std::memcpy(_data, s._data, _size);
             _data[_size] = '\0';
+            instrument::on_copy<string>(_size);
         }
 
-        // 移动构造
+        // 移动构造，连同资源一起带走
         string(string&& s) noexcept
-            : _data(s._data), _size(s._size), _capacity(s._capacity)
+            : _data(s._data), _size(s._size), _capacity(s._capacity), _resource(s._resource)
         {
             s._data = nullptr;
             s._size = 0;
@@ -65,23 +79,43 @@ namespace tiny {
         }
 
         // 子串构造
-        string(const string& str, size_t pos, size_t len = npos)
+        string(const string& str, size_t pos, size_t len = npos, memory_resource* r = get_default_resource())
+            : _resource(r)
         {
             assert(pos <= str._size);
             if (len == npos || pos + len > str._size) len = str._size - pos;
             _size = len; _capacity = _size;
-            _data = new char[_capacity + 1];
+            _data = allocate_(_capacity);
             if (_size) std::memcpy(_data, str._data + pos, _size);
             _data[_size] = '\0';
         }
 
-        // 赋值运算符（copy-and-swap，既能处理拷贝也能处理移动）
-        string& operator=(string s)
+        // 赋值不改变自己的资源；容量够时直接复用原缓冲区
+        string& operator=(const string& s)
         {
-            swap(s);
+            if (this == &s) return *this;
+            if (s._size > _capacity || !_data) reallocate_(s._size);
+            if (s._size) std::memcpy(_data, s._data, s._size);
+            _size = s._size;
+            _data[_size] = '\0';
+            instrument::on_copy<string>(_size);
             return *this;
         }
 
+        // 资源相同时直接接管缓冲区，否则退化为拷贝
+        string& operator=(string&& s)
+        {
+            if (this == &s) return *this;
+            if (*_resource == *s._resource)
+            {
+                std::swap(_data, s._data);
+                std::swap(_size, s._size);
+                std::swap(_capacity, s._capacity);
+                return *this;
+            }
+            return *this = static_cast<const string&>(s);
+        }
+
         // 元素访问
         char& operator[](size_t pos)
         {
@@ -96,6 +130,10 @@ namespace tiny {
 
         // 观察器
         const char* c_str() const noexcept { return _data; }
+        const char* data() const noexcept { return _data; }
+
+        // 隐式转换为 std::string_view，便于与 const char*/string_view 互相比较、做哈希查找
+        operator std::string_view() const noexcept { return std::string_view(_data, _size); }
         bool   empty() const noexcept { return _size == 0; }
         size_t size()  const noexcept { return _size; }
         size_t capacity() const noexcept { return _capacity; }
@@ -135,8 +173,11 @@ namespace tiny {
             std::swap(_data, other._data);
             std::swap(_size, other._size);
             std::swap(_capacity, other._capacity);
+            std::swap(_resource, other._resource);
         }
 
+        memory_resource* resource() const noexcept { return _resource; }
+
         // 子串
         string substr(size_t pos = 0, size_t len = npos) const
         {
@@ -289,21 +330,47 @@ namespace tiny {
         // 重新分配内存
         void reallocate_(size_t new_cap)
         {
-            char* newdata = new char[new_cap + 1];
+            char* newdata = allocate_(new_cap);
+            if (_data) instrument::on_reallocate<string>(0, _size);
             if (_size) std::memcpy(newdata, _data, _size);
             newdata[_size] = '\0';
-            delete[] _data;
+            deallocate_(_data, _capacity);
             _data = newdata;
             _capacity = new_cap;
         }
 
+        // 容量 cap 的缓冲区实际占 cap + 1 字节（末尾的 '\0'）
+        char* allocate_(size_t cap)
+        {
+            instrument::on_allocate<string>(cap + 1, cap);
+            return static_cast<char*>(_resource->allocate(cap + 1, 1));
+        }
+
+        void deallocate_(char* p, size_t cap)
+        {
+            if (!p) return;
+            instrument::on_deallocate<string>(cap + 1);
+            _resource->deallocate(p, cap + 1, 1);
+        }
+
     private:
         char*  _data = nullptr;  // 字符数组
         size_t _size = 0;        // 当前字符串长度
         size_t _capacity = 0;    // 当前容量
+        memory_resource* _resource = get_default_resource();  // 内存来源
     };
 
     // 非成员运算符重载
+    inline bool operator==(const string& lhs, const string& rhs) noexcept
+    {
+        return std::string_view(lhs) == std::string_view(rhs);
+    }
+
+    inline bool operator<(const string& lhs, const string& rhs) noexcept
+    {
+        return std::string_view(lhs) < std::string_view(rhs);
+    }
+
     inline string operator+(const string& lhs, const string& rhs)
     {
         string result(lhs);
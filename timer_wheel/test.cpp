@@ -0,0 +1,99 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cassert>
+#include "timer_wheel.h"
+
+// 1. 基本的调度、触发与取消
+void test_schedule_and_cancel() {
+    tiny::timer_wheel wheel;
+    std::vector<int> fired;
+
+    auto a = wheel.schedule(3, [&] { fired.push_back(1); });
+    auto b = wheel.schedule(3, [&] { fired.push_back(2); });
+    auto c = wheel.schedule(5, [&] { fired.push_back(3); });
+    wheel.schedule(0, [&] { fired.push_back(0); });   // 下一个 tick
+    assert(wheel.size() == 4);
+
+    assert(wheel.advance() == 1);
+    assert(fired.size() == 1 && fired[0] == 0);
+
+    assert(wheel.cancel(b));
+    assert(!wheel.cancel(b));               // 重复取消是空操作
+    assert(wheel.pending(a) && !wheel.pending(b));
+
+    assert(wheel.advance(2) == 1);          // tick 3：只有 a
+    assert(fired.back() == 1);
+    assert(!wheel.pending(a) && !wheel.cancel(a));
+
+    assert(wheel.advance(10) == 1);
+    assert(fired.back() == 3 && !wheel.pending(c));
+    assert(wheel.empty() && wheel.now() == 13);
+}
+
+// 2. 跨层级联：远期定时器在正确的 tick 触发
+void test_cascade() {
+    tiny::timer_wheel wheel(1000);
+    const uint64_t delays[] = {255, 256, 257, 1000, 16383, 16384, 70000, 1u << 20, (1ull << 32) + 5};
+    std::vector<uint64_t> fired_at;
+    for (uint64_t d : delays) {
+        wheel.schedule(d, [&wheel, &fired_at] { fired_at.push_back(wheel.now()); });
+    }
+
+    // 逐段前进，确认每个定时器恰好在到期时刻触发
+    for (uint64_t d : delays) {
+        wheel.advance_to(1000 + d - 1);
+        size_t before = fired_at.size();
+        assert(wheel.advance() == 1);
+        assert(fired_at.size() == before + 1 && fired_at.back() == 1000 + d);
+    }
+    assert(wheel.empty());
+}
+
+// 3. 回调里重新调度与取消同批定时器
+void test_callbacks_reentrant() {
+    tiny::timer_wheel wheel;
+    int count = 0;
+    tiny::timer_handle victim;
+
+    std::function<void()> periodic = [&] {
+        if (++count < 5) wheel.schedule(10, periodic);
+    };
+    wheel.schedule(10, periodic);
+    wheel.schedule(10, [&] { wheel.cancel(victim); });
+    victim = wheel.schedule(10, [&] { assert(false); });
+
+    wheel.advance(100);
+    assert(count == 5 && wheel.empty());
+}
+
+// 4. 随机调度/取消，与期望的触发时刻对比
+void test_random() {
+    tiny::timer_wheel wheel;
+    std::mt19937_64 rng(1);
+    const int N = 20000;
+    std::vector<uint64_t> expect(N), got(N, 0);
+    std::vector<tiny::timer_handle> handles(N);
+
+    for (int i = 0; i < N; ++i) {
+        uint64_t d = 1 + rng() % 100000;
+        expect[i] = d;
+        handles[i] = wheel.schedule(d, [&, i] { got[i] = wheel.now(); });
+    }
+    for (int i = 0; i < N; i += 3) {
+        assert(wheel.cancel(handles[i]));
+        expect[i] = 0;
+    }
+
+    wheel.advance(100001);
+    for (int i = 0; i < N; ++i) assert(got[i] == expect[i]);
+}
+
+int main() {
+    test_schedule_and_cancel();
+    test_cascade();
+    test_callbacks_reentrant();
+    test_random();
+    std::cout << "all timer_wheel tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,288 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "../list/list.h"
+#include "../vector/vector.h"
+
+namespace tiny {
+
+    class timer_wheel;
+
+    namespace detail {
+        struct timer_node
+        {
+            uint64_t expires = 0;
+            uint64_t gen = 0;
+            int level = 0;
+            std::function<void()> cb;
+            list<timer_node*>* bucket = nullptr;       // 所在的槽，不在轮上时为空
+            list<timer_node*>::iterator pos{nullptr};  // 在槽里的位置
+        };
+    }
+
+    // 定时器句柄：节点指针 + 代数
+    // 节点在定时器触发或取消后回收复用，代数随之加一，
+    // 所以已失效的句柄再拿来 cancel 是安全的空操作
+    class timer_handle
+    {
+    public:
+        timer_handle() = default;
+
+        bool valid() const { return _node != nullptr; }
+
+    private:
+        friend class timer_wheel;
+
+        timer_handle(detail::timer_node* n, uint64_t gen) : _node(n), _gen(gen) {}
+
+        detail::timer_node* _node = nullptr;
+        uint64_t _gen = 0;
+    };
+
+    // 分层时间轮
+    //
+    // 第 0 层 256 个槽，每槽 1 个 tick；往上 4 层各 64 个槽，每层槽宽是下一层的总跨度，
+    // 总共覆盖 2^32 个 tick，更远的定时器先放在最高层，到时再重新分配
+    // 每个槽是一条 tiny::list<节点指针>，节点记住自己所在的链表和迭代器：
+    //   schedule  按到期时间算出层和槽，push_back，O(1)
+    //   cancel    用节点里保存的迭代器直接 erase，O(1)
+    //   tick      每走满一层就把上一层对应槽整条拆开重新分配到低层（splice，不分配内存），
+    //             然后把第 0 层当前槽整条摘下来批量触发
+    class timer_wheel
+    {
+    public:
+        using callback = std::function<void()>;
+
+        timer_wheel() = default;
+
+        explicit timer_wheel(uint64_t start_tick)
+            : _now(start_tick)
+        {}
+
+        timer_wheel(const timer_wheel&) = delete;
+        timer_wheel& operator=(const timer_wheel&) = delete;
+
+        ~timer_wheel()
+        {
+            for (size_t i = 0; i < _all.size(); ++i) delete _all[i];
+        }
+
+        uint64_t now() const { return _now; }
+
+        // 未触发的定时器个数
+        size_t size() const { return _pending; }
+        bool empty() const { return _pending == 0; }
+
+        // delay 个 tick 之后触发；delay 为 0 时在下一个 tick 触发
+        timer_handle schedule(uint64_t delay, callback cb)
+        {
+            return schedule_at(_now + (delay ? delay : 1), std::move(cb));
+        }
+
+        // 在绝对时刻 when 触发，when 不晚于当前时刻时在下一个 tick 触发
+        timer_handle schedule_at(uint64_t when, callback cb)
+        {
+            node* n = acquire();
+            n->expires = when > _now ? when : _now + 1;
+            n->cb = std::move(cb);
+            place(n);
+            ++_pending;
+            return timer_handle(n, n->gen);
+        }
+
+        // 取消成功返回 true；句柄已触发/已取消/为空时返回 false
+        bool cancel(timer_handle h)
+        {
+            if (!pending(h)) return false;
+
+            node* n = h._node;
+            n->bucket->erase(n->pos);
+            if (n->bucket != &_due) --_level_count[n->level];
+            --_pending;
+            release(n);
+            return true;
+        }
+
+        bool pending(timer_handle h) const
+        {
+            return h._node && h._node->gen == h._gen && h._node->bucket != nullptr;
+        }
+
+        // 前进 ticks 个 tick，依次触发到期的定时器，返回触发的个数
+        // 回调里可以再 schedule 或 cancel
+        size_t advance(uint64_t ticks = 1)
+        {
+            const uint64_t target = _now + ticks;
+            size_t fired = 0;
+            while (_now < target)
+            {
+                // 低层全空时，下一次有事可做的时刻是最低非空层的下一个级联边界，
+                // 中间的 tick 可以整段跳过
+                int lowest = 0;
+                while (lowest < kLevels && _level_count[lowest] == 0) ++lowest;
+                if (lowest > 0)
+                {
+                    uint64_t next = target;
+                    if (lowest < kLevels)
+                    {
+                        const int shift = level_shift(lowest);
+                        next = ((_now >> shift) + 1) << shift;
+                        if (next > target) next = target;
+                    }
+                    _now = next - 1;
+                }
+                fired += tick();
+            }
+            return fired;
+        }
+
+        size_t advance_to(uint64_t when)
+        {
+            return when > _now ? advance(when - _now) : 0;
+        }
+
+    private:
+        using node = detail::timer_node;
+        using bucket_type = list<node*>;
+
+        static constexpr int kLevel0Bits = 8;
+        static constexpr int kLevelBits = 6;
+        static constexpr int kLevels = 5;
+        static constexpr size_t kLevel0Size = size_t(1) << kLevel0Bits;
+        static constexpr size_t kLevelSize = size_t(1) << kLevelBits;
+        static constexpr uint64_t kMaxSpan = uint64_t(1) << (kLevel0Bits + kLevelBits * (kLevels - 1));
+
+        static int level_shift(int level)
+        {
+            return level == 0 ? 0 : kLevel0Bits + kLevelBits * (level - 1);
+        }
+
+        // 根据到期时间与当前时刻的距离选择层和槽，层号写入 level_out
+        bucket_type& bucket_for(uint64_t expires, int& level_out)
+        {
+            uint64_t delta = expires - _now;
+            if (delta >= kMaxSpan)
+            {
+                // 超出范围：先放到最高层最远的槽，级联到时再重新计算
+                expires = _now + kMaxSpan - 1;
+                delta = kMaxSpan - 1;
+            }
+
+            if (delta < kLevel0Size)
+            {
+                level_out = 0;
+                return _level0[expires & (kLevel0Size - 1)];
+            }
+            for (int level = 1; level < kLevels; ++level)
+            {
+                if (delta < (uint64_t(1) << level_shift(level + 1)) || level == kLevels - 1)
+                {
+                    level_out = level;
+                    return _levels[level - 1][(expires >> level_shift(level)) & (kLevelSize - 1)];
+                }
+            }
+            assert(false);
+            return _level0[0];
+        }
+
+        void place(node* n)
+        {
+            bucket_type& b = bucket_for(n->expires, n->level);
+            b.push_back(n);
+            n->bucket = &b;
+            n->pos = --b.end();
+            ++_level_count[n->level];
+        }
+
+        // 把 from 中的节点逐个 splice 到新的槽，不重新分配链表节点
+        void cascade(bucket_type& from)
+        {
+            while (!from.empty())
+            {
+                bucket_type::iterator it = from.begin();
+                node* n = *it;
+                --_level_count[n->level];
+                bucket_type& to = bucket_for(n->expires, n->level);
+                ++_level_count[n->level];
+                to.splice(to.end(), from, it);
+                n->bucket = &to;
+                n->pos = it;
+            }
+        }
+
+        size_t tick()
+        {
+            ++_now;
+
+            // 第 0 层转完一圈时，从低到高级联上层对应的槽
+            if ((_now & (kLevel0Size - 1)) == 0)
+            {
+                for (int level = 1; level < kLevels; ++level)
+                {
+                    size_t slot = (_now >> level_shift(level)) & (kLevelSize - 1);
+                    cascade(_levels[level - 1][slot]);
+                    if (slot != 0) break;
+                }
+            }
+
+            // 整个槽一次性摘下，回调里新建的定时器不会混进本批
+            bucket_type& slot = _level0[_now & (kLevel0Size - 1)];
+            if (slot.empty()) return 0;
+
+            _level_count[0] -= slot.size();
+            _due.splice(_due.end(), slot);
+            for (node* n : _due) n->bucket = &_due;   // 批内尚未触发的定时器仍可被回调取消
+
+            size_t fired = 0;
+            while (!_due.empty())
+            {
+                node* n = _due.front();
+                _due.pop_front();
+                --_pending;
+
+                callback cb = std::move(n->cb);
+                release(n);
+                cb();
+                ++fired;
+            }
+            return fired;
+        }
+
+        node* acquire()
+        {
+            if (!_free.empty())
+            {
+                node* n = _free.back();
+                _free.pop_back();
+                return n;
+            }
+            node* n = new node;
+            _all.push_back(n);
+            return n;
+        }
+
+        void release(node* n)
+        {
+            ++n->gen;
+            n->bucket = nullptr;
+            n->cb = nullptr;
+            _free.push_back(n);
+        }
+
+    private:
+        uint64_t _now = 0;
+        size_t _pending = 0;
+        size_t _level_count[kLevels] = {};  // 每层的定时器个数，不含正在触发的批次
+
+        bucket_type _level0[kLevel0Size];
+        bucket_type _levels[kLevels - 1][kLevelSize];
+
+        bucket_type _due;           // 本 tick 正在触发的批次
+
+        tiny::vector<node*> _all;   // 所有节点，析构时统一释放
+        tiny::vector<node*> _free;  // 可复用的节点
+    };
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "../string/string.h"
+
+namespace tiny {
+
+    namespace detail {
+        // 64 位乘法混合，把输入的每一位扩散到高低位
+        inline uint64_t hash_mix(uint64_t h)
+        {
+            h ^= h >> 32;
+            h *= 0x9e3779b97f4a7c15ULL;
+            h ^= h >> 29;
+            return h;
+        }
+
+        // 按 8 字节一块处理的字节串哈希
+        inline uint64_t hash_bytes(const void* data, size_t len)
+        {
+            const unsigned char* p = static_cast<const unsigned char*>(data);
+            uint64_t h = 0xcbf29ce484222325ULL ^ (len * 0x9e3779b97f4a7c15ULL);
+
+            while (len >= 8)
+            {
+                uint64_t block;
+                std::memcpy(&block, p, 8);
+                h = (h ^ hash_mix(block)) * 0xff51afd7ed558ccdULL;
+                p += 8;
+                len -= 8;
+            }
+
+            uint64_t tail = 0;
+            if (len) std::memcpy(&tail, p, len);
+            h = (h ^ hash_mix(tail)) * 0xc4ceb9fe1a85ec53ULL;
+            return hash_mix(h);
+        }
+    }
+
+    // 默认哈希：整数与指针直接使用其值（容器内部还会再混合一次），
+    // 字符串按内容计算；其余类型转交给 std::hash
+    template<typename T, typename = void>
+    struct hash : std::hash<T> {};
+
+    template<typename T>
+    struct hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>>
+    {
+        size_t operator()(T value) const noexcept
+        {
+            if constexpr (std::is_pointer_v<T>)
+                return static_cast<size_t>(reinterpret_cast<uintptr_t>(value));
+            else
+                return static_cast<size_t>(value);
+        }
+    };
+
+    // 字符串类哈希是透明的：tiny::string 键可以直接用 string_view / const char* 查找，
+    // 不需要先构造一个临时的 tiny::string
+    struct string_hash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const noexcept
+        {
+            return static_cast<size_t>(detail::hash_bytes(s.data(), s.size()));
+        }
+    };
+
+    template<> struct hash<tiny::string> : string_hash {};
+    template<> struct hash<std::string> : string_hash {};
+    template<> struct hash<std::string_view> : string_hash {};
+
+    template<typename T>
+    struct equal_to : std::equal_to<T> {};
+
+    struct string_equal
+    {
+        using is_transparent = void;
+
+        bool operator()(std::string_view a, std::string_view b) const noexcept
+        {
+            return a == b;
+        }
+    };
+
+    template<> struct equal_to<tiny::string> : string_equal {};
+    template<> struct equal_to<std::string> : string_equal {};
+    template<> struct equal_to<std::string_view> : string_equal {};
+}
@@ -0,0 +1,547 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "hash.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TINY_HASH_SSE2 1
+#endif
+
+namespace tiny {
+namespace detail {
+
+    // 控制字节：
+    //   0..127   槽位已占用，值为哈希的低 7 位（H2）
+    //   kEmpty   空槽，探测到它就可以停止
+    //   kDeleted 墓碑，查找时跳过，插入时可复用
+    using ctrl_t = int8_t;
+    constexpr ctrl_t kEmpty = -128;
+    constexpr ctrl_t kDeleted = -2;
+
+    constexpr size_t kGroupWidth = 16;
+
+    // 16 个控制字节组成一组，一次比较整组，返回每个匹配位置对应一位的掩码
+    struct group
+    {
+#ifdef TINY_HASH_SSE2
+        explicit group(const ctrl_t* p)
+            : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)))
+        {}
+
+        uint32_t match(ctrl_t h2) const
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+        }
+
+        uint32_t match_empty() const
+        {
+            return match(kEmpty);
+        }
+
+        // kEmpty 与 kDeleted 都小于 -1，已占用的槽都不小于 0
+        uint32_t match_empty_or_deleted() const
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+        }
+
+        __m128i ctrl;
+#else
+        explicit group(const ctrl_t* p)
+        {
+            std::memcpy(ctrl, p, kGroupWidth);
+        }
+
+        uint32_t match(ctrl_t h2) const
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < kGroupWidth; ++i)
+                if (ctrl[i] == h2) mask |= 1u << i;
+            return mask;
+        }
+
+        uint32_t match_empty() const
+        {
+            return match(kEmpty);
+        }
+
+        uint32_t match_empty_or_deleted() const
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < kGroupWidth; ++i)
+                if (ctrl[i] < -1) mask |= 1u << i;
+            return mask;
+        }
+
+        ctrl_t ctrl[kGroupWidth];
+#endif
+    };
+
+    inline unsigned lowest_bit(uint32_t mask)
+    {
+        return static_cast<unsigned>(std::countr_zero(mask));
+    }
+
+    // 开放寻址哈希表（Swiss table 的简化实现），unordered_map/unordered_set 的公共部分
+    //
+    // 所有元素存放在一块连续的槽位数组里，另有一个字节的控制数组；
+    // 查找时先用 H2 在控制字节里一次匹配 16 个候选，只有匹配的槽位才真正比较键，
+    // 绝大多数查找只访问一条控制字节缓存行和一个槽位
+    //
+    // 容量是不小于 16 的 2 的幂，控制数组末尾多出 16 个字节镜像开头，
+    // 这样从任何位置开始读一整组都不用处理回绕
+    template<typename Value, typename Key, typename KeyOf, typename Hash, typename KeyEqual>
+    class raw_hash_table
+    {
+    public:
+        using key_type = Key;
+        using value_type = Value;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+
+        template<bool Const>
+        class basic_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const Value&, Value&>;
+            using pointer = std::conditional_t<Const, const Value*, Value*>;
+
+            basic_iterator() = default;
+
+            // iterator 可以隐式转换成 const_iterator
+            template<bool C = Const, typename = std::enable_if_t<C>>
+            basic_iterator(const basic_iterator<false>& it)
+                : _ctrl(it._ctrl), _end(it._end), _slot(it._slot)
+            {}
+
+            reference operator*() const { return *_slot; }
+            pointer operator->() const { return _slot; }
+
+            basic_iterator& operator++()
+            {
+                ++_ctrl;
+                ++_slot;
+                skip_empty();
+                return *this;
+            }
+
+            basic_iterator operator++(int)
+            {
+                basic_iterator tmp(*this);
+                ++*this;
+                return tmp;
+            }
+
+            template<bool C>
+            bool operator==(const basic_iterator<C>& it) const { return _ctrl == it._ctrl; }
+            template<bool C>
+            bool operator!=(const basic_iterator<C>& it) const { return _ctrl != it._ctrl; }
+
+        private:
+            friend class raw_hash_table;
+
+            basic_iterator(const ctrl_t* ctrl, const ctrl_t* end, Value* slot)
+                : _ctrl(ctrl), _end(end), _slot(slot)
+            {
+                skip_empty();
+            }
+
+            void skip_empty()
+            {
+                while (_ctrl != _end && *_ctrl < 0)
+                {
+                    ++_ctrl;
+                    ++_slot;
+                }
+            }
+
+            const ctrl_t* _ctrl = nullptr;
+            const ctrl_t* _end = nullptr;
+            Value* _slot = nullptr;
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        raw_hash_table() = default;
+
+        explicit raw_hash_table(size_t bucket_count, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+            : _hash(hash), _eq(eq)
+        {
+            reserve(bucket_count);
+        }
+
+        raw_hash_table(const raw_hash_table& other)
+            : _hash(other._hash), _eq(other._eq)
+        {
+            reserve(other._size);
+            for (const Value& v : other) insert_unique_no_check(v);
+        }
+
+        raw_hash_table(raw_hash_table&& other) noexcept
+            : _hash(other._hash), _eq(other._eq)
+        {
+            swap(other);
+        }
+
+        raw_hash_table& operator=(raw_hash_table other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        ~raw_hash_table()
+        {
+            destroy_all();
+            deallocate();
+        }
+
+        void swap(raw_hash_table& other) noexcept
+        {
+            std::swap(_ctrl, other._ctrl);
+            std::swap(_slots, other._slots);
+            std::swap(_capacity, other._capacity);
+            std::swap(_size, other._size);
+            std::swap(_growth_left, other._growth_left);
+            std::swap(_hash, other._hash);
+            std::swap(_eq, other._eq);
+        }
+
+        iterator begin() { return iterator(_ctrl, _ctrl + _capacity, _slots); }
+        iterator end() { return iterator(_ctrl + _capacity, _ctrl + _capacity, _slots + _capacity); }
+        const_iterator begin() const { return const_iterator(_ctrl, _ctrl + _capacity, _slots); }
+        const_iterator end() const { return const_iterator(_ctrl + _capacity, _ctrl + _capacity, _slots + _capacity); }
+        const_iterator cbegin() const { return begin(); }
+        const_iterator cend() const { return end(); }
+
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+        size_t bucket_count() const { return _capacity; }
+        float load_factor() const { return _capacity ? float(_size) / float(_capacity) : 0.0f; }
+        float max_load_factor() const { return 7.0f / 8.0f; }
+
+        hasher hash_function() const { return _hash; }
+        key_equal key_eq() const { return _eq; }
+
+        void clear()
+        {
+            destroy_all();
+            if (_capacity)
+            {
+                reset_ctrl();
+                _growth_left = growth_for(_capacity);
+            }
+            _size = 0;
+        }
+
+        // 预留至少能容纳 n 个元素而不需要扩容的空间
+        void reserve(size_t n)
+        {
+            size_t cap = capacity_for(n);
+            if (cap > _capacity) resize(cap);
+        }
+
+        // 按至少 n 个元素重建整张表，同时清除所有墓碑
+        void rehash(size_t n)
+        {
+            size_t cap = capacity_for(n > _size ? n : _size);
+            if (cap == 0) deallocate();
+            else resize(cap);
+        }
+
+        // ---------- 查找 ----------
+
+        template<typename K>
+        iterator find(const K& key)
+        {
+            size_t i = find_index(key);
+            return i == npos ? end() : iterator_at(i);
+        }
+
+        template<typename K>
+        const_iterator find(const K& key) const
+        {
+            size_t i = find_index(key);
+            return i == npos ? end() : const_iterator(_ctrl + i, _ctrl + _capacity, _slots + i);
+        }
+
+        template<typename K>
+        bool contains(const K& key) const
+        {
+            return find_index(key) != npos;
+        }
+
+        template<typename K>
+        size_t count(const K& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        // ---------- 删除 ----------
+
+        template<typename K>
+        size_t erase_key(const K& key)
+        {
+            size_t i = find_index(key);
+            if (i == npos) return 0;
+            erase_at(i);
+            return 1;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            size_t i = static_cast<size_t>(pos._ctrl - _ctrl);
+            erase_at(i);
+            return iterator_at(i);
+        }
+
+    protected:
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        iterator iterator_at(size_t i)
+        {
+            return iterator(_ctrl + i, _ctrl + _capacity, _slots + i);
+        }
+
+        // 查找 key；找到返回 (下标, false)，否则在合适的空位原地构造一个新元素并返回 (下标, true)
+        // make(slot) 负责在 slot 处构造 value_type
+        template<typename K, typename Make>
+        std::pair<size_t, bool> find_or_insert(const K& key, Make&& make)
+        {
+            const size_t h = hash_of(key);
+            size_t i = find_index(key, h);
+            if (i != npos) return {i, false};
+
+            if (!needs_resize(h))
+            {
+                i = find_first_non_full(h);
+                make(_slots + i);
+                commit_insert(i, h);
+                return {i, true};
+            }
+
+            // 参数可能引用表内元素（如 m.try_emplace(k, m.at(x))），扩容会把它搬走并释放，
+            // 所以先在局部构造出新元素，扩容后再移进槽位
+            union holder
+            {
+                Value value;
+                holder() {}
+                ~holder() {}
+            } tmp;
+            make(&tmp.value);
+            try
+            {
+                i = prepare_insert(h);
+                new (_slots + i) Value(std::move(tmp.value));
+            }
+            catch (...)
+            {
+                tmp.value.~Value();
+                throw;
+            }
+            tmp.value.~Value();
+            commit_insert(i, h);
+            return {i, true};
+        }
+
+        template<typename V>
+        void insert_unique_no_check(V&& value)
+        {
+            const size_t h = hash_of(KeyOf()(value));
+            size_t i = prepare_insert(h);
+            new (_slots + i) Value(std::forward<V>(value));
+            commit_insert(i, h);
+        }
+
+        Value& slot(size_t i) { return _slots[i]; }
+
+    private:
+        // 容器内部再混合一次，避免 std::hash<int> 这类恒等哈希在低位聚集
+        template<typename K>
+        size_t hash_of(const K& key) const
+        {
+            return static_cast<size_t>(hash_mix(static_cast<uint64_t>(_hash(key))));
+        }
+
+        static size_t h1(size_t h) { return h >> 7; }
+        static ctrl_t h2(size_t h) { return static_cast<ctrl_t>(h & 0x7f); }
+
+        // 最大负载因子 7/8
+        static size_t growth_for(size_t cap) { return cap - cap / 8; }
+
+        static size_t capacity_for(size_t n)
+        {
+            if (n == 0) return 0;
+            size_t cap = kGroupWidth;
+            while (growth_for(cap) < n) cap <<= 1;
+            return cap;
+        }
+
+        template<typename K>
+        size_t find_index(const K& key) const
+        {
+            return find_index(key, hash_of(key));
+        }
+
+        // 三角探测：每次跳过的组数递增 1，容量为 2 的幂时保证访问到所有组
+        template<typename K>
+        size_t find_index(const K& key, size_t h) const
+        {
+            if (_capacity == 0) return npos;
+
+            const size_t mask = _capacity - 1;
+            const ctrl_t tag = h2(h);
+            size_t pos = h1(h) & mask;
+            size_t step = 0;
+            for (;;)
+            {
+                group g(_ctrl + pos);
+                for (uint32_t m = g.match(tag); m; m &= m - 1)
+                {
+                    size_t i = (pos + lowest_bit(m)) & mask;
+                    if (_eq(KeyOf()(_slots[i]), key)) return i;
+                }
+                if (g.match_empty()) return npos;
+
+                step += kGroupWidth;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        size_t find_first_non_full(size_t h) const
+        {
+            const size_t mask = _capacity - 1;
+            size_t pos = h1(h) & mask;
+            size_t step = 0;
+            for (;;)
+            {
+                group g(_ctrl + pos);
+                if (uint32_t m = g.match_empty_or_deleted())
+                {
+                    return (pos + lowest_bit(m)) & mask;
+                }
+                step += kGroupWidth;
+                pos = (pos + step) & mask;
+            }
+        }
+
+        // 插入哈希为 h 的新元素前是否必须先扩容（或原地清理墓碑）
+        bool needs_resize(size_t h) const
+        {
+            return _capacity == 0 || (_growth_left == 0 && _ctrl[find_first_non_full(h)] != kDeleted);
+        }
+
+        // 选一个可以写入的槽位；没有空位可用时先扩容或原地清理墓碑
+        size_t prepare_insert(size_t h)
+        {
+            if (_capacity == 0)
+            {
+                resize(kGroupWidth);
+            }
+
+            size_t i = find_first_non_full(h);
+            if (_growth_left == 0 && _ctrl[i] != kDeleted)
+            {
+                // 空位大多被墓碑占着时原地重建就够了，否则翻倍
+                resize(_size * 32 <= _capacity * 25 ? _capacity : _capacity * 2);
+                i = find_first_non_full(h);
+            }
+            return i;
+        }
+
+        void commit_insert(size_t i, size_t h)
+        {
+            if (_ctrl[i] == kEmpty) --_growth_left;
+            set_ctrl(i, h2(h));
+            ++_size;
+        }
+
+        void erase_at(size_t i)
+        {
+            _slots[i].~Value();
+            set_ctrl(i, kDeleted);
+            --_size;
+        }
+
+        void set_ctrl(size_t i, ctrl_t c)
+        {
+            _ctrl[i] = c;
+            // 前 16 个控制字节在末尾有一份镜像
+            if (i < kGroupWidth) _ctrl[_capacity + i] = c;
+        }
+
+        void reset_ctrl()
+        {
+            std::memset(_ctrl, static_cast<unsigned char>(kEmpty), _capacity + kGroupWidth);
+        }
+
+        void resize(size_t new_cap)
+        {
+            ctrl_t* old_ctrl = _ctrl;
+            Value* old_slots = _slots;
+            const size_t old_cap = _capacity;
+
+            _capacity = new_cap;
+            _ctrl = static_cast<ctrl_t*>(::operator new(new_cap + kGroupWidth));
+            _slots = static_cast<Value*>(::operator new(new_cap * sizeof(Value), std::align_val_t(alignof(Value))));
+            reset_ctrl();
+            _growth_left = growth_for(new_cap) - _size;
+
+            for (size_t i = 0; i < old_cap; ++i)
+            {
+                if (old_ctrl[i] < 0) continue;
+
+                const size_t h = hash_of(KeyOf()(old_slots[i]));
+                const size_t j = find_first_non_full(h);
+                new (_slots + j) Value(std::move(old_slots[i]));
+                old_slots[i].~Value();
+                set_ctrl(j, h2(h));
+            }
+
+            if (old_cap)
+            {
+                ::operator delete(old_ctrl);
+                ::operator delete(old_slots, std::align_val_t(alignof(Value)));
+            }
+        }
+
+        void destroy_all()
+        {
+            if (_size == 0) return;
+            for (size_t i = 0; i < _capacity; ++i)
+            {
+                if (_ctrl[i] >= 0) _slots[i].~Value();
+            }
+        }
+
+        void deallocate()
+        {
+            if (_capacity == 0) return;
+            ::operator delete(_ctrl);
+            ::operator delete(_slots, std::align_val_t(alignof(Value)));
+            _ctrl = nullptr;
+            _slots = nullptr;
+            _capacity = 0;
+        }
+
+    private:
+        ctrl_t* _ctrl = nullptr;
+        Value*  _slots = nullptr;
+        size_t  _capacity = 0;
+        size_t  _size = 0;
+        size_t  _growth_left = 0;   // 还能占用多少个空槽（墓碑不计）
+        Hash     _hash;
+        KeyEqual _eq;
+    };
+}
+}
@@ -0,0 +1,192 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <random>
+#include <cassert>
+#include "unordered_map.h"
+#include "unordered_set.h"
+
+// 1. 基本操作
+void test_unordered_map() {
+    tiny::unordered_map<int, int> m;
+    assert(m.empty() && m.bucket_count() == 0);
+    assert(m.find(1) == m.end());
+
+    for (int i = 0; i < 1000; ++i) m[i] = i * 2;
+    assert(m.size() == 1000);
+    assert(m.load_factor() <= m.max_load_factor());
+    for (int i = 0; i < 1000; ++i) assert(m.at(i) == i * 2);
+    assert(!m.contains(1000) && m.count(999) == 1);
+
+    auto r = m.try_emplace(5, 100);
+    assert(!r.second && r.first->second == 10);
+    r = m.insert_or_assign(5, 100);
+    assert(!r.second && m[5] == 100);
+    r = m.emplace(2000, 1);
+    assert(r.second && m.size() == 1001);
+
+    bool thrown = false;
+    try { m.at(-1); } catch (const std::out_of_range&) { thrown = true; }
+    assert(thrown);
+
+    // 删除：按键与按迭代器
+    for (int i = 0; i < 1000; i += 2) assert(m.erase(i) == 1);
+    assert(m.erase(0) == 0);
+    m.erase(m.find(2000));
+    assert(m.size() == 500);
+    for (int i = 0; i < 1000; ++i) assert(m.contains(i) == (i % 2 == 1));
+
+    // 遍历
+    size_t n = 0;
+    long long sum = 0;
+    for (auto& kv : m) { ++n; sum += kv.first; }
+    assert(n == 500 && sum == 250000);
+
+    // 拷贝、移动与比较
+    tiny::unordered_map<int, int> copy(m);
+    assert(copy == m);
+    tiny::unordered_map<int, int> moved(std::move(copy));
+    assert(moved == m && copy.empty());
+    moved[1] = -1;
+    assert(!(moved == m));
+
+    m.clear();
+    assert(m.empty() && m.find(1) == m.end());
+    m[7] = 7;
+    assert(m.size() == 1);
+}
+
+// 2. 字符串键：tiny::string 键可以直接用 string_view / const char* 查找
+void test_heterogeneous_lookup() {
+    tiny::unordered_map<tiny::string, int> m;
+    m["apple"] = 1;
+    m[tiny::string("banana")] = 2;
+    m.try_emplace("cherry", 3);
+
+    std::string_view sv = "banana";
+    assert(m.find(sv) != m.end() && m.find(sv)->second == 2);
+    assert(m.contains("apple"));
+    assert(m.count(std::string("cherry")) == 1);
+    assert(!m.contains(std::string_view("durian")));
+    assert(m.erase("apple") == 1 && m.size() == 2);
+
+    tiny::unordered_map<std::string, std::string> sm = {{"a", "1"}, {"b", "2"}};
+    assert(sm.at("a") == "1");
+    assert(sm.find(std::string_view("b"))->second == "2");
+}
+
+// 3. reserve / rehash，以及大量墓碑后的原地整理
+void test_reserve_and_rehash() {
+    tiny::unordered_map<int, std::string> m;
+    m.reserve(1000);
+    size_t buckets = m.bucket_count();
+    assert(buckets >= 1000);
+    for (int i = 0; i < 1000; ++i) m.try_emplace(i, std::to_string(i));
+    assert(m.bucket_count() == buckets);   // 预留后不再扩容
+
+    // 反复插入删除：墓碑应当被回收，表不会无限增长
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 1000; ++i) m.erase(i);
+        for (int i = 0; i < 1000; ++i) m.try_emplace(i + round * 1000, "x");
+        for (int i = 0; i < 1000; ++i) m.erase(i + round * 1000);
+        for (int i = 0; i < 1000; ++i) m.try_emplace(i, std::to_string(i));
+    }
+    assert(m.size() == 1000 && m.bucket_count() == buckets);
+    for (int i = 0; i < 1000; ++i) assert(m.at(i) == std::to_string(i));
+
+    for (int i = 0; i < 990; ++i) m.erase(i);
+    m.rehash(0);
+    assert(m.size() == 10 && m.bucket_count() == 16);
+    for (int i = 990; i < 1000; ++i) assert(m.at(i) == std::to_string(i));
+
+    m.clear();
+    m.rehash(0);
+    assert(m.bucket_count() == 0);
+}
+
+// 4. unordered_set
+void test_unordered_set() {
+    tiny::unordered_set<int> s = {3, 1, 4, 1, 5, 9, 2, 6};
+    assert(s.size() == 7);
+    assert(s.contains(9) && !s.contains(7));
+    assert(!s.insert(4).second && s.insert(7).second);
+    assert(s.erase(1) == 1 && s.size() == 7);
+
+    int sum = 0;
+    for (int x : s) sum += x;
+    assert(sum == 3 + 4 + 5 + 9 + 2 + 6 + 7);
+
+    tiny::unordered_set<tiny::string> words;
+    words.emplace("hello");
+    words.insert(tiny::string("world"));
+    assert(words.contains(std::string_view("hello")) && words.contains("world"));
+    assert(words.erase(std::string_view("hello")) == 1);
+    assert(words.size() == 1);
+
+    tiny::unordered_set<tiny::string> other(words);
+    assert(other == words);
+}
+
+// 5. 随机操作，与 std::unordered_map 对比
+void test_random_against_std() {
+    std::mt19937 rng(7);
+    tiny::unordered_map<int, int> m;
+    std::unordered_map<int, int> ref;
+
+    for (int step = 0; step < 200000; ++step) {
+        int key = int(rng() % 5000);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            m[key] = step;
+            ref[key] = step;
+            break;
+        case 2:
+            assert(m.erase(key) == ref.erase(key));
+            break;
+        case 3: {
+            auto it = m.find(key);
+            auto rit = ref.find(key);
+            assert((it == m.end()) == (rit == ref.end()));
+            if (rit != ref.end()) assert(it->second == rit->second);
+            break;
+        }
+        }
+        assert(m.size() == ref.size());
+    }
+
+    size_t n = 0;
+    for (auto& kv : m) {
+        assert(ref.at(kv.first) == kv.second);
+        ++n;
+    }
+    assert(n == ref.size());
+}
+
+// 6. 参数引用表内元素：插入触发扩容时也不能读到已释放的槽位
+void test_aliasing_insert() {
+    tiny::unordered_map<int, std::string> m;
+    m[0] = std::string(100, 'a');
+    for (int i = 1; i < 200; ++i) m.try_emplace(i, m.at(0));
+    for (int i = 0; i < 200; ++i) assert(m.at(i) == std::string(100, 'a'));
+
+    // 键引用表内的值：每个值都是一个还不存在的新键
+    tiny::unordered_map<std::string, std::string> chain;
+    chain["k0"] = "k1";
+    for (int i = 1; i < 200; ++i) chain[chain.at("k" + std::to_string(i - 1))] = "k" + std::to_string(i + 1);
+    assert(chain.size() == 200);
+    for (int i = 0; i < 200; ++i) assert(chain.at("k" + std::to_string(i)) == "k" + std::to_string(i + 1));
+}
+
+int main() {
+    test_unordered_map();
+    test_heterogeneous_lookup();
+    test_reserve_and_rehash();
+    test_unordered_set();
+    test_random_against_std();
+    test_aliasing_insert();
+    std::cout << "all unordered_map tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include <cassert>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "hash.h"
+#include "raw_hash_table.h"
+
+namespace tiny {
+
+    namespace detail {
+        template<typename T, typename = void>
+        struct has_is_transparent : std::false_type {};
+
+        template<typename T>
+        struct has_is_transparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+        // Hash 与 KeyEqual 都透明时才允许用别的类型直接查找
+        template<typename Hash, typename KeyEqual>
+        constexpr bool is_transparent_lookup_v = has_is_transparent<Hash>::value && has_is_transparent<KeyEqual>::value;
+
+        struct map_key_of
+        {
+            template<typename Pair>
+            const auto& operator()(const Pair& p) const { return p.first; }
+        };
+    }
+
+    // 开放寻址哈希表实现的 unordered_map，接口与 std::unordered_map 基本一致
+    // 与 std 版本的差别：
+    //   元素存放在连续数组里，扩容和删除会移动元素，迭代器与引用都会失效
+    //   没有 bucket 接口，最大负载因子固定为 7/8
+    template<typename Key, typename T, typename Hash = tiny::hash<Key>, typename KeyEqual = tiny::equal_to<Key>>
+    class unordered_map
+        : public detail::raw_hash_table<std::pair<const Key, T>, Key, detail::map_key_of, Hash, KeyEqual>
+    {
+        using base = detail::raw_hash_table<std::pair<const Key, T>, Key, detail::map_key_of, Hash, KeyEqual>;
+
+        template<typename K>
+        static constexpr bool transparent = detail::is_transparent_lookup_v<Hash, KeyEqual>
+            && !std::is_convertible_v<const K&, typename base::iterator>
+            && !std::is_convertible_v<const K&, typename base::const_iterator>;
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using iterator = typename base::iterator;
+        using const_iterator = typename base::const_iterator;
+
+        unordered_map() = default;
+
+        explicit unordered_map(size_t bucket_count, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+            : base(bucket_count, hash, eq)
+        {}
+
+        template<typename InputIterator>
+        unordered_map(InputIterator first, InputIterator last)
+        {
+            insert(first, last);
+        }
+
+        unordered_map(std::initializer_list<value_type> il)
+        {
+            this->reserve(il.size());
+            insert(il.begin(), il.end());
+        }
+
+        // ---------- 插入 ----------
+
+        // 键不存在时用 args 构造值；键已存在时什么都不做，args 不会被移走
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            return try_emplace_impl(key, std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args)
+        {
+            return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+        }
+
+        std::pair<iterator, bool> insert(const value_type& value)
+        {
+            return try_emplace_impl(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& value)
+        {
+            return try_emplace_impl(std::move(const_cast<Key&>(value.first)), std::move(value.second));
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) insert(*first);
+        }
+
+        // 先构造出元素再查找；能用 try_emplace 时优先用 try_emplace
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args)
+        {
+            value_type value(std::forward<Args>(args)...);
+            return insert(std::move(value));
+        }
+
+        template<typename M>
+        std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj)
+        {
+            auto result = try_emplace_impl(key, std::forward<M>(obj));
+            if (!result.second) result.first->second = std::forward<M>(obj);
+            return result;
+        }
+
+        T& operator[](const Key& key)
+        {
+            return try_emplace_impl(key).first->second;
+        }
+
+        T& operator[](Key&& key)
+        {
+            return try_emplace_impl(std::move(key)).first->second;
+        }
+
+        // ---------- 查找 ----------
+
+        T& at(const Key& key)
+        {
+            iterator it = this->find(key);
+            if (it == this->end()) throw std::out_of_range("tiny::unordered_map::at");
+            return it->second;
+        }
+
+        const T& at(const Key& key) const
+        {
+            const_iterator it = this->find(key);
+            if (it == this->end()) throw std::out_of_range("tiny::unordered_map::at");
+            return it->second;
+        }
+
+        iterator find(const Key& key) { return base::find(key); }
+        const_iterator find(const Key& key) const { return base::find(key); }
+        bool contains(const Key& key) const { return base::contains(key); }
+        size_t count(const Key& key) const { return base::count(key); }
+
+        template<typename K> requires transparent<K>
+        iterator find(const K& key) { return base::find(key); }
+
+        template<typename K> requires transparent<K>
+        const_iterator find(const K& key) const { return base::find(key); }
+
+        template<typename K> requires transparent<K>
+        bool contains(const K& key) const { return base::contains(key); }
+
+        template<typename K> requires transparent<K>
+        size_t count(const K& key) const { return base::count(key); }
+
+        // ---------- 删除 ----------
+
+        using base::erase;
+
+        size_t erase(const Key& key)
+        {
+            return this->erase_key(key);
+        }
+
+        template<typename K> requires transparent<K>
+        size_t erase(const K& key)
+        {
+            return this->erase_key(key);
+        }
+
+    private:
+        template<typename K, typename... Args>
+        std::pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args)
+        {
+            auto [i, inserted] = this->find_or_insert(key, [&](value_type* slot) {
+                new (slot) value_type(std::piecewise_construct,
+                    std::forward_as_tuple(std::forward<K>(key)),
+                    std::forward_as_tuple(std::forward<Args>(args)...));
+            });
+            return {this->iterator_at(i), inserted};
+        }
+    };
+
+    template<typename Key, typename T, typename Hash, typename KeyEqual>
+    bool operator==(const unordered_map<Key, T, Hash, KeyEqual>& a, const unordered_map<Key, T, Hash, KeyEqual>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (const auto& kv : a)
+        {
+            auto it = b.find(kv.first);
+            if (it == b.end() || !(it->second == kv.second)) return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <initializer_list>
+#include <utility>
+#include "unordered_map.h"
+
+namespace tiny {
+
+    namespace detail {
+        struct set_key_of
+        {
+            template<typename T>
+            const T& operator()(const T& value) const { return value; }
+        };
+    }
+
+    // 开放寻址哈希表实现的 unordered_set，与 unordered_map 共用同一套表
+    // 元素不可修改，迭代器只提供 const 访问
+    template<typename Key, typename Hash = tiny::hash<Key>, typename KeyEqual = tiny::equal_to<Key>>
+    class unordered_set
+        : public detail::raw_hash_table<Key, Key, detail::set_key_of, Hash, KeyEqual>
+    {
+        using base = detail::raw_hash_table<Key, Key, detail::set_key_of, Hash, KeyEqual>;
+
+        template<typename K>
+        static constexpr bool transparent = detail::is_transparent_lookup_v<Hash, KeyEqual>
+            && !std::is_convertible_v<const K&, typename base::const_iterator>;
+
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using iterator = typename base::const_iterator;
+        using const_iterator = typename base::const_iterator;
+
+        unordered_set() = default;
+
+        explicit unordered_set(size_t bucket_count, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+            : base(bucket_count, hash, eq)
+        {}
+
+        template<typename InputIterator>
+        unordered_set(InputIterator first, InputIterator last)
+        {
+            insert(first, last);
+        }
+
+        unordered_set(std::initializer_list<Key> il)
+        {
+            this->reserve(il.size());
+            insert(il.begin(), il.end());
+        }
+
+        const_iterator begin() const { return base::begin(); }
+        const_iterator end() const { return base::end(); }
+
+        std::pair<const_iterator, bool> insert(const Key& key)
+        {
+            return emplace_impl(key);
+        }
+
+        std::pair<const_iterator, bool> insert(Key&& key)
+        {
+            return emplace_impl(std::move(key));
+        }
+
+        template<typename InputIterator>
+        void insert(InputIterator first, InputIterator last)
+        {
+            for (; first != last; ++first) insert(*first);
+        }
+
+        template<typename... Args>
+        std::pair<const_iterator, bool> emplace(Args&&... args)
+        {
+            return emplace_impl(Key(std::forward<Args>(args)...));
+        }
+
+        const_iterator find(const Key& key) const { return base::find(key); }
+        bool contains(const Key& key) const { return base::contains(key); }
+        size_t count(const Key& key) const { return base::count(key); }
+
+        template<typename K> requires transparent<K>
+        const_iterator find(const K& key) const { return base::find(key); }
+
+        template<typename K> requires transparent<K>
+        bool contains(const K& key) const { return base::contains(key); }
+
+        template<typename K> requires transparent<K>
+        size_t count(const K& key) const { return base::count(key); }
+
+        const_iterator erase(const_iterator pos)
+        {
+            return base::erase(pos);
+        }
+
+        size_t erase(const Key& key)
+        {
+            return this->erase_key(key);
+        }
+
+        template<typename K> requires transparent<K>
+        size_t erase(const K& key)
+        {
+            return this->erase_key(key);
+        }
+
+    private:
+        template<typename K>
+        std::pair<const_iterator, bool> emplace_impl(K&& key)
+        {
+            auto [i, inserted] = this->find_or_insert(key, [&](Key* slot) {
+                new (slot) Key(std::forward<K>(key));
+            });
+            return {this->iterator_at(i), inserted};
+        }
+    };
+
+    template<typename Key, typename Hash, typename KeyEqual>
+    bool operator==(const unordered_set<Key, Hash, KeyEqual>& a, const unordered_set<Key, Hash, KeyEqual>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (const Key& key : a)
+        {
+            if (!b.contains(key)) return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,230 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace tiny {
+
+    // 只追加的并发 vector
+    //
+    // 存储是一组按 2 倍增长的段：第 s 段放 kFirst << s 个元素，段表大小固定，
+    // 段一旦分配就不再移动，所以元素地址永远稳定，读者不需要任何锁
+    //
+    // push_back：对 _size 做一次 fetch_add 抢到下标 → 必要时用 CAS 装上新段 → 原地构造 →
+    //            把该元素的就绪标志置 1（release）。不同线程写不同槽位，互不等待
+    // 读取：     get(i) / published(i) 只读一次就绪标志（acquire），wait-free；
+    //            size() 是已经分出去的下标数，其中可能有还没构造完的元素
+    //
+    // 段的分配用 CAS 竞争，输的线程释放自己那份；写到一段的一半时顺手把下一段分配好，
+    // 绝大多数 push_back 不会碰到分配
+    template<typename T>
+    class concurrent_vector
+    {
+        static constexpr size_t kCacheLine = 64;
+        static constexpr size_t kFirstShift = 5;
+        static constexpr size_t kFirst = size_t(1) << kFirstShift;   // 第 0 段的元素个数
+        static constexpr size_t kMaxSegments = 64 - kFirstShift;
+
+    public:
+        using value_type = T;
+
+        concurrent_vector() = default;
+
+        concurrent_vector(const concurrent_vector&) = delete;
+        concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+        // 析构时不能再有其它线程访问；只析构已经发布的元素
+        ~concurrent_vector()
+        {
+            clear();
+            for (size_t s = 0; s < kMaxSegments; ++s)
+            {
+                if (T* seg = _segments[s].load(std::memory_order_relaxed)) deallocate_segment_(seg);
+            }
+        }
+
+        // 返回新元素的下标；构造抛异常时这个下标永远不会发布
+        template<typename... Args>
+        size_t emplace_back(Args&&... args)
+        {
+            const size_t index = _size.fetch_add(1, std::memory_order_relaxed);
+            construct_(index, std::forward<Args>(args)...);
+            return index;
+        }
+
+        size_t push_back(const T& value) { return emplace_back(value); }
+        size_t push_back(T&& value) { return emplace_back(std::move(value)); }
+
+        // 一次 fetch_add 占下连续 values.size() 个下标，返回第一个下标
+        size_t append(std::span<const T> values)
+        {
+            if (values.empty()) return size();
+            const size_t first = _size.fetch_add(values.size(), std::memory_order_relaxed);
+            for (size_t i = 0; i < values.size(); ++i) construct_(first + i, values[i]);
+            return first;
+        }
+
+        // 预先分配能放下 n 个元素的段，可以与 push_back 并发调用
+        void reserve(size_t n)
+        {
+            if (n == 0) return;
+            const size_t last = locate_(n - 1).segment;
+            for (size_t s = 0; s <= last; ++s) segment_(s);
+        }
+
+        // 已分出去的下标数（包括正在构造的元素）
+        size_t size() const { return _size.load(std::memory_order_acquire); }
+        bool empty() const { return size() == 0; }
+
+        // 第 index 个元素是否已经构造完成并对本线程可见
+        bool published(size_t index) const
+        {
+            const slot s = locate_(index);
+            const T* seg = _segments[s.segment].load(std::memory_order_acquire);
+            return seg && flags_(seg, s.segment)[s.offset].load(std::memory_order_acquire) != 0;
+        }
+
+        // 已发布时返回元素地址，否则返回 nullptr；wait-free
+        const T* get(size_t index) const
+        {
+            const slot s = locate_(index);
+            const T* seg = _segments[s.segment].load(std::memory_order_acquire);
+            if (!seg || flags_(seg, s.segment)[s.offset].load(std::memory_order_acquire) == 0) return nullptr;
+            return seg + s.offset;
+        }
+
+        T* get(size_t index)
+        {
+            return const_cast<T*>(static_cast<const concurrent_vector*>(this)->get(index));
+        }
+
+        // 要求元素已经发布（例如写线程已经 join，或下标是自己 push_back 得到的）
+        T& operator[](size_t index)
+        {
+            T* p = get(index);
+            assert(p);
+            return *p;
+        }
+
+        const T& operator[](size_t index) const
+        {
+            const T* p = get(index);
+            assert(p);
+            return *p;
+        }
+
+        // 依次访问 [0, size()) 中已经发布的元素，跳过还在构造的
+        template<typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            const size_t n = size();
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (const T* p = get(i)) fn(i, *p);
+            }
+        }
+
+        // 不是线程安全的：析构全部元素，保留已分配的段
+        void clear()
+        {
+            const size_t n = _size.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const slot s = locate_(i);
+                T* seg = _segments[s.segment].load(std::memory_order_relaxed);
+                if (!seg) continue;
+                std::atomic<uint8_t>& flag = flags_(seg, s.segment)[s.offset];
+                if (flag.load(std::memory_order_relaxed))
+                {
+                    seg[s.offset].~T();
+                    flag.store(0, std::memory_order_relaxed);
+                }
+            }
+            _size.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        struct slot
+        {
+            size_t segment;
+            size_t offset;
+        };
+
+        // 下标 i 对应 j = i + kFirst：j 的最高位决定段号，其余位是段内偏移
+        static slot locate_(size_t index)
+        {
+            const size_t j = index + kFirst;
+            const size_t high = std::bit_width(j) - 1;
+            return { high - kFirstShift, j - (size_t(1) << high) };
+        }
+
+        static constexpr size_t segment_size_(size_t s) { return kFirst << s; }
+
+        // 段内存布局：[元素 × n][就绪标志 × n]
+        static size_t flags_offset_(size_t s)
+        {
+            const size_t bytes = segment_size_(s) * sizeof(T);
+            return (bytes + alignof(std::atomic<uint8_t>) - 1) & ~(alignof(std::atomic<uint8_t>) - 1);
+        }
+
+        static std::atomic<uint8_t>* flags_(const T* seg, size_t s)
+        {
+            return reinterpret_cast<std::atomic<uint8_t>*>(
+                const_cast<char*>(reinterpret_cast<const char*>(seg)) + flags_offset_(s));
+        }
+
+        static constexpr std::align_val_t segment_align_()
+        {
+            return std::align_val_t(alignof(T) > kCacheLine ? alignof(T) : kCacheLine);
+        }
+
+        static T* allocate_segment_(size_t s)
+        {
+            const size_t n = segment_size_(s);
+            char* raw = static_cast<char*>(::operator new(flags_offset_(s) + n, segment_align_()));
+            std::atomic<uint8_t>* flags = reinterpret_cast<std::atomic<uint8_t>*>(raw + flags_offset_(s));
+            for (size_t i = 0; i < n; ++i) new (flags + i) std::atomic<uint8_t>(0);
+            return reinterpret_cast<T*>(raw);
+        }
+
+        static void deallocate_segment_(T* seg)
+        {
+            ::operator delete(static_cast<void*>(seg), segment_align_());
+        }
+
+        // 取第 s 段，没有就分配；多个线程同时分配时只有一个 CAS 成功
+        T* segment_(size_t s)
+        {
+            assert(s < kMaxSegments);
+            T* seg = _segments[s].load(std::memory_order_acquire);
+            if (seg) return seg;
+
+            T* fresh = allocate_segment_(s);
+            if (_segments[s].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                return fresh;
+            deallocate_segment_(fresh);
+            return seg;
+        }
+
+        template<typename... Args>
+        void construct_(size_t index, Args&&... args)
+        {
+            const slot s = locate_(index);
+            T* seg = segment_(s.segment);
+            // 写到段的一半时提前备好下一段
+            if (s.offset == segment_size_(s.segment) / 2 && s.segment + 1 < kMaxSegments) segment_(s.segment + 1);
+
+            new (seg + s.offset) T(std::forward<Args>(args)...);
+            flags_(seg, s.segment)[s.offset].store(1, std::memory_order_release);
+        }
+
+    private:
+        alignas(kCacheLine) std::atomic<size_t> _size{ 0 };
+        alignas(kCacheLine) std::atomic<T*> _segments[kMaxSegments] = {};
+    };
+}
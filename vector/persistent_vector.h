@@ -0,0 +1,584 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>      // std::construct_at / std::destroy_at
+#include <span>
+#include <utility>
+#include "vector.h"
+
+namespace tiny {
+
+    template<typename T>
+    class transient_vector;
+
+    namespace detail {
+        constexpr size_t pv_bits = 5;
+        constexpr size_t pv_width = size_t(1) << pv_bits;   // 每个节点 32 路
+        constexpr size_t pv_mask = pv_width - 1;
+
+        // 节点带原子引用计数：不同版本（可能在不同线程上）共享同一批节点
+        struct pv_node
+        {
+            std::atomic<uint32_t> refs{ 1 };
+        };
+
+        struct pv_branch : pv_node
+        {
+            pv_node* child[pv_width] = {};
+        };
+
+        // 叶子存放最多 32 个元素；树中的叶子总是满的，只有尾部叶子可能不满
+        template<typename T>
+        struct pv_leaf : pv_node
+        {
+            uint32_t count = 0;
+            alignas(T) unsigned char storage[sizeof(T) * pv_width];
+
+            T* data() { return reinterpret_cast<T*>(storage); }
+            const T* data() const { return reinterpret_cast<const T*>(storage); }
+        };
+    }
+
+    // 持久化（不可变）vector：32 路前缀树 + 尾部叶子，版本之间共享结构
+    //
+    //   拷贝（快照）         O(1)，只增加根和尾部的引用计数
+    //   operator[]          O(log32 n)，n 在 10 亿以内最多 6 层
+    //   push_back/set/pop_back  返回新版本，O(log32 n)：只复制从根到被改叶子的一条路径，
+    //                       其余节点与旧版本共享；追加时大多只碰尾部叶子
+    //
+    // 写时复制按引用计数判断：自上而下走路径时，引用计数为 1 的节点只属于当前版本，
+    // 直接原地修改，否则先复制。所以对右值调用（std::move(v).push_back(x)）
+    // 或者通过 transient_vector 批量修改时，连续的修改只在第一次碰到共享节点时复制
+    //
+    // 已经发布的版本不会再被修改，可以在多个线程间随意拷贝和读取；
+    // 同一个 persistent_vector 对象本身的赋值与读取仍需由调用方同步
+    template<typename T>
+    class persistent_vector
+    {
+        using branch = detail::pv_branch;
+        using leaf = detail::pv_leaf<T>;
+        static constexpr size_t kBits = detail::pv_bits;
+        static constexpr size_t kWidth = detail::pv_width;
+        static constexpr size_t kMask = detail::pv_mask;
+
+    public:
+        using value_type = T;
+
+        class const_iterator;
+
+        persistent_vector() = default;
+
+        persistent_vector(std::initializer_list<T> values) : persistent_vector(std::span<const T>(values.begin(), values.size())) {}
+
+        explicit persistent_vector(std::span<const T> values)
+        {
+            for (const T& v : values) push_back_(v);
+        }
+
+        explicit persistent_vector(const vector<T>& v)
+        {
+            for (size_t i = 0; i < v.size(); ++i) push_back_(v[i]);
+        }
+
+        persistent_vector(const persistent_vector& other)
+            : _size(other._size), _shift(other._shift), _root(other._root), _tail(other._tail)
+        {
+            retain_(_root);
+            retain_(_tail);
+        }
+
+        persistent_vector(persistent_vector&& other) noexcept
+            : _size(std::exchange(other._size, 0)), _shift(std::exchange(other._shift, kBits)),
+              _root(std::exchange(other._root, nullptr)), _tail(std::exchange(other._tail, nullptr))
+        {
+        }
+
+        persistent_vector& operator=(const persistent_vector& other)
+        {
+            persistent_vector tmp(other);
+            swap(tmp);
+            return *this;
+        }
+
+        persistent_vector& operator=(persistent_vector&& other) noexcept
+        {
+            persistent_vector tmp(std::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        ~persistent_vector()
+        {
+            release_(_root, _shift);
+            release_(_tail, 0);
+        }
+
+        void swap(persistent_vector& other) noexcept
+        {
+            std::swap(_size, other._size);
+            std::swap(_shift, other._shift);
+            std::swap(_root, other._root);
+            std::swap(_tail, other._tail);
+        }
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+
+        const T& operator[](size_t index) const
+        {
+            assert(index < _size);
+            return leaf_for_(index)->data()[index & kMask];
+        }
+
+        const T& front() const { return (*this)[0]; }
+        const T& back() const { return (*this)[_size - 1]; }
+
+        // ---------- 返回新版本，原对象不变 ----------
+
+        [[nodiscard]] persistent_vector push_back(T value) const&
+        {
+            persistent_vector next(*this);
+            next.push_back_(std::move(value));
+            return next;
+        }
+
+        [[nodiscard]] persistent_vector set(size_t index, T value) const&
+        {
+            persistent_vector next(*this);
+            next.set_(index, std::move(value));
+            return next;
+        }
+
+        [[nodiscard]] persistent_vector pop_back() const&
+        {
+            persistent_vector next(*this);
+            next.pop_back_();
+            return next;
+        }
+
+        // 右值版本：不独占的节点才复制，独占的原地修改
+        [[nodiscard]] persistent_vector push_back(T value) &&
+        {
+            push_back_(std::move(value));
+            return std::move(*this);
+        }
+
+        [[nodiscard]] persistent_vector set(size_t index, T value) &&
+        {
+            set_(index, std::move(value));
+            return std::move(*this);
+        }
+
+        [[nodiscard]] persistent_vector pop_back() &&
+        {
+            pop_back_();
+            return std::move(*this);
+        }
+
+        // 以当前版本为起点开始批量修改
+        transient_vector<T> transient() const { return transient_vector<T>(*this); }
+
+        // 按叶子顺序访问，每 32 个元素只走一次树
+        template<typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            for (size_t base = 0; base < _size; base += kWidth)
+            {
+                const leaf* l = leaf_for_(base);
+                for (uint32_t i = 0; i < l->count; ++i) fn(l->data()[i]);
+            }
+        }
+
+        vector<T> to_vector() const
+        {
+            vector<T> out;
+            out.reserve(_size);
+            for_each([&](const T& v) { out.push_back(v); });
+            return out;
+        }
+
+        // 两个版本是否共享同一棵树（用于测试结构共享）
+        bool shares_root_with(const persistent_vector& other) const { return _root && _root == other._root; }
+
+        // 前向迭代器，每进入一个新叶子才走一次树
+        class const_iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = const T&;
+            using pointer = const T*;
+            using iterator_category = std::forward_iterator_tag;
+
+            const_iterator() = default;
+
+            reference operator*() const { return _leaf[_index & kMask]; }
+            pointer operator->() const { return &_leaf[_index & kMask]; }
+
+            const_iterator& operator++()
+            {
+                ++_index;
+                if ((_index & kMask) == 0) _leaf = _index < _owner->_size ? _owner->leaf_for_(_index)->data() : nullptr;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const const_iterator& other) const { return _index == other._index; }
+            bool operator!=(const const_iterator& other) const { return _index != other._index; }
+
+        private:
+            friend class persistent_vector;
+
+            const_iterator(const persistent_vector* owner, size_t index)
+                : _owner(owner), _index(index),
+                  _leaf(index < owner->_size ? owner->leaf_for_(index)->data() : nullptr)
+            {
+            }
+
+            const persistent_vector* _owner = nullptr;
+            size_t _index = 0;
+            const T* _leaf = nullptr;
+        };
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, _size); }
+
+    private:
+        friend class transient_vector<T>;
+
+        // 尾部叶子之前的元素个数（都在树里）
+        size_t tail_offset_() const
+        {
+            return _size < kWidth ? 0 : ((_size - 1) >> kBits) << kBits;
+        }
+
+        const leaf* leaf_for_(size_t index) const
+        {
+            if (index >= tail_offset_()) return _tail;
+            const detail::pv_node* node = _root;
+            for (size_t level = _shift; level > 0; level -= kBits)
+            {
+                node = static_cast<const branch*>(node)->child[(index >> level) & kMask];
+            }
+            return static_cast<const leaf*>(node);
+        }
+
+        // ---------- 引用计数 ----------
+
+        static void retain_(detail::pv_node* node)
+        {
+            if (node) node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // shift == 0 表示叶子
+        static void release_(detail::pv_node* node, size_t shift)
+        {
+            if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+            if (shift == 0)
+            {
+                leaf* l = static_cast<leaf*>(node);
+                for (uint32_t i = 0; i < l->count; ++i) std::destroy_at(l->data() + i);
+                delete l;
+            }
+            else
+            {
+                branch* b = static_cast<branch*>(node);
+                for (detail::pv_node* c : b->child) release_(c, shift - kBits);
+                delete b;
+            }
+        }
+
+        // acquire 与其它版本释放时的 acq_rel 配对：看到 1 说明别人已经不再读这个节点
+        static bool unique_(const detail::pv_node* node)
+        {
+            return node->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        // 复制前 count 个元素到新叶子
+        static leaf* clone_leaf_(const leaf* src, uint32_t count)
+        {
+            leaf* l = new leaf;
+            try
+            {
+                for (; l->count < count; ++l->count) std::construct_at(l->data() + l->count, src->data()[l->count]);
+            }
+            catch (...)
+            {
+                release_(l, 0);
+                throw;
+            }
+            return l;
+        }
+
+        // 保证 node 只属于当前版本：共享时换成一份拷贝（只保留前 keep 个元素）
+        static void own_leaf_(leaf*& node, uint32_t keep)
+        {
+            if (unique_(node)) return;
+            leaf* copy = clone_leaf_(node, keep);
+            release_(node, 0);
+            node = copy;
+        }
+
+        static void own_branch_(branch*& node, size_t shift)
+        {
+            if (unique_(node)) return;
+            branch* copy = new branch;
+            for (size_t i = 0; i < kWidth; ++i)
+            {
+                copy->child[i] = node->child[i];
+                retain_(copy->child[i]);
+            }
+            release_(node, shift);
+            node = copy;
+        }
+
+        // ---------- 原地修改（共享的节点先复制） ----------
+
+        template<typename... Args>
+        void push_back_(Args&&... args)
+        {
+            const size_t in_tail = _size - tail_offset_();
+            if (_tail && in_tail < kWidth)
+            {
+                own_leaf_(_tail, _tail->count);
+                std::construct_at(_tail->data() + in_tail, std::forward<Args>(args)...);
+                ++_tail->count;
+                ++_size;
+                return;
+            }
+
+            // 尾部满了（或还没有尾部）：新元素放进新的尾部，满的旧尾部挂进树
+            leaf* fresh = new leaf;
+            try
+            {
+                std::construct_at(fresh->data(), std::forward<Args>(args)...);
+                fresh->count = 1;
+                if (_tail) push_tail_(_tail);
+            }
+            catch (...)
+            {
+                release_(fresh, 0);
+                throw;
+            }
+            _tail = fresh;
+            ++_size;
+        }
+
+        // 把满的尾部叶子（转移当前版本持有的引用）挂到树的最右边
+        void push_tail_(leaf* full)
+        {
+            const size_t index = _size - kWidth;   // full 中第一个元素的下标
+            if (!_root)
+            {
+                _root = new branch;
+                _shift = kBits;
+            }
+            else if ((index >> kBits) >= (size_t(1) << _shift))
+            {
+                // 根已满，长高一层
+                branch* top = new branch;
+                top->child[0] = _root;
+                try
+                {
+                    top->child[1] = new_path_(_shift, full);
+                }
+                catch (...)
+                {
+                    top->child[0] = nullptr;
+                    delete top;
+                    throw;
+                }
+                _root = top;
+                _shift += kBits;
+                return;
+            }
+            push_tail_into_(_root, _shift, index, full);
+        }
+
+        static void push_tail_into_(branch*& node, size_t shift, size_t index, leaf* full)
+        {
+            own_branch_(node, shift);
+            const size_t sub = (index >> shift) & kMask;
+            if (shift == kBits)
+            {
+                node->child[sub] = full;
+            }
+            else if (node->child[sub])
+            {
+                branch* child = static_cast<branch*>(node->child[sub]);
+                push_tail_into_(child, shift - kBits, index, full);
+                node->child[sub] = child;
+            }
+            else
+            {
+                node->child[sub] = new_path_(shift - kBits, full);
+            }
+        }
+
+        // 从 shift 层一路向下只有最左一条链、末端是 full 的新路径
+        static detail::pv_node* new_path_(size_t shift, leaf* full)
+        {
+            if (shift == 0) return full;
+            branch* b = new branch;
+            try
+            {
+                b->child[0] = new_path_(shift - kBits, full);
+            }
+            catch (...)
+            {
+                delete b;
+                throw;
+            }
+            return b;
+        }
+
+        template<typename U>
+        void set_(size_t index, U&& value)
+        {
+            assert(index < _size);
+            if (index >= tail_offset_())
+            {
+                own_leaf_(_tail, _tail->count);
+                _tail->data()[index & kMask] = std::forward<U>(value);
+                return;
+            }
+
+            own_branch_(_root, _shift);
+            branch* node = _root;
+            for (size_t level = _shift; level > kBits; level -= kBits)
+            {
+                const size_t sub = (index >> level) & kMask;
+                branch* child = static_cast<branch*>(node->child[sub]);
+                own_branch_(child, level - kBits);
+                node->child[sub] = child;
+                node = child;
+            }
+            const size_t sub = (index >> kBits) & kMask;
+            leaf* l = static_cast<leaf*>(node->child[sub]);
+            own_leaf_(l, l->count);
+            node->child[sub] = l;
+            l->data()[index & kMask] = std::forward<U>(value);
+        }
+
+        void pop_back_()
+        {
+            assert(_size > 0);
+            if (_size == 1)
+            {
+                release_(_tail, 0);
+                _tail = nullptr;
+                _size = 0;
+                return;
+            }
+
+            if (_size - tail_offset_() > 1)
+            {
+                own_leaf_(_tail, _tail->count - 1);
+                if (_tail->count == _size - tail_offset_()) std::destroy_at(_tail->data() + --_tail->count);
+                --_size;
+                return;
+            }
+
+            // 尾部只剩一个元素：树里最后一片叶子变成新的尾部
+            leaf* last = const_cast<leaf*>(leaf_for_(_size - 2));
+            retain_(last);
+            release_(_tail, 0);
+            _tail = last;
+
+            if (pop_tail_(_root, _shift, _size - 2))
+            {
+                release_(_root, _shift);
+                _root = nullptr;
+                _shift = kBits;
+            }
+            else if (_shift > kBits && !_root->child[1])
+            {
+                // 根只剩一个孩子，降低一层
+                branch* only = static_cast<branch*>(_root->child[0]);
+                retain_(only);
+                release_(_root, _shift);
+                _root = only;
+                _shift -= kBits;
+            }
+            --_size;
+        }
+
+        // 从树中摘掉包含 index 的最右叶子；返回 node 是否因此变空
+        static bool pop_tail_(branch*& node, size_t shift, size_t index)
+        {
+            const size_t sub = (index >> shift) & kMask;
+            own_branch_(node, shift);
+            if (shift > kBits)
+            {
+                branch* child = static_cast<branch*>(node->child[sub]);
+                const bool emptied = pop_tail_(child, shift - kBits, index);
+                node->child[sub] = child;
+                if (!emptied) return false;
+                release_(child, shift - kBits);
+            }
+            else
+            {
+                release_(node->child[sub], 0);
+            }
+            node->child[sub] = nullptr;
+            return sub == 0;
+        }
+
+    private:
+        size_t _size = 0;
+        size_t _shift = kBits;          // 根节点所在层的位移，叶子层为 0
+        branch* _root = nullptr;        // 不含尾部的元素组成的树，元素不足 33 个时为空
+        leaf* _tail = nullptr;
+    };
+
+    // persistent_vector 的可变视图，用于批量构建或批量修改
+    //
+    //   auto t = base.transient();
+    //   for (...) t.push_back(x);        第一次碰到与 base 共享的节点时复制，之后原地修改
+    //   persistent_vector<T> next = t.persistent();
+    //
+    // 不改变 base；persistent() 之后 transient 变为空
+    template<typename T>
+    class transient_vector
+    {
+    public:
+        transient_vector() = default;
+
+        explicit transient_vector(persistent_vector<T> base) : _v(std::move(base)) {}
+
+        transient_vector(const transient_vector&) = delete;
+        transient_vector& operator=(const transient_vector&) = delete;
+        transient_vector(transient_vector&&) noexcept = default;
+        transient_vector& operator=(transient_vector&&) noexcept = default;
+
+        void push_back(const T& value) { _v.push_back_(value); }
+        void push_back(T&& value) { _v.push_back_(std::move(value)); }
+
+        template<typename... Args>
+        void emplace_back(Args&&... args) { _v.push_back_(std::forward<Args>(args)...); }
+
+        void set(size_t index, const T& value) { _v.set_(index, value); }
+        void set(size_t index, T&& value) { _v.set_(index, std::move(value)); }
+
+        void pop_back() { _v.pop_back_(); }
+
+        const T& operator[](size_t index) const { return _v[index]; }
+        size_t size() const { return _v.size(); }
+        bool empty() const { return _v.empty(); }
+
+        // 冻结为不可变版本，O(1)
+        persistent_vector<T> persistent() { return std::move(_v); }
+
+    private:
+        persistent_vector<T> _v;
+    };
+}
@@ -0,0 +1,226 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>      // std::construct_at / std::destroy_at
+#include <type_traits>
+#include <utility>
+
+namespace tiny {
+
+    // 固定容量、元素内联存储的 vector，完全不访问堆
+    // 容量在编译期确定，超过容量属于使用错误（assert），也可以用 try_push_back 试探
+    //
+    // 元素放在匿名 union 里，只有真正 push 进来的元素才会被构造；
+    // T 是平凡类型时所有特殊成员都是平凡的，整个容器可以在 constexpr 中使用
+    template<typename T, size_t N>
+    class static_vector
+    {
+        static_assert(N > 0, "static_vector capacity must be positive");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using Iterator = T*;
+        using ConstIterator = const T*;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        constexpr static_vector() noexcept {}
+
+        constexpr static_vector(std::initializer_list<T> il)
+        {
+            assert(il.size() <= N);
+            for (const T& value : il) push_back(value);
+        }
+
+        constexpr static_vector(size_t n, const T& value)
+        {
+            assert(n <= N);
+            for (size_t i = 0; i < n; ++i) push_back(value);
+        }
+
+        // 平凡类型直接按位拷贝
+        constexpr static_vector(const static_vector&) requires std::is_trivially_copy_constructible_v<T> = default;
+        constexpr static_vector(const static_vector& other)
+        {
+            for (size_t i = 0; i < other._size; ++i) push_back(other._elems[i]);
+        }
+
+        constexpr static_vector(static_vector&&) requires std::is_trivially_move_constructible_v<T> = default;
+        constexpr static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            for (size_t i = 0; i < other._size; ++i) push_back(std::move(other._elems[i]));
+            other.clear();
+        }
+
+        constexpr static_vector& operator=(const static_vector&) requires std::is_trivially_copy_assignable_v<T> = default;
+        constexpr static_vector& operator=(const static_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (size_t i = 0; i < other._size; ++i) push_back(other._elems[i]);
+            }
+            return *this;
+        }
+
+        constexpr static_vector& operator=(static_vector&&) requires std::is_trivially_move_assignable_v<T> = default;
+        constexpr static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                clear();
+                for (size_t i = 0; i < other._size; ++i) push_back(std::move(other._elems[i]));
+                other.clear();
+            }
+            return *this;
+        }
+
+        constexpr ~static_vector() requires std::is_trivially_destructible_v<T> = default;
+        constexpr ~static_vector()
+        {
+            clear();
+        }
+
+        constexpr Iterator begin() { return _elems; }
+        constexpr Iterator end() { return _elems + _size; }
+        constexpr ConstIterator begin() const { return _elems; }
+        constexpr ConstIterator end() const { return _elems + _size; }
+        constexpr ConstIterator cbegin() const { return _elems; }
+        constexpr ConstIterator cend() const { return _elems + _size; }
+
+        constexpr T* data() { return _elems; }
+        constexpr const T* data() const { return _elems; }
+
+        constexpr size_t size() const { return _size; }
+        static constexpr size_t capacity() { return N; }
+        constexpr bool empty() const { return _size == 0; }
+        constexpr bool full() const { return _size == N; }
+
+        constexpr T& operator[](size_t index)
+        {
+            assert(index < _size);
+            return _elems[index];
+        }
+
+        constexpr const T& operator[](size_t index) const
+        {
+            assert(index < _size);
+            return _elems[index];
+        }
+
+        constexpr T& front()
+        {
+            assert(!empty());
+            return _elems[0];
+        }
+
+        constexpr const T& front() const
+        {
+            assert(!empty());
+            return _elems[0];
+        }
+
+        constexpr T& back()
+        {
+            assert(!empty());
+            return _elems[_size - 1];
+        }
+
+        constexpr const T& back() const
+        {
+            assert(!empty());
+            return _elems[_size - 1];
+        }
+
+        template<typename... Args>
+        constexpr T& emplace_back(Args&&... args)
+        {
+            assert(!full());
+            T* slot = std::construct_at(_elems + _size, std::forward<Args>(args)...);
+            ++_size;
+            return *slot;
+        }
+
+        constexpr void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+
+        constexpr void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        // 容量已满时返回 false，不做任何修改
+        constexpr bool try_push_back(const T& value)
+        {
+            if (full()) return false;
+            emplace_back(value);
+            return true;
+        }
+
+        constexpr void pop_back()
+        {
+            assert(!empty());
+            --_size;
+            std::destroy_at(_elems + _size);
+        }
+
+        constexpr void clear()
+        {
+            while (_size) pop_back();
+        }
+
+        constexpr void resize(size_t n, const T& value = T())
+        {
+            assert(n <= N);
+            while (_size > n) pop_back();
+            while (_size < n) push_back(value);
+        }
+
+        constexpr Iterator insert(Iterator pos, const T& value)
+        {
+            assert(pos >= begin() && pos <= end());
+            assert(!full());
+
+            const size_t offset = pos - _elems;
+            if (offset == _size)
+            {
+                push_back(value);
+                return _elems + offset;
+            }
+
+            T tmp(value); // value 可能就是容器里的元素
+            emplace_back(std::move(_elems[_size - 1]));
+            for (size_t i = _size - 2; i > offset; --i)
+            {
+                _elems[i] = std::move(_elems[i - 1]);
+            }
+            _elems[offset] = std::move(tmp);
+            return _elems + offset;
+        }
+
+        constexpr Iterator erase(Iterator pos)
+        {
+            assert(pos >= begin() && pos < end());
+
+            for (Iterator it = pos; it + 1 != end(); ++it)
+            {
+                *it = std::move(*(it + 1));
+            }
+            pop_back();
+            return pos;
+        }
+
+    private:
+        union
+        {
+            T _elems[N];
+        };
+        size_t _size = 0;
+    };
+}
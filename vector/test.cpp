@@ -1,7 +1,16 @@
 #include <iostream>
 #include<string>
 #include <cassert>
+#include <iterator>
 #include "vector.h"  // 包含你的 vector 类头文件
+#include "static_vector.h"
+#include "concurrent_vector.h"
+#include "persistent_vector.h"
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <random>
+#include "../stack/stack.h"
 
 void test_vector_operations() {
     // 测试1：默认构造和 push_back
@@ -147,8 +156,298 @@ void test_string()
     std::cout << "所有 tiny::vector<std::string> 测试通过！" << std::endl;
 }
 
+// 元素只构造/析构一次：扩容时移动而不是拷贝，参数引用容器内元素时也安全
+void test_element_lifetime() {
+    tiny::vector<std::string> vec;
+    std::string long_str(64, 'x');   // 超出 SSO，重复析构会被 ASan 发现
+    for (int i = 0; i < 100; ++i) vec.push_back(long_str + std::to_string(i));
+    vec.push_back(vec[0]);          // 正好触发扩容，参数来自容器本身
+    assert(vec.size() == 101 && vec.back() == vec[0]);
+
+    vec.insert(vec.begin(), vec[50]);
+    assert(vec[0] == vec[51]);
+    vec.erase(vec.begin() + 10, vec.begin() + 60);
+    assert(vec.size() == 52 && vec[10] == long_str + "59");
+    vec.resize(5);
+    assert(vec.size() == 5);
+
+    tiny::vector<std::string> moved(std::move(vec));
+    assert(moved.size() == 5 && vec.empty());
+
+    std::cout << "元素生命周期测试通过！" << std::endl;
+}
+
+// vector<bool> 每个元素只占 1 bit
+void test_vector_bool() {
+    tiny::vector<bool> flags;
+    for (int i = 0; i < 1000; ++i) flags.push_back(i % 2 == 0);
+    assert(flags.size() == 1000 && flags.count() == 500);
+    assert(flags.capacity() / 8 <= 256);   // 按位存放，不是按字节
+
+    flags[1] = true;
+    assert(flags[1] && flags.front() && !flags.back());
+    flags.insert(flags.begin(), false);
+    assert(!flags[0] && flags[1] && flags[2] && flags.size() == 1001);
+    flags.erase(flags.begin());
+    assert(flags[0] && flags[1] && !flags[3]);
+
+    size_t n = 0;
+    for (bool f : flags) n += f;
+    assert(n == 501);
+    flags.flip();
+    assert(flags.count() == 499 && flags.bits().find_first() == 3);
+
+    const tiny::vector<bool> copy(flags);
+    assert(copy.size() == 1000 && copy.bits() == flags.bits());
+
+    // 跨越多个字的中间插入/删除
+    tiny::vector<bool> wide(300, false);
+    wide[63] = wide[64] = wide[299] = true;
+    wide.insert(wide.begin() + 10, true);
+    assert(wide.size() == 301 && wide[10] && wide[64] && wide[65] && wide[300] && !wide[63]);
+    wide.erase(wide.begin());
+    assert(wide.size() == 300 && wide[9] && wide[63] && wide[64] && wide[299] && wide.count() == 4);
+
+    tiny::monotonic_buffer_resource arena;
+    tiny::vector<bool> on_arena(&arena);
+    for (int i = 0; i < 500; ++i) on_arena.push_back(i % 3 == 0);
+    assert(on_arena.resource() == &arena && on_arena.count() == 167);
+
+    // emplace_back 返回代理引用；迭代器满足随机访问迭代器的全部要求
+    on_arena.emplace_back(false) = true;
+    assert(on_arena.back() && on_arena.size() == 501);
+    static_assert(std::random_access_iterator<tiny::vector<bool>::iterator>);
+    static_assert(std::random_access_iterator<tiny::vector<bool>::const_iterator>);
+    auto it = wide.begin() + 5;
+    assert(2 + it == wide.begin() + 7 && it > wide.begin() && it >= it && it <= wide.end());
+    std::cout << "vector<bool> 测试通过！" << std::endl;
+}
+
+// 编译期使用 static_vector
+constexpr int constexpr_sum() {
+    tiny::static_vector<int, 8> v;
+    for (int i = 1; i <= 4; ++i) v.push_back(i);
+    v.insert(v.begin(), 10);
+    v.erase(v.begin() + 1);
+    int sum = 0;
+    for (int x : v) sum += x;
+    return sum;
+}
+static_assert(constexpr_sum() == 19);
+
+void test_static_vector() {
+    // 测试1：基本操作，容量固定
+    tiny::static_vector<std::string, 4> v;
+    static_assert(tiny::static_vector<std::string, 4>::capacity() == 4);
+    v.push_back("a");
+    v.emplace_back(2, 'b');
+    v.insert(v.begin(), "front");
+    assert(v.size() == 3);
+    assert(v[0] == "front" && v[1] == "a" && v.back() == "bb");
+    v.push_back("c");
+    assert(v.full());
+    assert(!v.try_push_back("d"));
+
+    // 测试2：删除与拷贝、移动
+    v.erase(v.begin() + 1);
+    assert(v.size() == 3 && v[1] == "bb");
+    tiny::static_vector<std::string, 4> copy = v;
+    tiny::static_vector<std::string, 4> moved = std::move(v);
+    assert(copy.size() == 3 && moved.size() == 3 && v.empty());
+    assert(copy[2] == "c" && moved[0] == "front");
+
+    // 测试3：平凡类型的 static_vector 本身也是平凡可拷贝的
+    static_assert(std::is_trivially_copyable_v<tiny::static_vector<int, 16>>);
+
+    // 测试4：作为 stack 的底层容器，全程不分配堆内存
+    stack<int, tiny::static_vector<int, 64>> st;
+    for (int i = 0; i < 64; ++i) st.push(i);
+    assert(st.size() == 64 && st.top() == 63);
+    st.pop();
+    st.emplace(100);
+    assert(st.top() == 100);
+
+    std::cout << "static_vector 测试通过！" << std::endl;
+}
+
+void test_concurrent_vector() {
+    // 测试1：单线程下的下标、分段与地址稳定
+    tiny::concurrent_vector<std::string> names;
+    assert(names.empty() && names.get(0) == nullptr);
+    assert(names.push_back("first") == 0);
+    const std::string* first = &names[0];
+    for (int i = 1; i < 100000; ++i) assert(names.emplace_back(std::to_string(i)) == size_t(i));
+    assert(names.size() == 100000 && &names[0] == first && *first == "first");
+    assert(names[99999] == "99999" && names.published(31) && names.published(32));
+
+    // 测试2：多个线程同时追加，每个值恰好出现一次；同时有读者在读已发布的元素
+    const int threads = 8, per_thread = 50000;
+    tiny::concurrent_vector<uint64_t> v;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> seen{0};
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            size_t n = v.size();
+            if (n == 0) continue;
+            const uint64_t* p = v.get(n - 1);
+            if (p) {
+                assert(*p % 1000000 < uint64_t(per_thread));   // 要么没发布，要么是完整写好的值
+                seen.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < threads; ++t) {
+        writers.emplace_back([&, t] {
+            uint64_t batch[10];
+            for (int i = 0; i < per_thread; i += 10) {
+                if (i % 20 == 0) {
+                    for (int k = 0; k < 10; ++k) v.push_back(uint64_t(t) * 1000000 + i + k);
+                } else {
+                    for (int k = 0; k < 10; ++k) batch[k] = uint64_t(t) * 1000000 + i + k;
+                    v.append(batch);
+                }
+            }
+        });
+    }
+    for (auto& w : writers) w.join();
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    assert(v.size() == size_t(threads) * per_thread);
+    std::vector<int> count(threads * per_thread, 0);
+    v.for_each([&](size_t, uint64_t x) { ++count[(x / 1000000) * per_thread + x % 1000000]; });
+    for (int c : count) assert(c == 1);
+
+    // 测试3：reserve 之后追加不会再分配，析构只处理已构造的元素
+    tiny::concurrent_vector<std::string> r;
+    r.reserve(1000);
+    for (int i = 0; i < 1000; ++i) r.push_back(std::string(40, 'x'));
+    r.clear();
+    assert(r.empty());
+
+    std::cout << "concurrent_vector 测试通过！" << std::endl;
+}
+
+struct counted {
+    static int alive;
+    int value;
+    counted(int v) : value(v) { ++alive; }
+    counted(const counted& o) : value(o.value) { ++alive; }
+    counted& operator=(const counted&) = default;
+    ~counted() { --alive; }
+};
+int counted::alive = 0;
+
+void test_persistent_vector() {
+    // 测试1：随机 push_back/set/pop_back 与 std::vector 对照，旧版本始终保持不变
+    {
+        std::mt19937 rng(7);
+        tiny::persistent_vector<int> v;
+        std::vector<int> ref;
+        std::vector<std::pair<tiny::persistent_vector<int>, std::vector<int>>> snapshots;
+        for (int step = 0; step < 60000; ++step) {
+            int op = int(rng() % 10);
+            if (op < 6 || ref.empty()) { v = v.push_back(step); ref.push_back(step); }
+            else if (op < 8) { size_t i = rng() % ref.size(); v = v.set(i, -step); ref[i] = -step; }
+            else { v = v.pop_back(); ref.pop_back(); }
+            if (step % 2000 == 0) snapshots.emplace_back(v, ref);
+        }
+        assert(v.size() == ref.size());
+        for (size_t i = 0; i < ref.size(); ++i) assert(v[i] == ref[i]);
+        for (auto& [snap, expect] : snapshots) {
+            assert(snap.size() == expect.size());
+            size_t i = 0;
+            for (int x : snap) assert(x == expect[i++]);
+        }
+    }
+
+    // 测试2：跨越多层的增长与收缩，修改只复制一条路径
+    {
+        tiny::persistent_vector<int> big;
+        const int n = 32 * 32 * 32 + 100;   // 根需要三层
+        for (int i = 0; i < n; ++i) big = std::move(big).push_back(i);
+        tiny::persistent_vector<int> snap = big;                 // O(1) 快照
+        assert(snap.shares_root_with(big));
+        tiny::persistent_vector<int> changed = big.set(5, -5);
+        assert(!changed.shares_root_with(big) && changed[5] == -5 && big[5] == 5);
+        assert(changed[6] == 6 && &changed[20000] == &big[20000]);   // 其余叶子共享
+        while (big.size() > 10) big = std::move(big).pop_back();
+        assert(big.size() == 10 && big.back() == 9);
+        assert(snap.size() == size_t(n) && snap.back() == n - 1 && snap[32 * 32 * 32] == 32 * 32 * 32);
+        tiny::vector<int> flat = snap.to_vector();
+        assert(flat.size() == size_t(n) && flat[12345] == 12345);
+    }
+
+    // 测试3：transient 批量修改，不影响起点版本
+    {
+        tiny::persistent_vector<std::string> base{ "a", "b", "c" };
+        auto t = base.transient();
+        for (int i = 0; i < 5000; ++i) t.push_back(std::to_string(i));
+        t.set(0, "z");
+        t.pop_back();
+        tiny::persistent_vector<std::string> next = t.persistent();
+        assert(t.empty());
+        assert(base.size() == 3 && base[0] == "a");
+        assert(next.size() == 5002 && next[0] == "z" && next[1] == "b" && next.back() == "4998");
+    }
+
+    // 测试4：元素在最后一个共享它的版本销毁时才析构
+    {
+        {
+            tiny::persistent_vector<counted> a;
+            for (int i = 0; i < 1000; ++i) a = std::move(a).push_back(counted(i));
+            tiny::persistent_vector<counted> b = a.set(500, counted(-1));
+            tiny::persistent_vector<counted> c = b.pop_back().pop_back();
+            assert(counted::alive == 1000 + 32 + 6);    // b 复制了一片叶子；c 只复制尾部的前 7 个，第二次 pop 原地进行
+            a = tiny::persistent_vector<counted>();
+            assert(c[500].value == -1 && b[999].value == 999);
+        }
+        assert(counted::alive == 0);
+    }
+
+    // 测试5：写者不断发布新版本，读者拿快照读到的总是一致的版本
+    {
+        std::atomic<const tiny::persistent_vector<int>*> slot{nullptr};
+        std::vector<tiny::persistent_vector<int>*> versions;
+        tiny::persistent_vector<int> cur;
+        for (int i = 0; i < 100; ++i) cur = std::move(cur).push_back(0);
+        versions.push_back(new tiny::persistent_vector<int>(cur));
+        slot.store(versions.back(), std::memory_order_release);
+
+        std::atomic<bool> done{false};
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                while (!done.load(std::memory_order_acquire)) {
+                    tiny::persistent_vector<int> snap = *slot.load(std::memory_order_acquire);
+                    int first = snap[0];
+                    for (int x : snap) assert(x == first);   // 每个版本所有元素相同
+                }
+            });
+        }
+        for (int gen = 1; gen <= 200; ++gen) {
+            auto t = cur.transient();
+            for (size_t i = 0; i < t.size(); ++i) t.set(i, gen);
+            cur = t.persistent();
+            versions.push_back(new tiny::persistent_vector<int>(cur));
+            slot.store(versions.back(), std::memory_order_release);
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& th : readers) th.join();
+        for (auto* p : versions) delete p;
+    }
+
+    std::cout << "persistent_vector 测试通过！" << std::endl;
+}
+
 int main() {
     //test_vector_operations();  // 调用测试函数
     test_string();
+    test_element_lifetime();
+    test_vector_bool();
+    test_static_vector();
+    test_concurrent_vector();
+    test_persistent_vector();
     return 0;
 }
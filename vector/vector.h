@@ -1,6 +1,15 @@
 #pragma once
-#include <cstddef>   
-#include <algorithm>   
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "../memory/memory_resource.h"
+#include "../instrument/instrument.h"
 
 namespace tiny {
     template<typename T>
@@ -9,15 +18,36 @@ namespace tiny {
     public:
         using Iterator = T*;
         using ConstIterator = const T*;
+        using value_type = T;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
 
         Iterator begin() { return _start; }
         Iterator end() { return _finish; }
+        ConstIterator begin() const { return _start; }
+        ConstIterator end() const { return _finish; }
         ConstIterator cbegin() const { return _start; }
         ConstIterator cend() const { return _finish; }
 
+        T* data() { return _start; }
+        const T* data() const { return _start; }
+
         vector() = default;
 
+        // 所有内存都从 r 分配；不传时使用 get_default_resource()
+        explicit vector(memory_resource* r)
+            : _resource(r)
+        {
+            assert(r);
+        }
+
+        // 拷贝得到的新容器使用默认资源，需要放进 arena 时用下面带资源的版本
         vector(const vector<T>& v)
+            : vector(v, get_default_resource())
+        {}
+
+        vector(const vector<T>& v, memory_resource* r)
+            : _resource(r)
         {
             size_t n = v.size();
             if (n > 0)
@@ -28,17 +58,24 @@ namespace tiny {
                     new (_start + i) T(v._start[i]);  // 使用 placement new 构造元素
                 }
                 _finish = _start + n;
-                _endorstorage = _start + n;
+                instrument::on_copy<vector<T>>(n);
             }
         }
 
+        // 移动时连同资源一起带走
+        vector(vector<T>&& v) noexcept
+            : _resource(v._resource)
+        {
+            swap(v);
+        }
+
         ~vector()
         {
             // 手动调用每个元素的析构函数
             for (Iterator ptr = _start; ptr != _finish; ++ptr) {
                 ptr->~T();  // 显式调用析构函数
             }
-            delete[] _start;  // 释放内存
+            deallocate_(_start, capacity());  // 释放内存
             _start = _finish = _endorstorage = nullptr;
         }
 
@@ -53,28 +90,29 @@ namespace tiny {
             return _endorstorage - _start;
         }
 
+        static constexpr size_t max_size()
+        {
+            return SIZE_MAX / sizeof(T);
+        }
+
 
         //不要在用傻逼memcpy了
+        // 只分配原始内存，元素逐个移动过去再析构旧的，不会多构造/多析构
         void reserve(size_t n)
         {
             if (n > capacity())
             {
-                T* tmp = new T[n];  // 分配新的内存
-
-                if (_start != nullptr) {
-                    // 使用 std::copy 来正确拷贝元素
-                    std::copy(_start, _finish, tmp);  // 拷贝现有元素
-                }
-
+                T* tmp = allocate_(n);  // 分配新的内存
                 size_t oldsize = size();
-                
-                for(size_t i = 0; i < oldsize; ++i)
+
+                for (size_t i = 0; i < oldsize; ++i)
                 {
+                    new (tmp + i) T(std::move(_start[i]));
                     _start[i].~T();  // 显式调用析构函数
                 }
+                if (_start) instrument::on_reallocate<vector<T>>(oldsize, 0);
 
-
-                delete[] _start;  // 释放原内存
+                deallocate_(_start, capacity());  // 释放原内存
 
                 _start = tmp;  // 更新 _start 指针
                 _finish = _start + oldsize;  // 更新 _finish 指针
@@ -90,56 +128,70 @@ namespace tiny {
                 reserve(n);
                 while(_finish < _start + n)
                 {
-                    *_finish = value;
+                    new (_finish) T(value);
                     ++_finish;
                 }
             }
             else //删除
             {
-                _finish = _start + n;
+                while (_finish > _start + n)
+                {
+                    --_finish;
+                    _finish->~T();
+                }
             }
         }
 
         void push_back(const T& value)
         {
-            if(_finish == nullptr)
-            {
-                size_t newcapacity = 4;
-                _start = new T[newcapacity];
-                _finish = _start;
-                _endorstorage = _start + newcapacity;
-            }
+            emplace_back(value);
+        }
 
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
             if(_finish == _endorstorage)
             {
-                size_t newcapacity = capacity() == 0 ? 4 : capacity() * 2;
-                reserve(newcapacity);
+                // 参数可能引用着本容器里的元素，先在新内存里构造好新元素再搬旧元素
+                return realloc_emplace_back_(std::forward<Args>(args)...);
             }
-            *_finish = value;
+            new (_finish) T(std::forward<Args>(args)...);
             ++_finish;
+            return *(_finish - 1);
         }
 
-        void insert(Iterator pos, const T& value)
+        Iterator insert(Iterator pos, const T& value)
         {
-            assert(pos >= _start && pos <= _finish);  // 确保 pos 在有效范围内
-
-            size_t offset = pos - _start;
+            return emplace(pos, value);
+        }
 
-            if (_finish == _endorstorage)
-            {
-                reserve(capacity() == 0 ? 4 : capacity() * 2);
-            }
+        Iterator insert(Iterator pos, T&& value)
+        {
+            return emplace(pos, std::move(value));
+        }
 
-            Iterator it = _finish;
+        template<typename... Args>
+        Iterator emplace(Iterator pos, Args&&... args)
+        {
+            assert(pos >= _start && pos <= _finish);  // 确保 pos 在有效范围内
 
-            while (it != _start + offset)
+            size_t offset = pos - _start;
+            if (pos == _finish)
             {
-                *it = *(it - 1);
-                --it;
+                emplace_back(std::forward<Args>(args)...);
+                return _start + offset;
             }
 
-            *(_start + offset) = value;
-            ++_finish;
+            T tmp(std::forward<Args>(args)...);  // 参数可能就是容器里的元素
+            emplace_back(std::move(*(_finish - 1)));
+            std::move_backward(_start + offset, _finish - 2, _finish - 1);
+            _start[offset] = std::move(tmp);
+            return _start + offset;
         }
 
         bool empty() const
@@ -151,26 +203,60 @@ namespace tiny {
         {
             assert(!empty());
             --_finish;
+            _finish->~T();
         }
 
         Iterator erase(Iterator pos)
         {
             assert(pos >= _start && pos < _finish);
+            return erase(pos, pos + 1);
+        }
+
+        // 删除 [first, last)，后面的元素整体前移一次
+        Iterator erase(Iterator first, Iterator last)
+        {
+            assert(first >= _start && first <= last && last <= _finish);
 
-            Iterator it = pos;
-            while (it != _finish - 1)
+            Iterator new_finish = std::move(last, _finish, first);
+            while (_finish != new_finish)
             {
-                *it = *(it + 1);
-                ++it;
+                --_finish;
+                _finish->~T();
             }
+            return first;
+        }
 
-            --_finish;
-            return pos;
+        // 赋值不改变自己的资源：arena 里的容器被赋值后元素仍在 arena 里
+        vector<T>& operator=(const vector<T>& v)
+        {
+            if (this != &v)
+            {
+                clear();
+                reserve(v.size());
+                for (const T& item : v) emplace_back(item);
+                instrument::on_copy<vector<T>>(v.size());
+            }
+            return *this;
         }
 
-        vector<T>& operator=(vector<T> v)
+        // 资源相同时直接接管内存；不同时只能逐个移动元素
+        vector<T>& operator=(vector<T>&& v)
         {
-            swap(v);
+            if (this == &v) return *this;
+            if (*_resource == *v._resource)
+            {
+                vector<T> tmp(std::move(v));
+                std::swap(_start, tmp._start);
+                std::swap(_finish, tmp._finish);
+                std::swap(_endorstorage, tmp._endorstorage);
+            }
+            else
+            {
+                clear();
+                reserve(v.size());
+                for (T& item : v) emplace_back(std::move(item));
+                v.clear();
+            }
             return *this;
         }
 
@@ -187,13 +273,20 @@ namespace tiny {
             std::swap(_start, v._start);
             std::swap(_finish, v._finish);
             std::swap(_endorstorage, v._endorstorage);
+            std::swap(_resource, v._resource);
         }
 
-        template<typename InputIterator>
-        vector(InputIterator first, InputIterator last)
+        memory_resource* resource() const { return _resource; }
+
+        template<typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+        vector(InputIterator first, InputIterator last, memory_resource* r = get_default_resource())
+            : _resource(r)
         {
-            size_t n = std::distance(first, last);  // 计算输入范围的元素数量
-            reserve(n);
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                typename std::iterator_traits<InputIterator>::iterator_category>)
+            {
+                reserve(std::distance(first, last));  // 计算输入范围的元素数量
+            }
 
             while (first != last)
             {
@@ -202,15 +295,15 @@ namespace tiny {
             }
         }
 
-        vector(size_t n, const T& value = T())
+        vector(size_t n, const T& value = T(), memory_resource* r = get_default_resource())
+            : _resource(r)
         {
             reserve(n);
             for (size_t i = 0; i < n; ++i)
             {
-                new (_start + i) T(value);  
+                new (_start + i) T(value);
             }
             _finish = _start + n;
-            _endorstorage = _start + n;
         }
 
         T& operator[](size_t index)
@@ -219,9 +312,81 @@ namespace tiny {
             return _start[index];
         }
 
+        const T& operator[](size_t index) const
+        {
+            assert(index < size());
+            return _start[index];
+        }
+
+        T& front()
+        {
+            assert(!empty());
+            return *_start;
+        }
+
+        const T& front() const
+        {
+            assert(!empty());
+            return *_start;
+        }
+
+        T& back()
+        {
+            assert(!empty());
+            return *(_finish - 1);
+        }
+
+        const T& back() const
+        {
+            assert(!empty());
+            return *(_finish - 1);
+        }
+
+    private:
+        // n * sizeof(T) 溢出时会分配一块过小的内存，之后的写入越界
+        T* allocate_(size_t n)
+        {
+            if (n > max_size()) throw std::length_error("tiny::vector");
+            instrument::on_allocate<vector<T>>(n * sizeof(T), n);
+            return static_cast<T*>(_resource->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate_(T* p, size_t n)
+        {
+            if (!p) return;
+            instrument::on_deallocate<vector<T>>(n * sizeof(T));
+            _resource->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        template<typename... Args>
+        T& realloc_emplace_back_(Args&&... args)
+        {
+            const size_t oldsize = size();
+            const size_t newcapacity = oldsize == 0 ? 4 : oldsize * 2;
+            T* tmp = allocate_(newcapacity);
+
+            new (tmp + oldsize) T(std::forward<Args>(args)...);
+            for (size_t i = 0; i < oldsize; ++i)
+            {
+                new (tmp + i) T(std::move(_start[i]));
+                _start[i].~T();
+            }
+            if (_start) instrument::on_reallocate<vector<T>>(oldsize, 0);
+            deallocate_(_start, capacity());
+
+            _start = tmp;
+            _finish = tmp + oldsize + 1;
+            _endorstorage = tmp + newcapacity;
+            return tmp[oldsize];
+        }
+
     private:
         Iterator _start = nullptr;
         Iterator _finish = nullptr;
         Iterator _endorstorage = nullptr;
+        memory_resource* _resource = get_default_resource();
     };
 }
+
+// vector<bool> 按位存放的特化
+#include "vector_bool.h"
@@ -0,0 +1,162 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include "vector.h"
+#include "../bitset/dynamic_bitset.h"
+
+namespace tiny {
+
+    // vector<bool> 的特化：每个元素只占 1 bit，存放在 dynamic_bitset 里
+    // 与通用版本一样可以 push_back/insert/erase/遍历，但 operator[] 与迭代器返回的是代理对象
+    // 需要整字操作（count、find_first、与其他位图做 & |）时通过 bits() 直接访问底层位集合
+    template<>
+    class vector<bool>
+    {
+    public:
+        using value_type = bool;
+        using reference = dynamic_bitset::reference;
+        using const_reference = bool;
+
+        template<bool Const>
+        class bit_iterator
+        {
+            using bitset_ptr = std::conditional_t<Const, const dynamic_bitset*, dynamic_bitset*>;
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = bool;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, bool, dynamic_bitset::reference>;
+            using pointer = void;
+
+            bit_iterator() = default;
+
+            bit_iterator(bitset_ptr bits, size_t index) : _bits(bits), _index(index) {}
+
+            template<bool C = Const> requires C
+            bit_iterator(const bit_iterator<false>& it) : _bits(it._bits), _index(it._index) {}
+
+            reference operator*() const { return (*_bits)[_index]; }
+            reference operator[](difference_type n) const { return (*_bits)[_index + n]; }
+
+            bit_iterator& operator++() { ++_index; return *this; }
+            bit_iterator& operator--() { --_index; return *this; }
+            bit_iterator operator++(int) { bit_iterator tmp(*this); ++_index; return tmp; }
+            bit_iterator operator--(int) { bit_iterator tmp(*this); --_index; return tmp; }
+
+            bit_iterator& operator+=(difference_type n) { _index += n; return *this; }
+            bit_iterator& operator-=(difference_type n) { _index -= n; return *this; }
+            bit_iterator operator+(difference_type n) const { return bit_iterator(_bits, _index + n); }
+            bit_iterator operator-(difference_type n) const { return bit_iterator(_bits, _index - n); }
+            friend bit_iterator operator+(difference_type n, const bit_iterator& it) { return it + n; }
+            difference_type operator-(const bit_iterator& it) const
+            {
+                return static_cast<difference_type>(_index) - static_cast<difference_type>(it._index);
+            }
+
+            bool operator==(const bit_iterator& it) const { return _index == it._index; }
+            bool operator!=(const bit_iterator& it) const { return _index != it._index; }
+            bool operator<(const bit_iterator& it) const { return _index < it._index; }
+            bool operator>(const bit_iterator& it) const { return it < *this; }
+            bool operator<=(const bit_iterator& it) const { return !(it < *this); }
+            bool operator>=(const bit_iterator& it) const { return !(*this < it); }
+
+            size_t index() const { return _index; }
+
+        private:
+            template<bool> friend class bit_iterator;
+
+            bitset_ptr _bits = nullptr;
+            size_t _index = 0;
+        };
+
+        using Iterator = bit_iterator<false>;
+        using ConstIterator = bit_iterator<true>;
+        using iterator = Iterator;
+        using const_iterator = ConstIterator;
+
+        Iterator begin() { return Iterator(&_bits, 0); }
+        Iterator end() { return Iterator(&_bits, _bits.size()); }
+        ConstIterator begin() const { return ConstIterator(&_bits, 0); }
+        ConstIterator end() const { return ConstIterator(&_bits, _bits.size()); }
+        ConstIterator cbegin() const { return begin(); }
+        ConstIterator cend() const { return end(); }
+
+        vector() = default;
+
+        explicit vector(memory_resource* r)
+            : _bits(r)
+        {}
+
+        vector(size_t n, bool value = false, memory_resource* r = get_default_resource())
+            : _bits(n, value, r)
+        {}
+
+        template<typename InputIterator> requires (!std::is_integral_v<InputIterator>)
+        vector(InputIterator first, InputIterator last, memory_resource* r = get_default_resource())
+            : _bits(r)
+        {
+            for (; first != last; ++first) push_back(bool(*first));
+        }
+
+        memory_resource* resource() const { return _bits.resource(); }
+
+        size_t size() const { return _bits.size(); }
+        size_t capacity() const { return _bits.capacity(); }
+        bool empty() const { return _bits.empty(); }
+
+        void reserve(size_t n) { _bits.reserve(n); }
+        void resize(size_t n, bool value = false) { _bits.resize(n, value); }
+        void clear() { _bits.clear(); }
+
+        void push_back(bool value) { _bits.push_back(value); }
+
+        reference emplace_back(bool value)
+        {
+            _bits.push_back(value);
+            return back();
+        }
+
+        void pop_back()
+        {
+            assert(!empty());
+            _bits.pop_back();
+        }
+
+        reference operator[](size_t index) { return _bits[index]; }
+        bool operator[](size_t index) const { return _bits[index]; }
+
+        reference front() { assert(!empty()); return _bits[0]; }
+        bool front() const { assert(!empty()); return _bits[0]; }
+        reference back() { assert(!empty()); return _bits[size() - 1]; }
+        bool back() const { assert(!empty()); return _bits[size() - 1]; }
+
+        // 插入/删除把后面的位整字移动一位（带跨字进位），O(n / 64)
+        Iterator insert(ConstIterator pos, bool value)
+        {
+            const size_t index = pos.index();
+            _bits.insert(index, value);
+            return Iterator(&_bits, index);
+        }
+
+        Iterator erase(ConstIterator pos)
+        {
+            const size_t index = pos.index();
+            _bits.erase(index);
+            return Iterator(&_bits, index);
+        }
+
+        void flip() { _bits.flip(); }
+        size_t count() const { return _bits.count(); }
+
+        void swap(vector<bool>& v) { _bits.swap(v._bits); }
+
+        const dynamic_bitset& bits() const { return _bits; }
+        dynamic_bitset& bits() { return _bits; }
+
+    private:
+        dynamic_bitset _bits;
+    };
+}